@@ -0,0 +1,127 @@
+// A chattering input on timed binary_sensor filters: 8 sensors with delayed_on_off 20 ms, each flipping at 1 kHz in
+// 40 ms bursts followed by 60 ms of quiet, run in real time for RUN_MS. Each burst settles on the opposite value to
+// the one before.
+//  - "shared timer": DelayedOnOffFilter on FilterTimer, one scheduler timeout for all of them
+//  - "per filter": the filter as it was before, a Component that calls set_timeout() on every edge
+// Reports CPU time and heap allocations per input edge, spent in publish_state() and the scheduler (best of RUNS
+// alternating runs), and checks that both deliver the same debounced states.
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/binary_sensor/filter.h"
+#include "esphome/core/application.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::binary_sensor;
+
+static constexpr int SENSORS = 8;
+static constexpr uint32_t DELAY_MS = 20;
+static constexpr uint32_t RUN_MS = 2000;
+static constexpr int RUNS = 3;
+
+static constexpr uint32_t FILTER_TIMEOUT_ID = 0;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+
+/// DelayedOnOffFilter before the shared timer: each edge replaces the component's scheduler timeout
+class PerFilterDelayedOnOff : public Filter, public Component {
+ public:
+  optional<bool> new_value(bool value) override {
+    if (value) {
+      this->set_timeout(FILTER_TIMEOUT_ID, DELAY_MS, [this]() { this->output(true); });
+    } else {
+      this->set_timeout(FILTER_TIMEOUT_ID, DELAY_MS, [this]() { this->output(false); });
+    }
+    return {};
+  }
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+};
+
+struct Result {
+  double ns_per_edge;
+  double allocations_per_edge;
+  std::vector<uint32_t> changes;
+};
+
+static Result run(bool shared) {
+  BinarySensor sensors[SENSORS];
+  Result result{};
+  result.changes.resize(SENSORS);
+  for (int i = 0; i < SENSORS; i++) {
+    sensors[i].set_name("chatter");
+    if (shared) {
+      auto *filter = new DelayedOnOffFilter();
+      filter->set_on_delay(DELAY_MS);
+      filter->set_off_delay(DELAY_MS);
+      sensors[i].add_filter(filter);
+    } else {
+      sensors[i].add_filter(new PerFilterDelayedOnOff());
+    }
+    sensors[i].add_on_state_callback([&result, i](bool) { result.changes[i]++; });
+  }
+
+  size_t edges = 0;
+  size_t before = allocations;
+  std::chrono::steady_clock::duration busy{};
+  const uint32_t start = millis();
+  uint32_t last_tick = start - 1;
+  for (uint32_t now = millis(); now - start < RUN_MS; now = millis()) {
+    // One main loop pass per millisecond
+    if (now == last_tick)
+      continue;
+    last_tick = now;
+    auto t0 = std::chrono::steady_clock::now();
+    const uint32_t phase = (now - start) % 100, burst = (now - start) / 100;
+    if (phase < 40) {
+      // One edge per sensor, staggered so the sensors don't all agree. The last few ms of a burst hold the value it
+      // settles on, alternating from burst to burst, so a late tick can't change what the filters deliver
+      for (int i = 0; i < SENSORS; i++)
+        sensors[i].publish_state((((phase < 36 ? phase : burst) + i) & 1) != 0);
+      edges += SENSORS;
+    }
+    App.scheduler.call(now);
+    busy += std::chrono::steady_clock::now() - t0;
+  }
+  // Let the last debounce expire
+  for (uint32_t end = millis(); millis() - end < 2 * DELAY_MS;)
+    App.scheduler.call(millis());
+
+  result.ns_per_edge = std::chrono::duration<double, std::nano>(busy).count() / edges;
+  result.allocations_per_edge = double(allocations - before) / edges;
+  return result;
+}
+
+int main() {
+  printf("%d sensors, delayed_on_off %u ms, 1 kHz chatter in 40 ms bursts every 100 ms, %d x %u ms\n", SENSORS,
+         DELAY_MS, RUNS, RUN_MS);
+  Result per_filter{1e12}, shared{1e12};
+  for (int i = 0; i < RUNS; i++) {
+    Result r = run(false);
+    if (r.ns_per_edge < per_filter.ns_per_edge)
+      per_filter = r;
+    r = run(true);
+    if (r.ns_per_edge < shared.ns_per_edge)
+      shared = r;
+  }
+  printf("per filter    %7.1f ns  %5.2f allocations per edge\n", per_filter.ns_per_edge,
+         per_filter.allocations_per_edge);
+  printf("shared timer  %7.1f ns  %5.2f allocations per edge\n", shared.ns_per_edge, shared.allocations_per_edge);
+  if (shared.changes != per_filter.changes) {
+    printf("debounced states differ\n");
+    return 1;
+  }
+  return 0;
+}
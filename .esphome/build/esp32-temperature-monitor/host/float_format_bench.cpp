@@ -0,0 +1,42 @@
+// Fixed-precision float formatting, in ns per call: format_float_fixed_to() against snprintf("%.*f"), which
+// value_accuracy_to_buf() used before, over sensor-like values
+#include "esphome/core/helpers.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace esphome;
+
+static const int ROUNDS = 2000000;
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  // Temperatures, humidities, RSSI and the like
+  std::vector<float> values;
+  for (int i = 0; i < 1024; i++)
+    values.push_back(-40.0f + i * 0.173f);
+
+  char buf[VALUE_ACCURACY_MAX_LEN];
+  for (uint8_t decimals : {1, 2}) {
+    size_t checksum_printf = 0, checksum_fixed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+      checksum_printf += snprintf(buf, sizeof(buf), "%.*f", decimals, values[i & 1023]) + buf[0];
+    double printf_s = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+      checksum_fixed += format_float_fixed_to(buf, sizeof(buf), values[i & 1023], decimals) + buf[0];
+    double fixed_s = seconds_since(start);
+    printf("%u decimals: snprintf %6.1f ns  format_float_fixed_to %6.1f ns\n", decimals, printf_s * 1e9 / ROUNDS,
+           fixed_s * 1e9 / ROUNDS);
+    if (checksum_printf != checksum_fixed) {
+      printf("output mismatch\n");
+      return 1;
+    }
+  }
+  return 0;
+}
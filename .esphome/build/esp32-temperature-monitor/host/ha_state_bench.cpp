@@ -0,0 +1,116 @@
+// Home Assistant state pushes against 500 subscriptions, one in five with an attribute, in ns and heap allocations
+// per message:
+//  - "hash index": APIServer::dispatch_home_assistant_state()
+//  - "linear scan": the loop APIConnection::on_home_assistant_state_response() ran before, over get_state_subs()
+// Five in six pushes hit a subscription; the rest are for entities nothing subscribed to and carry a long attribute
+// value, which needs the heap fallback for the state copy once anything matches. Exits 1 if the two deliver
+// different callbacks.
+#include "esphome/components/api/api_connection.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/core/application.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using api::APIServer;
+
+static constexpr int SUBSCRIPTIONS = 500;
+static constexpr int PUSHES = 200000;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Push {
+  std::string entity_id;
+  std::string attribute;
+  std::string state;
+};
+
+/// The matching APIConnection::on_home_assistant_state_response() did before the index, state copy per match
+static void linear_dispatch(const APIServer &server, StringRef entity_id, StringRef attribute, StringRef state) {
+  for (auto &it : server.get_state_subs()) {
+    size_t entity_id_len = strlen(it.entity_id);
+    if (entity_id_len != entity_id.size() || memcmp(it.entity_id, entity_id.c_str(), entity_id.size()) != 0)
+      continue;
+    size_t sub_attr_len = it.attribute != nullptr ? strlen(it.attribute) : 0;
+    if (sub_attr_len != attribute.size() ||
+        (sub_attr_len > 0 && memcmp(it.attribute, attribute.c_str(), sub_attr_len) != 0))
+      continue;
+    SmallBufferWithHeapFallback<MAX_STATE_LEN + 1> state_buf_alloc(state.size() + 1);
+    char *state_buf = reinterpret_cast<char *>(state_buf_alloc.get());
+    if (!state.empty())
+      memcpy(state_buf, state.c_str(), state.size());
+    state_buf[state.size()] = '\0';
+    it.callback(StringRef(state_buf, state.size()));
+  }
+}
+
+int main() {
+  APIServer server;
+  // Subscriptions keep pointers to their strings, as the generated code's literals do
+  static char entity_ids[SUBSCRIPTIONS][32];
+  std::vector<uint32_t> hits(SUBSCRIPTIONS);
+  for (int i = 0; i < SUBSCRIPTIONS; i++) {
+    snprintf(entity_ids[i], sizeof(entity_ids[i]), "sensor.bench_%03d", i);
+    server.subscribe_home_assistant_state(entity_ids[i], i % 5 == 0 ? "friendly_name" : nullptr,
+                                          [&hits, i](StringRef state) { hits[i] += state.size(); });
+  }
+
+  std::vector<Push> pushes;
+  for (int i = 0; i < 600; i++) {
+    if (i < SUBSCRIPTIONS) {
+      pushes.push_back({entity_ids[i], i % 5 == 0 ? "friendly_name" : "", std::to_string(i * 0.25)});
+    } else {
+      // A long attribute value for an entity nothing subscribed to
+      pushes.push_back({"sensor.unsubscribed_" + std::to_string(i), "options", std::string(400, 'x')});
+    }
+  }
+
+  auto run = [&](bool indexed) {
+    std::fill(hits.begin(), hits.end(), 0);
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PUSHES; i++) {
+      const Push &push = pushes[i % pushes.size()];
+      StringRef entity_id(push.entity_id), attribute(push.attribute), state(push.state);
+      if (indexed) {
+        server.dispatch_home_assistant_state(entity_id, attribute, state);
+      } else {
+        linear_dispatch(server, entity_id, attribute, state);
+      }
+    }
+    double seconds = seconds_since(start);
+    printf("%-11s  %7.1f ns  %5.3f allocations per message\n", indexed ? "hash index" : "linear scan",
+           seconds * 1e9 / PUSHES, double(allocations - before) / PUSHES);
+    return hits;
+  };
+
+  printf("%d subscriptions, %d pushes\n", SUBSCRIPTIONS, PUSHES);
+  // The first dispatch builds the index; keep it out of the measurement
+  server.dispatch_home_assistant_state(StringRef(""), StringRef(""), StringRef(""));
+  std::vector<uint32_t> linear = run(false);
+  std::vector<uint32_t> indexed = run(true);
+  if (indexed != linear) {
+    printf("callbacks differ\n");
+    return 1;
+  }
+  return 0;
+}
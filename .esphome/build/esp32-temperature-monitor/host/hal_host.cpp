@@ -0,0 +1,72 @@
+// Platform layer for the host builds: monotonic wall-clock time, a no-op watchdog, std::mutex locks and log output
+// to stderr. The log level defaults to WARN and can be changed with HOST_LOG_LEVEL=0..7.
+#include "esphome/core/gpio.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <unistd.h>
+
+namespace esphome {
+
+static uint64_t monotonic_us() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t micros() { return static_cast<uint32_t>(monotonic_us()); }
+uint32_t millis() { return static_cast<uint32_t>(monotonic_us() / 1000); }
+void delay(uint32_t ms) { usleep(ms * 1000); }
+void delayMicroseconds(uint32_t us) { usleep(us); }
+void yield() {}
+void arch_init() {}
+void arch_feed_wdt() {}
+void arch_restart() { exit(0); }
+uint32_t arch_get_cpu_cycle_count() { return static_cast<uint32_t>(monotonic_us() * 1000); }
+uint32_t arch_get_cpu_freq_hz() { return 1000000000u; }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+uint32_t random_uint32() { return static_cast<uint32_t>(rand()); }
+void get_mac_address_raw(uint8_t *mac) {
+  static const uint8_t HOST_MAC[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};  // locally administered
+  memcpy(mac, HOST_MAC, sizeof(HOST_MAC));
+}
+
+Mutex::Mutex() : handle_(new std::mutex()) {}
+Mutex::~Mutex() { delete static_cast<std::mutex *>(this->handle_); }
+void Mutex::lock() { static_cast<std::mutex *>(this->handle_)->lock(); }
+bool Mutex::try_lock() { return static_cast<std::mutex *>(this->handle_)->try_lock(); }
+void Mutex::unlock() { static_cast<std::mutex *>(this->handle_)->unlock(); }
+
+bool ISRInternalGPIOPin::digital_read() { return false; }
+
+ESPPreferences *global_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint8_t initial_log_level() {
+  const char *level = getenv("HOST_LOG_LEVEL");
+  return level != nullptr ? static_cast<uint8_t>(atoi(level)) : ESPHOME_LOG_LEVEL_WARN;
+}
+uint8_t esp_log_active_level = initial_log_level();  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  if (level > esp_log_active_level)
+    return;
+  fprintf(stderr, "[%u][%s:%d] ", millis(), tag, line);
+  vfprintf(stderr, format, args);
+  fputc('\n', stderr);
+}
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list args;
+  va_start(args, format);
+  esp_log_vprintf_(level, tag, line, format, args);
+  va_end(args);
+}
+
+}  // namespace esphome
@@ -0,0 +1,26 @@
+#pragma once
+// Minimal assertions for the host unit tests. A failed check is reported and counted, the test keeps running, and
+// HOST_TEST_MAIN's exit status is the number of failures.
+#include <cstdio>
+
+namespace host_test {
+inline int failures = 0;
+inline const char *current = "";
+}  // namespace host_test
+
+#define EXPECT_TRUE(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("FAIL %s:%d %s: %s\n", __FILE__, __LINE__, ::host_test::current, #cond); \
+      ::host_test::failures++; \
+    } \
+  } while (0)
+#define EXPECT_EQ(a, b) EXPECT_TRUE((a) == (b))
+
+#define RUN_TEST(fn) \
+  do { \
+    ::host_test::current = #fn; \
+    int before = ::host_test::failures; \
+    fn(); \
+    printf("%s %s\n", ::host_test::failures == before ? "PASS" : "FAIL", #fn); \
+  } while (0)
@@ -0,0 +1,19 @@
+#pragma once
+// Host build of the platform-independent core: the components exercised by the tests, benchmarks and soak run.
+#include "esphome/core/macros.h"
+#define ESPHOME_BOARD "host"
+#define ESPHOME_COMPONENT_COUNT 16
+#define ESPHOME_ENTITY_BINARY_SENSOR_COUNT 1
+#ifndef ESPHOME_ENTITY_SENSOR_COUNT  // the API pacing test registers more
+#define ESPHOME_ENTITY_SENSOR_COUNT 2
+#endif
+#define ESPHOME_ENTITY_TEXT_SENSOR_COUNT 4
+#define ESPHOME_LOOP_TASK_STACK_SIZE 8192
+#define ESPHOME_THREAD_MULTI_ATOMICS
+#define ESPHOME_VARIANT "HOST"
+#define USE_BINARY_SENSOR
+#define USE_HOST
+#define USE_I2C
+#define USE_MD5
+#define USE_SENSOR
+#define USE_SHA256
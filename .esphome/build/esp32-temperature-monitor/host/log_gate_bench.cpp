@@ -0,0 +1,40 @@
+// Suppressed log calls, with DEBUG compiled in and the run-time level at WARN: 10M ESP_LOGD calls gated inline on
+// esp_log_active_level, against the same calls made straight into esp_log_printf_(), which is what every macro did
+// before and which returns as soon as it has compared the level
+#include "esphome/core/log.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace esphome;
+
+static const char *const TAG = "bench";
+static const int CALLS = 10000000;
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  esp_log_active_level = ESPHOME_LOG_LEVEL_WARN;
+  float value = 21.5f;
+
+  // The barrier stands for the code around a real call site, so the level load isn't hoisted out of the loop
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < CALLS; i++) {
+    ESP_LOGD(TAG, "'%s': value %.2f, call %d", "sensor", value, i);
+    asm volatile("" ::: "memory");
+  }
+  double gated = seconds_since(start);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < CALLS; i++) {
+    esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, TAG, __LINE__, "'%s': value %.2f, call %d", "sensor", value, i);
+    asm volatile("" ::: "memory");
+  }
+  double called = seconds_since(start);
+
+  printf("%d suppressed ESP_LOGD calls\n", CALLS);
+  printf("inline gate        %6.1f ms  %5.2f ns per call\n", gated * 1e3, gated * 1e9 / CALLS);
+  printf("call into logger   %6.1f ms  %5.2f ns per call\n", called * 1e3, called * 1e9 / CALLS);
+  return 0;
+}
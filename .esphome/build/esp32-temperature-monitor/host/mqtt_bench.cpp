@@ -0,0 +1,454 @@
+// AsyncMqttClient (lib/AsyncMqtt) over its POSIX socket transport, against a stand-in broker thread on loopback:
+//  - QoS1 throughput with the broker acknowledging each PUBLISH 2 ms after it arrives, for the in-flight window of
+//    MQTT_MAX_INFLIGHT (4) against a window of 1: the benchmark then keeps one message outstanding itself, which is
+//    the stop-and-wait traffic a MQTT_MAX_INFLIGHT=1 build sends
+//  - QoS0 over a slow link (the broker reads 16 KB/s through a small receive buffer) at twice that offered load,
+//    against a copy of the blocking publish PubSubClient gave main.cpp: the longest loop stall and what got through.
+//    Both clients get the ESP32's 5744 byte TCP send buffer here; Linux would otherwise grow it past the whole run.
+// Exits 1 if the broker sees a message lost, duplicated or out of order, or a QoS1 run doesn't finish.
+#include "AsyncMqtt.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t QOS1_MESSAGES = 1000;
+static constexpr auto ACK_DELAY = std::chrono::microseconds(2000);
+static constexpr uint32_t LINK_BYTES_PER_MS = 16;
+static constexpr uint32_t PUBLISH_INTERVAL_MS = 6;  // About 200 byte packets: twice the link rate
+static constexpr uint32_t SLOW_RUN_MS = 3000;
+static constexpr int LWIP_TCP_SND_BUF = 5744;  // CONFIG_LWIP_TCP_SND_BUF_DEFAULT in the Arduino-ESP32 build
+static const char TOPIC[] = "esp32-1306/sensor/temperature/state";
+
+static double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static uint32_t ms_since(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+/// A payload that starts with its sequence number, padded to `size` bytes
+static std::string payload_for(uint32_t seq, size_t size) {
+  std::string payload = std::to_string(seq) + " ";
+  payload.resize(std::max(size, payload.size()), 'x');
+  return payload;
+}
+
+/// Accepts one client, answers CONNECT and PINGREQ, acknowledges QoS1 PUBLISHes after `ack_delay`, and checks that
+/// the PUBLISH sequence numbers arrive as 0, 1, 2, ... Reads at most `bytes_per_ms` when that is non-zero.
+class StandInBroker {
+ public:
+  StandInBroker(std::chrono::microseconds ack_delay, uint32_t bytes_per_ms)
+      : ack_delay_(ack_delay), bytes_per_ms_(bytes_per_ms) {
+    this->listen_fd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int one = 1;
+    setsockopt(this->listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bytes_per_ms != 0) {
+      // Inherited by the accepted socket: a small receive window, so the backlog sits in the client's send buffer
+      int rcvbuf = 4096;
+      setsockopt(this->listen_fd_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (bind(this->listen_fd_, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(this->listen_fd_, 1) != 0 ||
+        getsockname(this->listen_fd_, (struct sockaddr *) &addr, &len) != 0) {
+      perror("broker");
+      exit(1);
+    }
+    this->port_ = ntohs(addr.sin_port);
+    this->thread_ = std::thread([this]() { this->run_(); });
+  }
+  ~StandInBroker() {
+    this->stop_ = true;
+    this->thread_.join();
+    close(this->listen_fd_);
+  }
+
+  uint16_t port() const { return this->port_; }
+  uint32_t delivered() const { return this->delivered_; }
+  bool in_order() const { return this->in_order_; }
+
+ protected:
+  void run_() {
+    int fd = -1;
+    while (fd < 0 && !this->stop_) {
+      struct pollfd pfd = {this->listen_fd_, POLLIN, 0};
+      if (poll(&pfd, 1, 10) > 0)
+        fd = accept(this->listen_fd_, nullptr, nullptr);
+    }
+    if (fd < 0)
+      return;
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    std::vector<uint8_t> in;
+    uint8_t buf[4096];
+    double allowance = 0;
+    auto last = Clock::now();
+    while (!this->stop_) {
+      auto now = Clock::now();
+      while (!this->acks_.empty() && this->acks_.front().first <= now) {
+        uint16_t id = this->acks_.front().second;
+        uint8_t puback[4] = {0x40, 0x02, uint8_t(id >> 8), uint8_t(id)};
+        send(fd, puback, sizeof(puback), MSG_NOSIGNAL);
+        this->acks_.pop_front();
+      }
+
+      size_t budget = sizeof(buf);
+      if (this->bytes_per_ms_ != 0) {
+        double elapsed_ms = std::chrono::duration<double, std::milli>(now - last).count();
+        allowance = std::min(allowance + elapsed_ms * this->bytes_per_ms_, double(sizeof(buf)));
+        budget = static_cast<size_t>(allowance);
+      }
+      last = now;
+
+      // Sleep until the next acknowledgement is due, data arrives (if it may be read), or 1 ms passes
+      auto wait = std::chrono::microseconds(1000);
+      if (!this->acks_.empty())
+        wait = std::min(wait, std::chrono::duration_cast<std::chrono::microseconds>(this->acks_.front().first - now));
+      struct timespec timeout = {0, std::max<long>(wait.count(), 0) * 1000};
+      struct pollfd pfd = {fd, short(budget > 0 ? POLLIN : 0), 0};
+      if (ppoll(&pfd, 1, &timeout, nullptr) <= 0 || !(pfd.revents & (POLLIN | POLLHUP)))
+        continue;
+      ssize_t got = recv(fd, buf, budget, MSG_DONTWAIT);
+      if (got == 0)
+        break;
+      if (got < 0)
+        continue;
+      allowance -= got;
+      in.insert(in.end(), buf, buf + got);
+      this->parse_(fd, in);
+    }
+    close(fd);
+  }
+
+  void parse_(int fd, std::vector<uint8_t> &in) {
+    size_t pos = 0;
+    while (in.size() - pos >= 2) {
+      size_t remaining = 0, header = 1;
+      bool complete = false;
+      while (pos + header < in.size() && header <= 4) {
+        uint8_t b = in[pos + header];
+        remaining |= size_t(b & 0x7F) << (7 * (header - 1));
+        header++;
+        if ((b & 0x80) == 0) {
+          complete = true;
+          break;
+        }
+      }
+      if (!complete || in.size() - pos < header + remaining)
+        break;
+      this->handle_(fd, in[pos], &in[pos + header], remaining);
+      pos += header + remaining;
+    }
+    in.erase(in.begin(), in.begin() + pos);
+  }
+
+  void handle_(int fd, uint8_t type, const uint8_t *body, size_t len) {
+    switch (type & 0xF0) {
+      case 0x10: {  // CONNECT
+        static const uint8_t CONNACK[] = {0x20, 0x02, 0x00, 0x00};
+        send(fd, CONNACK, sizeof(CONNACK), MSG_NOSIGNAL);
+        break;
+      }
+      case 0x30: {  // PUBLISH
+        uint8_t qos = (type >> 1) & 0x03;
+        size_t pos = 2 + (body[0] << 8 | body[1]);
+        uint16_t id = 0;
+        if (qos > 0) {
+          id = body[pos] << 8 | body[pos + 1];
+          pos += 2;
+        }
+        // The availability topic's "online" carries no sequence number
+        if (len - pos > 0 && body[pos] >= '0' && body[pos] <= '9') {
+          std::string payload(reinterpret_cast<const char *>(body + pos), len - pos);
+          uint32_t seq = strtoul(payload.c_str(), nullptr, 10);
+          if (seq != this->delivered_)
+            this->in_order_ = false;
+          this->delivered_++;
+        }
+        if (qos > 0)
+          this->acks_.emplace_back(Clock::now() + this->ack_delay_, id);
+        break;
+      }
+      case 0xC0: {  // PINGREQ
+        static const uint8_t PINGRESP[] = {0xD0, 0x00};
+        send(fd, PINGRESP, sizeof(PINGRESP), MSG_NOSIGNAL);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  std::chrono::microseconds ack_delay_;
+  uint32_t bytes_per_ms_;
+  int listen_fd_;
+  uint16_t port_{0};
+  std::thread thread_;
+  std::atomic<bool> stop_{false};
+  std::atomic<uint32_t> delivered_{0};
+  std::atomic<bool> in_order_{true};
+  std::deque<std::pair<Clock::time_point, uint16_t>> acks_;
+};
+
+/// Limits a socket's send buffer to what lwIP gives the device (Linux doubles the requested size)
+static void set_device_send_buffer(int fd) {
+  int sndbuf = LWIP_TCP_SND_BUF / 2;
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+}
+
+/// MqttSocketTransport with the device's send buffer: the same non-blocking socket calls, loopback IPv4 only
+class DeviceSocketTransport : public MqttTransport {
+ public:
+  ~DeviceSocketTransport() override { this->close(); }
+  bool begin(const char *host, uint16_t port) override {
+    this->close();
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1)
+      return false;
+    this->fd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    fcntl(this->fd_, F_SETFL, fcntl(this->fd_, F_GETFL, 0) | O_NONBLOCK);
+    int one = 1;
+    setsockopt(this->fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    set_device_send_buffer(this->fd_);
+    return ::connect(this->fd_, (struct sockaddr *) &addr, sizeof(addr)) == 0 || errno == EINPROGRESS;
+  }
+  int status() override {
+    if (this->fd_ < 0)
+      return -1;
+    struct pollfd pfd = {this->fd_, POLLOUT, 0};
+    if (poll(&pfd, 1, 0) <= 0)
+      return 0;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    return getsockopt(this->fd_, SOL_SOCKET, SO_ERROR, &err, &len) == 0 && err == 0 ? 1 : -1;
+  }
+  int write(const uint8_t *data, size_t len) override {
+    ssize_t sent = send(this->fd_, data, len, MSG_NOSIGNAL);
+    if (sent >= 0)
+      return int(sent);
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  int read(uint8_t *data, size_t len) override {
+    ssize_t got = recv(this->fd_, data, len, 0);
+    if (got > 0)
+      return int(got);
+    if (got == 0)
+      return -1;
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  void close() override {
+    if (this->fd_ >= 0)
+      ::close(this->fd_);
+    this->fd_ = -1;
+  }
+
+ protected:
+  int fd_{-1};
+};
+
+/// The publish path main.cpp had with PubSubClient: a blocking socket, and publish() returns once the whole packet
+/// has been handed to TCP
+class BlockingPublisher {
+ public:
+  ~BlockingPublisher() {
+    if (this->fd_ >= 0)
+      close(this->fd_);
+  }
+
+  bool connect(uint16_t port) {
+    this->fd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int one = 1;
+    setsockopt(this->fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    set_device_send_buffer(this->fd_);
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(this->fd_, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+      return false;
+    // CONNECT: protocol level 4, clean session, 15 s keepalive, client id "bench"
+    static const uint8_t CONNECT[] = {0x10, 17, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02,
+                                      0, 15, 0, 5, 'b', 'e', 'n', 'c', 'h'};
+    uint8_t connack[4];
+    return this->write_all_(CONNECT, sizeof(CONNECT)) && recv(this->fd_, connack, sizeof(connack), MSG_WAITALL) == 4;
+  }
+
+  bool publish(const char *topic, const char *payload) {
+    size_t topic_len = strlen(topic), payload_len = strlen(payload);
+    size_t remaining = 2 + topic_len + payload_len;
+    std::vector<uint8_t> packet = {0x30};
+    for (size_t len = remaining; len > 0 || packet.size() == 1; len >>= 7)
+      packet.push_back(uint8_t(len & 0x7F) | (len >= 0x80 ? 0x80 : 0));
+    packet.push_back(uint8_t(topic_len >> 8));
+    packet.push_back(uint8_t(topic_len));
+    packet.insert(packet.end(), topic, topic + topic_len);
+    packet.insert(packet.end(), payload, payload + payload_len);
+    return this->write_all_(packet.data(), packet.size());
+  }
+
+ protected:
+  bool write_all_(const uint8_t *data, size_t len) {
+    while (len > 0) {
+      ssize_t sent = send(this->fd_, data, len, MSG_NOSIGNAL);
+      if (sent <= 0)
+        return false;
+      data += sent;
+      len -= sent;
+    }
+    return true;
+  }
+
+  int fd_{-1};
+};
+
+static bool connect_async(AsyncMqttClient &client, Clock::time_point start) {
+  while (!client.connected() && ms_since(start) < 2000) {
+    client.loop(ms_since(start));
+    usleep(100);
+  }
+  return client.connected();
+}
+
+struct Qos1Result {
+  double messages_per_s;
+  double writes_per_message;
+  bool complete;
+};
+
+static Qos1Result run_qos1(bool stop_and_wait) {
+  StandInBroker broker(ACK_DELAY, 0);
+  MqttSocketTransport net;
+  AsyncMqttClient client(net);
+  client.setServer("127.0.0.1", broker.port());
+  client.setCredentials("bench");
+  auto start = Clock::now();
+  if (!connect_async(client, start))
+    return {0, 0, false};
+
+  uint32_t seq = 0;
+  uint32_t writes_before = client.stats().writes;
+  auto first = Clock::now();
+  while (client.stats().acked < QOS1_MESSAGES && seconds_since(first) < 20) {
+    // Window 1: the next message only once the last one is acknowledged
+    while (seq < QOS1_MESSAGES && client.queuedCount() < (stop_and_wait ? 1 : MQTT_QUEUE_SLOTS)) {
+      if (!client.publish(TOPIC, payload_for(seq, 24).c_str(), false, 1))
+        break;
+      seq++;
+    }
+    client.loop(ms_since(start));
+    usleep(100);
+  }
+  double seconds = seconds_since(first);
+  bool complete = client.stats().acked == QOS1_MESSAGES && broker.delivered() == QOS1_MESSAGES && broker.in_order();
+  return {QOS1_MESSAGES / seconds, double(client.stats().writes - writes_before) / QOS1_MESSAGES, complete};
+}
+
+struct SlowLinkResult {
+  double max_stall_ms;
+  uint32_t published;
+  uint32_t dropped;
+  uint32_t delivered;
+  bool in_order;
+};
+
+/// One PUBLISH every PUBLISH_INTERVAL_MS for SLOW_RUN_MS, from a loop that does nothing else; `service` gets the
+/// milliseconds since `start`
+template<typename Publish, typename Service>
+static SlowLinkResult slow_link_loop(Clock::time_point start, Publish publish, Service service) {
+  SlowLinkResult result{};
+  uint32_t end = ms_since(start) + SLOW_RUN_MS;
+  uint32_t last_publish = 0;
+  for (uint32_t now = ms_since(start); now < end; now = ms_since(start)) {
+    auto iteration = Clock::now();
+    if (now - last_publish >= PUBLISH_INTERVAL_MS) {
+      last_publish = now;
+      if (publish(payload_for(result.published, 180).c_str())) {
+        result.published++;
+      } else {
+        result.dropped++;
+      }
+    }
+    service(ms_since(start));
+    result.max_stall_ms = std::max(result.max_stall_ms, seconds_since(iteration) * 1e3);
+    usleep(200);
+  }
+  return result;
+}
+
+static SlowLinkResult run_slow_link_async() {
+  StandInBroker broker(ACK_DELAY, LINK_BYTES_PER_MS);
+  DeviceSocketTransport net;
+  AsyncMqttClient client(net);
+  client.setServer("127.0.0.1", broker.port());
+  client.setCredentials("bench");
+  // The client's clock must not go backwards between connecting and publishing
+  auto start = Clock::now();
+  if (!connect_async(client, start))
+    return {};
+  SlowLinkResult result = slow_link_loop(
+      start, [&](const char *payload) { return client.publish(TOPIC, payload, false, 0); },
+      [&](uint32_t now) { client.loop(now); });
+  result.delivered = broker.delivered();
+  result.in_order = broker.in_order();
+  return result;
+}
+
+static SlowLinkResult run_slow_link_blocking() {
+  StandInBroker broker(ACK_DELAY, LINK_BYTES_PER_MS);
+  BlockingPublisher client;
+  if (!client.connect(broker.port()))
+    return {};
+  SlowLinkResult result = slow_link_loop(
+      Clock::now(), [&](const char *payload) { return client.publish(TOPIC, payload); }, [](uint32_t now) {});
+  result.delivered = broker.delivered();
+  result.in_order = broker.in_order();
+  return result;
+}
+
+int main() {
+  bool ok = true;
+  printf("QoS1, %u messages, PUBACK %lld us after each PUBLISH\n", QOS1_MESSAGES, (long long) ACK_DELAY.count());
+  for (bool stop_and_wait : {true, false}) {
+    Qos1Result r = run_qos1(stop_and_wait);
+    printf("window %d  %7.0f messages/s  %5.2f writes per message\n", stop_and_wait ? 1 : MQTT_MAX_INFLIGHT,
+           r.messages_per_s, r.writes_per_message);
+    ok &= r.complete;
+  }
+
+  printf("QoS0 over a %u KB/s link for %u ms, one %s every %u ms\n", LINK_BYTES_PER_MS, SLOW_RUN_MS,
+         "200 byte PUBLISH", PUBLISH_INTERVAL_MS);
+  for (bool async : {true, false}) {
+    SlowLinkResult r = async ? run_slow_link_async() : run_slow_link_blocking();
+    printf("%-8s  %8.2f ms longest loop stall  %4u published  %4u dropped  %4u delivered\n",
+           async ? "async" : "blocking", r.max_stall_ms, r.published, r.dropped, r.delivered);
+    ok &= r.in_order && r.published > 0;
+  }
+  if (!ok) {
+    printf("broker saw messages lost, duplicated or out of order\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,119 @@
+// A 2 MB firmware upload through MultipartReader, read the way AsyncWebServer::handle_multipart_upload_() does: a
+// receive buffer allocated once, filled chunk by chunk and scanned in place. Reports throughput, and the heap
+// allocations and peak heap held by the reader and its buffer, for the 4 KB receive window and the 1460 byte
+// (one TCP segment) window the upload loop used before. Exits 1 if the delivered bytes differ from the image.
+#include "esphome/components/web_server_idf/multipart.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+
+using esphome::web_server_idf::MultipartReader;
+
+static constexpr size_t IMAGE_SIZE = 2 * 1024 * 1024;
+static constexpr int ROUNDS = 20;
+
+// Live heap bytes, as glibc sizes the blocks
+static size_t allocations = 0;
+static size_t live_bytes = 0;
+static size_t peak_bytes = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  live_bytes += malloc_usable_size(p);
+  peak_bytes = std::max(peak_bytes, live_bytes);
+  return p;
+}
+void operator delete(void *p) noexcept {
+  live_bytes -= malloc_usable_size(p);
+  free(p);
+}
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete[](void *p) noexcept { operator delete(p); }
+void operator delete[](void *p, size_t size) noexcept { operator delete(p); }
+
+static const char BOUNDARY[] = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Result {
+  double mb_per_s;
+  size_t allocations;
+  size_t peak_bytes;
+  bool intact;
+};
+
+/// `image` stands in for the OTA partition: the data callback copies each span to its offset
+static Result run(const std::string &body, size_t chunk_size, std::string &image) {
+  Result result{};
+  size_t allocations_before = allocations;
+  size_t live_before = live_bytes;
+  peak_bytes = live_bytes;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < ROUNDS; round++) {
+    size_t written = 0;
+    auto reader = std::make_unique<MultipartReader>(BOUNDARY, strlen(BOUNDARY));
+    reader->set_data_callback([&](const uint8_t *data, size_t len) {
+      if (!reader->has_file() || written + len > image.size())
+        return;
+      memcpy(&image[written], data, len);
+      written += len;
+    });
+    auto buffer = std::make_unique<char[]>(chunk_size);
+    for (size_t offset = 0; offset < body.size();) {
+      // Stands in for httpd_req_recv() filling the buffer
+      size_t len = std::min(body.size() - offset, chunk_size);
+      memcpy(buffer.get(), body.data() + offset, len);
+      if (reader->parse(buffer.get(), len) != len)
+        break;
+      offset += len;
+    }
+    result.intact = written == image.size() && reader->is_done();
+  }
+  double seconds = seconds_since(start);
+  result.mb_per_s = double(body.size()) * ROUNDS / seconds / 1e6;
+  result.allocations = (allocations - allocations_before) / ROUNDS;
+  result.peak_bytes = peak_bytes - live_before;
+  return result;
+}
+
+int main() {
+  // Incompressible image bytes, so CR (and partial delimiters) turn up about once every 256 bytes
+  std::string image(IMAGE_SIZE, '\0');
+  std::mt19937 rng(2);
+  for (auto &c : image)
+    c = static_cast<char>(rng());
+
+  std::string body = std::string("--") + BOUNDARY +
+                     "\r\nContent-Disposition: form-data; name=\"update\"; filename=\"firmware.bin\"\r\n"
+                     "Content-Type: application/octet-stream\r\n\r\n" +
+                     image + "\r\n--" + BOUNDARY + "--\r\n";
+
+  printf("%zu byte upload, %d rounds\n", body.size(), ROUNDS);
+  bool ok = true;
+  std::string received(IMAGE_SIZE, '\0');
+  for (size_t chunk_size : {size_t(1460), size_t(4096)}) {
+    Result r = run(body, chunk_size, received);
+    printf("%4zu byte chunks  %7.1f MB/s  %zu allocations  %zu bytes peak heap\n", chunk_size, r.mb_per_s,
+           r.allocations, r.peak_bytes);
+    ok &= r.intact && received == image;
+    received.assign(IMAGE_SIZE, '\0');
+  }
+  if (!ok) {
+    printf("delivered bytes differ from the image\n");
+    return 1;
+  }
+  return 0;
+}
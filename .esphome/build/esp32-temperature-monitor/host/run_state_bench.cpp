@@ -0,0 +1,143 @@
+// Heap allocations and time per run of a delay -> wait_until -> lambda chain with (std::string, float) arguments,
+// retriggered RUNS times:
+//  - "pooled": DelayAction and WaitUntilAction parking their arguments in RunStatePool slots
+//  - "bind/list": the same actions as they were before, a std::bind copy per delay and a std::list node per wait
+// The delay is 0 ms, so each run goes through the scheduler's defer queue on the next call(); the wait_until
+// condition fails on the first check and passes once the benchmark sets it, so every run parks in wait_until too.
+// Arguments that fit std::string's inline buffer and ones that don't are measured separately. Exits 1 if the two
+// versions deliver different arguments.
+#include "esphome/core/application.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/base_automation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <new>
+#include <string>
+
+using namespace esphome;
+
+static const int RUNS = 100000;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// DelayAction before RunStatePool: the arguments ride in a std::bind copy inside the scheduler callback
+template<typename... Ts> class BindDelayAction : public Action<Ts...>, public Component {
+ public:
+  TEMPLATABLE_VALUE(uint32_t, delay)
+
+  void play_complex(const Ts &...x) override {
+    this->num_running_++;
+    // set_timer_common_() is reserved for DelayAction; one run is in flight at a time, so set_timeout() is equivalent
+    auto f = std::bind(&BindDelayAction<Ts...>::play_next_, this, x...);
+    this->set_timeout(InternalSchedulerID::DELAY_ACTION, this->delay_.value(x...), std::move(f));
+  }
+  void play(const Ts &...x) override {}
+  void stop() override { this->cancel_timeout(InternalSchedulerID::DELAY_ACTION); }
+};
+
+/// WaitUntilAction before RunStatePool: each waiting run is a std::list node
+template<typename... Ts> class ListWaitUntilAction : public Action<Ts...>, public Component {
+ public:
+  ListWaitUntilAction(Condition<Ts...> *condition) : condition_(condition) {}
+
+  void play_complex(const Ts &...x) override {
+    this->num_running_++;
+    if (this->condition_->check(x...)) {
+      this->play_next_(x...);
+      return;
+    }
+    this->var_queue_.emplace_back(millis(), optional<uint32_t>{}, std::make_tuple(x...));
+  }
+  void loop() override {
+    this->var_queue_.remove_if([&](auto &queued) {
+      auto &var = std::get<std::tuple<Ts...>>(queued);
+      if (!this->condition_->check_tuple(var))
+        return false;
+      this->play_next_tuple_(var);
+      return true;
+    });
+  }
+  void play(const Ts &...x) override {}
+  void stop() override { this->var_queue_.clear(); }
+
+ protected:
+  Condition<Ts...> *condition_;
+  std::list<std::tuple<uint32_t, optional<uint32_t>, std::tuple<Ts...>>> var_queue_{};
+};
+
+struct Result {
+  double ns_per_run;
+  double allocations_per_run;
+  size_t checksum;
+};
+
+template<typename Delay, typename Wait> static Result run(const std::string *names) {
+  bool ready = false;
+  size_t checksum = 0;
+  Trigger<std::string, float> trigger;
+  Automation<std::string, float> automation(&trigger);
+  LambdaCondition<std::string, float> condition([&ready](const std::string &, float) { return ready; });
+  Delay delay;
+  delay.set_delay(0);
+  Wait wait(&condition);
+  LambdaAction<std::string, float> lambda(
+      [&checksum](const std::string &name, float value) { checksum += name.size() + name[0] + size_t(value); });
+  automation.add_actions({&delay, &wait, &lambda});
+
+  auto one_run = [&](int i) {
+    ready = false;
+    trigger.trigger(names[i & 1], float(i & 63));
+    App.scheduler.call(millis());
+    ready = true;
+    wait.loop();
+  };
+  // The first runs size the pools and the scheduler's item recycling; only the steady state counts
+  for (int i = 0; i < 16; i++)
+    one_run(i);
+  checksum = 0;
+  size_t before = allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++)
+    one_run(i);
+  double seconds = seconds_since(start);
+  return {seconds * 1e9 / RUNS, double(allocations - before) / RUNS, checksum};
+}
+
+int main() {
+  static const std::string SHORT_NAMES[2] = {"kitchen", "hallway"};
+  static const std::string LONG_NAMES[2] = {"kitchen ceiling light", "upstairs hallway motion"};
+  printf("%d runs of delay -> wait_until -> lambda with (std::string, float)\n", RUNS);
+  bool ok = true;
+  for (const std::string *names : {SHORT_NAMES, LONG_NAMES}) {
+    Result pooled = run<DelayAction<std::string, float>, WaitUntilAction<std::string, float>>(names);
+    Result old = run<BindDelayAction<std::string, float>, ListWaitUntilAction<std::string, float>>(names);
+    const char *kind = names == SHORT_NAMES ? "inline" : "heap";
+    printf("%-6s strings  pooled     %6.1f ns  %5.2f allocations per run\n", kind, pooled.ns_per_run,
+           pooled.allocations_per_run);
+    printf("%-6s strings  bind/list  %6.1f ns  %5.2f allocations per run\n", kind, old.ns_per_run,
+           old.allocations_per_run);
+    ok &= pooled.checksum == old.checksum && pooled.checksum != 0;
+  }
+  if (!ok) {
+    printf("delivered arguments differ\n");
+    return 1;
+  }
+  return 0;
+}
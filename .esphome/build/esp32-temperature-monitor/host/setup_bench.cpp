@@ -0,0 +1,159 @@
+// Time from App.setup() to the first accepted API connection, with and without setup dependencies.
+// Each boot runs in a forked child with a fresh App:
+//  - the AHT10 driver (AHT20 variant) against a simulated device on a HostI2CBus
+//  - a WiFi stand-in that associates ASSOC_MS after its setup() runs
+//  - a loopback listener standing in for the API server, and a client thread that connects as soon as the network is
+//    up, like Home Assistant reconnecting after a reboot
+// "serial" declares no dependencies, so components start in priority order, each once the earlier ones have returned
+// from setup() and can_proceed(); the AHT10 calibration runs async either way. "dependencies" declares the ones the
+// generated main.cpp does: aht10 on the bus, api on wifi.
+#include "esphome/components/aht10/aht10.h"
+#include "esphome/components/i2c/i2c_bus_host.h"
+#include "esphome/components/soak_test/sim_devices.h"
+#include "esphome/core/application.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using namespace esphome;
+
+static constexpr uint32_t ASSOC_MS = 300;
+static constexpr int RUNS = 20;
+
+static std::atomic<bool> associated{false};
+
+static double now_ms() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+class SimWiFi : public Component {
+ public:
+  void setup() override { this->start_ = millis(); }
+  void loop() override {
+    if (!associated && millis() - this->start_ >= ASSOC_MS)
+      associated = true;
+  }
+  float get_setup_priority() const override { return setup_priority::WIFI; }
+
+ protected:
+  uint32_t start_{0};
+};
+
+class SimApi : public Component {
+ public:
+  void setup() override {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    ::bind(fd, reinterpret_cast<sockaddr *>(&addr), len);
+    ::listen(fd, 8);
+    ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len);
+    ::fcntl(fd, F_SETFL, O_NONBLOCK);
+    this->port = ntohs(addr.sin_port);
+    this->fd = fd;
+  }
+  void loop() override {
+    if (::accept(this->fd, nullptr, nullptr) >= 0)
+      this->accepted = true;
+  }
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  std::atomic<int> fd{-1};
+  std::atomic<uint16_t> port{0};
+  bool accepted{false};
+};
+
+/// One boot; returns milliseconds from App.setup() to the accepted connection
+static double boot(bool dependencies) {
+  App.pre_setup("setup-bench", "", false);
+  auto *bus = new i2c::HostI2CBus();
+  App.register_component(bus);
+  bus->add_device(new soak_test::AHT10Model());
+  auto *aht = new aht10::AHT10Component();
+  aht->set_update_interval(60000);
+  aht->set_variant(aht10::AHT20);
+  aht->set_i2c_bus(bus);
+  aht->set_i2c_address(0x38);
+  App.register_component(aht);
+  auto *wifi = new SimWiFi();
+  App.register_component(wifi);
+  auto *api = new SimApi();
+  App.register_component(api);
+  if (dependencies) {
+    aht->add_setup_dependency(bus);
+    api->add_setup_dependency(wifi);
+  }
+
+  std::thread([api] {
+    while (!associated || api->fd < 0)
+      usleep(100);
+    for (;;) {
+      int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+      sockaddr_in addr{};
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = htons(api->port);
+      if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0)
+        return;
+      ::close(fd);
+      usleep(100);
+    }
+  }).detach();
+
+  double start = now_ms();
+  App.setup();
+  while (!api->accepted)
+    App.loop();
+  return now_ms() - start;
+}
+
+static void measure(const char *name, bool dependencies) {
+  std::vector<double> times;
+  for (int run = 0; run < RUNS; run++) {
+    int fds[2];
+    if (pipe(fds) != 0)
+      exit(1);
+    pid_t pid = fork();
+    if (pid == 0) {
+      double ms = boot(dependencies);
+      write(fds[1], &ms, sizeof(ms));
+      _exit(0);
+    }
+    double ms;
+    if (read(fds[0], &ms, sizeof(ms)) == sizeof(ms))
+      times.push_back(ms);
+    waitpid(pid, nullptr, 0);
+    close(fds[0]);
+    close(fds[1]);
+  }
+  if (times.empty()) {
+    printf("%-13s no run completed\n", name);
+    return;
+  }
+  std::sort(times.begin(), times.end());
+  printf("%-13s median %6.1f ms  max %6.1f ms  (%zu runs)\n", name, times[times.size() / 2], times.back(),
+         times.size());
+}
+
+int main() {
+  printf("first API connection after App.setup(), WiFi associates %u ms after its setup()\n", ASSOC_MS);
+  measure("serial", false);
+  measure("dependencies", true);
+  return 0;
+}
@@ -0,0 +1,151 @@
+// Soak run of the esp32-temperature-monitor components on the host:
+//  - the AHT10 and SSD1306 drivers against simulated devices on a HostI2CBus
+//  - the PIR as a GPIO binary sensor on a scripted pin
+//  - the real API server (plaintext) on loopback
+//  - a minimal HTTP responder standing in for the web server, which is ESP-IDF only
+// SoakTestComponent probes both servers and logs its metric lines. Time runs at wall speed.
+//
+//   build/soak [duration_ms]    0 runs until killed; exits non-zero if a probe never got an answer
+#include "esphome/components/aht10/aht10.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/gpio/binary_sensor/gpio_binary_sensor.h"
+#include "esphome/components/i2c/i2c_bus_host.h"
+#include "esphome/components/ssd1306_i2c/ssd1306_i2c.h"
+#include "esphome/components/soak_test/sim_devices.h"
+#include "esphome/components/soak_test/soak_test.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+
+using namespace esphome;
+
+static constexpr uint16_t API_PORT = 6053;
+
+/// Answers every HTTP request with a 401, which is what the auth-protected web server does for a probe
+class WebResponder : public Component {
+ public:
+  void setup() override {
+    this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    ::setsockopt(this->fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (::bind(this->fd_, reinterpret_cast<sockaddr *>(&addr), len) != 0 || ::listen(this->fd_, 8) != 0) {
+      this->mark_failed();
+      return;
+    }
+    ::getsockname(this->fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+    this->port_ = ntohs(addr.sin_port);
+    ::fcntl(this->fd_, F_SETFL, O_NONBLOCK);
+  }
+  void loop() override {
+    int client = ::accept(this->fd_, nullptr, nullptr);
+    if (client < 0)
+      return;
+    char request[256];
+    ::recv(client, request, sizeof(request), MSG_DONTWAIT);
+    static const char RESPONSE[] = "HTTP/1.1 401 Unauthorized\r\nContent-Length: 0\r\n\r\n";
+    ::send(client, RESPONSE, sizeof(RESPONSE) - 1, MSG_NOSIGNAL);
+    ::close(client);
+  }
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  uint16_t get_port() const { return this->port_; }
+
+ protected:
+  int fd_{-1};
+  uint16_t port_{0};
+};
+
+int main(int argc, char **argv) {
+  uint32_t duration = argc > 1 ? strtoul(argv[1], nullptr, 10) : 60000;
+  // The metric lines are logged at INFO
+  if (getenv("HOST_LOG_LEVEL") == nullptr)
+    esp_log_active_level = ESPHOME_LOG_LEVEL_INFO;
+
+  App.pre_setup("esp32-temperature-monitor", "", false);
+
+  auto *bus = new i2c::HostI2CBus();
+  bus->set_scan(true);
+  App.register_component(bus);
+  auto *aht_model = new soak_test::AHT10Model();
+  aht_model->set_period(60000);
+  bus->add_device(aht_model);
+  auto *oled_model = new soak_test::SSD1306Model();
+  bus->add_device(oled_model);
+
+  auto *aht = new aht10::AHT10Component();
+  aht->set_update_interval(5000);
+  aht->set_i2c_bus(bus);
+  aht->set_i2c_address(0x38);
+  App.register_component(aht);
+  auto *temperature = new sensor::Sensor();
+  temperature->set_name("Temperature");
+  App.register_sensor(temperature);
+  aht->set_temperature_sensor(temperature);
+  auto *humidity = new sensor::Sensor();
+  humidity->set_name("Humidity");
+  App.register_sensor(humidity);
+  aht->set_humidity_sensor(humidity);
+
+  // Motion for 3 s every 10 s
+  auto *pin = new soak_test::ScriptedPin();
+  pin->set_script({{7000, false}, {3000, true}});
+  auto *pir = new gpio::GPIOBinarySensor();
+  pir->set_name("PIR");
+  pir->set_pin(pin);
+  App.register_binary_sensor(pir);
+  App.register_component(pir);
+
+  // Same display setup as the device. There are no fonts on the host, so bars stand in for the text lines; the
+  // frame still changes with the readings and the whole buffer is written every second as on the device.
+  auto *oled = new ssd1306_i2c::I2CSSD1306();
+  oled->set_update_interval(1000);
+  oled->set_auto_clear(true);
+  oled->set_model(ssd1306_base::SSD1306_MODEL_128_64);
+  oled->init_flip_x(true);
+  oled->init_flip_y(true);
+  oled->set_i2c_bus(bus);
+  oled->add_setup_dependency(bus);
+  oled->set_i2c_address(0x3C);
+  App.register_component(oled);
+  oled->set_writer([pir, temperature, humidity](display::Display &it) {
+    if (pir->state)
+      it.filled_rectangle(0, 0, 128, 8);
+    it.filled_rectangle(0, 32, static_cast<int>(temperature->state * 4), 8);
+    it.filled_rectangle(0, 48, static_cast<int>(humidity->state), 8);
+  });
+
+  auto *api = new api::APIServer();
+  api->set_port(API_PORT);
+  // Nothing may be connected for the whole run; the default timeout would reboot a soak longer than 5 minutes
+  api->set_reboot_timeout(0);
+  App.register_component(api);
+  auto *web = new WebResponder();
+  App.register_component(web);
+
+  auto *soak = new soak_test::SoakTestComponent();
+  soak->set_report_interval(10000);
+  soak->set_probe_interval(1000);
+  soak->set_duration(duration);
+  soak->add_i2c_device("aht10", aht_model);
+  soak->add_i2c_device("oled", oled_model);
+  soak->add_probe(new soak_test::LoopbackProbe("api", API_PORT, soak_test::API_PLAINTEXT_HELLO,
+                                               sizeof(soak_test::API_PLAINTEXT_HELLO)));
+  App.register_component(soak);
+
+  App.setup();
+  // The web responder's port is only known once it has bound
+  soak->add_probe(new soak_test::LoopbackProbe("web", web->get_port(), soak_test::WEB_ROOT_REQUEST,
+                                               sizeof(soak_test::WEB_ROOT_REQUEST) - 1));
+
+  for (;;)
+    App.loop();
+}
@@ -0,0 +1,273 @@
+// APIConnection::process_iterator_batch_() pacing: the list_entities iterator against a socket whose TX window fills up
+#include "esphome/components/api/api_connection.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+#include "host_test.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using namespace esphome;
+using api::APIConnection;
+
+static constexpr size_t SENSOR_COUNT = ESPHOME_ENTITY_SENSOR_COUNT;
+static constexpr uint8_t HELLO_REQUEST = 1;
+static constexpr uint8_t HELLO_RESPONSE = 2;
+static constexpr uint8_t LIST_ENTITIES_REQUEST = 11;
+static constexpr uint8_t LIST_ENTITIES_SENSOR_RESPONSE = 16;
+static constexpr uint8_t LIST_ENTITIES_DONE_RESPONSE = 19;
+
+// Every heap allocation in the process, so a test can assert that a stretch of loops allocated nothing
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+
+/// A connected client socket: reads what the test queued in rx, accepts writes only while the TX window has room
+class FakeSocket : public socket::Socket {
+ public:
+  std::vector<uint8_t> rx;
+  std::vector<uint8_t> tx;
+  size_t window{SIZE_MAX};
+
+  ssize_t read(void *buf, size_t len) override {
+    if (this->rx.empty()) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    len = std::min(len, this->rx.size());
+    memcpy(buf, this->rx.data(), len);
+    this->rx.erase(this->rx.begin(), this->rx.begin() + len);
+    return len;
+  }
+  ssize_t readv(const struct iovec *iov, int iovcnt) override { return this->read(iov[0].iov_base, iov[0].iov_len); }
+  ssize_t write(const void *buf, size_t len) override {
+    struct iovec iov = {const_cast<void *>(buf), len};
+    return this->writev(&iov, 1);
+  }
+  ssize_t writev(const struct iovec *iov, int iovcnt) override {
+    if (this->window == 0) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    size_t written = 0;
+    for (int i = 0; i < iovcnt && this->window > 0; i++) {
+      size_t n = std::min(iov[i].iov_len, this->window);
+      auto *data = static_cast<const uint8_t *>(iov[i].iov_base);
+      this->tx.insert(this->tx.end(), data, data + n);
+      this->window -= n;
+      written += n;
+    }
+    return written;
+  }
+  int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
+    auto *in = reinterpret_cast<struct sockaddr_in *>(addr);
+    memset(in, 0, sizeof(*in));
+    in->sin_family = AF_INET;
+    in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    *addrlen = sizeof(*in);
+    return 0;
+  }
+  int getsockname(struct sockaddr *addr, socklen_t *addrlen) override { return this->getpeername(addr, addrlen); }
+  int setsockopt(int level, int optname, const void *optval, socklen_t optlen) override { return 0; }
+  int getsockopt(int level, int optname, void *optval, socklen_t *optlen) override { return 0; }
+  int setblocking(bool blocking) override { return 0; }
+  int close() override { return 0; }
+  int shutdown(int how) override { return 0; }
+  std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) override { return nullptr; }
+  int bind(const struct sockaddr *addr, socklen_t addrlen) override { return -1; }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return -1; }
+  int listen(int backlog) override { return -1; }
+  ssize_t recvfrom(void *buf, size_t len, sockaddr *addr, socklen_t *addr_len) override { return -1; }
+  ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) override {
+    return -1;
+  }
+};
+
+struct Frame {
+  uint8_t type;
+  std::vector<uint8_t> payload;
+};
+
+static void put_varint(std::vector<uint8_t> &out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+static uint32_t get_varint(const std::vector<uint8_t> &in, size_t &pos) {
+  uint32_t value = 0;
+  for (uint8_t shift = 0; pos < in.size(); shift += 7) {
+    uint8_t b = in[pos++];
+    value |= uint32_t(b & 0x7F) << shift;
+    if ((b & 0x80) == 0)
+      break;
+  }
+  return value;
+}
+
+static void put_frame(std::vector<uint8_t> &out, uint8_t type, const std::vector<uint8_t> &payload) {
+  out.push_back(0x00);
+  put_varint(out, payload.size());
+  put_varint(out, type);
+  out.insert(out.end(), payload.begin(), payload.end());
+}
+
+/// Splits everything the device wrote into plaintext frames; a truncated tail is left out
+static std::vector<Frame> parse_frames(const std::vector<uint8_t> &tx) {
+  std::vector<Frame> frames;
+  size_t pos = 0;
+  while (pos < tx.size() && tx[pos] == 0x00) {
+    pos++;
+    uint32_t len = get_varint(tx, pos);
+    uint8_t type = get_varint(tx, pos);
+    if (pos + len > tx.size())
+      break;
+    frames.push_back({type, std::vector<uint8_t>(tx.begin() + pos, tx.begin() + pos + len)});
+    pos += len;
+  }
+  return frames;
+}
+
+/// The fixed32 key (field 2) of a ListEntities*Response
+static uint32_t entity_key(const Frame &frame) {
+  size_t pos = 0;
+  while (pos < frame.payload.size()) {
+    uint32_t tag = get_varint(frame.payload, pos);
+    switch (tag & 7) {
+      case 0:
+        get_varint(frame.payload, pos);
+        break;
+      case 2:
+        pos += get_varint(frame.payload, pos);
+        break;
+      case 5: {
+        uint32_t value;
+        memcpy(&value, &frame.payload[pos], 4);
+        if ((tag >> 3) == 2)
+          return value;
+        pos += 4;
+        break;
+      }
+      default:
+        return 0;
+    }
+  }
+  return 0;
+}
+
+static api::APIServer *server;
+
+/// Connects a client that says hello (API 1.14) and asks for the entity list
+static std::unique_ptr<APIConnection> connect(FakeSocket *&sock) {
+  auto owned = std::make_unique<FakeSocket>();
+  sock = owned.get();
+  std::vector<uint8_t> hello = {0x0A, 4, 't', 'e', 's', 't', 0x10, 1, 0x18, 14};
+  put_frame(sock->rx, HELLO_REQUEST, hello);
+  put_frame(sock->rx, LIST_ENTITIES_REQUEST, {});
+  auto conn = std::make_unique<APIConnection>(std::move(owned), server);
+  conn->start();
+  return conn;
+}
+
+/// Hello response, then every sensor exactly once in registration order, then the done message
+static void expect_complete_listing(const std::vector<Frame> &frames) {
+  EXPECT_EQ(frames.size(), SENSOR_COUNT + 2);
+  if (frames.size() != SENSOR_COUNT + 2)
+    return;
+  EXPECT_EQ(frames.front().type, HELLO_RESPONSE);
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    EXPECT_EQ(frames[i + 1].type, LIST_ENTITIES_SENSOR_RESPONSE);
+    EXPECT_EQ(entity_key(frames[i + 1]), i + 1);
+  }
+  EXPECT_EQ(frames.back().type, LIST_ENTITIES_DONE_RESPONSE);
+}
+
+static void loop_until_done(APIConnection *conn, FakeSocket *sock, size_t refill) {
+  for (int i = 0; i < 1000; i++) {
+    if (refill != 0)
+      sock->window = refill;
+    conn->loop();
+    auto frames = parse_frames(sock->tx);
+    if (!frames.empty() && frames.back().type == LIST_ENTITIES_DONE_RESPONSE)
+      return;
+  }
+}
+
+void test_iterator_paused_while_tx_window_full() {
+  FakeSocket *sock;
+  auto conn = connect(sock);
+
+  // Nothing can be written: the hello response waits in the TX queue and no entity may be pulled behind it
+  sock->window = 0;
+  conn->loop();
+  size_t before = allocations;
+  for (int i = 0; i < 20; i++)
+    conn->loop();
+  EXPECT_EQ(allocations, before);
+  EXPECT_TRUE(sock->tx.empty());
+
+  // Room for the hello response and part of the first batch; the rest of that batch stays queued
+  sock->window = 256;
+  conn->loop();
+  EXPECT_EQ(sock->window, 0u);
+  auto partial = parse_frames(sock->tx);
+  EXPECT_TRUE(partial.size() > 1 && partial.size() < api::MAX_INITIAL_PER_BATCH + 1);
+
+  // Still blocked: the iterator stays where it is, so no new batch items are allocated
+  before = allocations;
+  for (int i = 0; i < 20; i++)
+    conn->loop();
+  EXPECT_EQ(allocations, before);
+  EXPECT_EQ(parse_frames(sock->tx).size(), partial.size());
+
+  sock->window = SIZE_MAX;
+  loop_until_done(conn.get(), sock, 0);
+  expect_complete_listing(parse_frames(sock->tx));
+}
+
+void test_entities_resume_without_gaps_under_slow_reader() {
+  FakeSocket *sock;
+  auto conn = connect(sock);
+
+  // A reader that drains 100 bytes per loop splits frames and batches at arbitrary points
+  loop_until_done(conn.get(), sock, 100);
+  expect_complete_listing(parse_frames(sock->tx));
+}
+
+void test_entities_listed_in_batches_when_writable() {
+  FakeSocket *sock;
+  auto conn = connect(sock);
+
+  loop_until_done(conn.get(), sock, 0);
+  expect_complete_listing(parse_frames(sock->tx));
+}
+
+int main() {
+  static sensor::Sensor sensors[SENSOR_COUNT];
+  static char names[SENSOR_COUNT][12];
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    snprintf(names[i], sizeof(names[i]), "sensor %zu", i);
+    sensors[i].set_name(names[i], i + 1);
+    App.register_sensor(&sensors[i]);
+  }
+  server = new api::APIServer();
+
+  RUN_TEST(test_iterator_paused_while_tx_window_full);
+  RUN_TEST(test_entities_resume_without_gaps_under_slow_reader);
+  RUN_TEST(test_entities_listed_in_batches_when_writable);
+  return host_test::failures;
+}
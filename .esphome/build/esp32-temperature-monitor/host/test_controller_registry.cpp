@@ -0,0 +1,101 @@
+// ControllerRegistry::flush(): coalesced sensor updates, including ones a controller publishes while being flushed
+#include "esphome/core/application.h"
+#include "esphome/core/controller.h"
+#include "esphome/core/controller_registry.h"
+#include "host_test.h"
+#include <functional>
+#include <vector>
+
+using namespace esphome;
+
+static sensor::Sensor sensors[2];
+
+/// Records each update it is handed, with the state it saw, and runs `react` after recording
+class RecordingController : public Controller {
+ public:
+  struct Update {
+    sensor::Sensor *obj;
+    float state;
+  };
+  std::vector<Update> updates;
+  std::function<void(sensor::Sensor *)> react;
+
+  void on_sensor_update(sensor::Sensor *obj) override {
+    this->updates.push_back({obj, obj->state});
+    if (this->react)
+      this->react(obj);
+  }
+};
+
+static RecordingController first, second;
+
+static void reset() {
+  first.updates.clear();
+  second.updates.clear();
+  first.react = nullptr;
+}
+
+void test_updates_are_coalesced_until_flush() {
+  reset();
+  sensors[0].publish_state(1.0f);
+  sensors[0].publish_state(2.0f);
+  EXPECT_EQ(first.updates.size(), 0u);
+  ControllerRegistry::flush();
+  EXPECT_EQ(first.updates.size(), 1u);
+  EXPECT_EQ(second.updates.size(), 1u);
+  EXPECT_TRUE(first.updates[0].obj == &sensors[0] && first.updates[0].state == 2.0f);
+}
+
+void test_publish_from_controller_during_flush() {
+  // A derived value: the first controller publishes sensor 1 whenever sensor 0 reaches it
+  reset();
+  first.react = [](sensor::Sensor *obj) {
+    if (obj == &sensors[0])
+      sensors[1].publish_state(obj->state * 10.0f);
+  };
+  sensors[0].publish_state(3.0f);
+  ControllerRegistry::flush();
+  EXPECT_EQ(first.updates.size(), 2u);
+  EXPECT_EQ(second.updates.size(), 2u);
+  EXPECT_TRUE(second.updates[1].obj == &sensors[1] && second.updates[1].state == 30.0f);
+
+  // Nothing was left pending: the next publish of sensor 1 is queued and delivered again
+  reset();
+  sensors[1].publish_state(4.0f);
+  ControllerRegistry::flush();
+  EXPECT_EQ(first.updates.size(), 1u);
+  EXPECT_TRUE(first.updates[0].obj == &sensors[1] && first.updates[0].state == 4.0f);
+}
+
+void test_republish_of_delivered_entity_during_flush() {
+  // The first controller corrects sensor 0 once, after both controllers have been handed the old value
+  reset();
+  first.react = [](sensor::Sensor *obj) {
+    if (obj == &sensors[0] && obj->state == 5.0f)
+      sensors[0].publish_state(6.0f);
+  };
+  sensors[0].publish_state(5.0f);
+  ControllerRegistry::flush();
+  EXPECT_EQ(second.updates.size(), 2u);
+  EXPECT_TRUE(second.updates.back().obj == &sensors[0] && second.updates.back().state == 6.0f);
+
+  reset();
+  ControllerRegistry::flush();
+  EXPECT_EQ(first.updates.size(), 0u);
+  sensors[0].publish_state(7.0f);
+  ControllerRegistry::flush();
+  EXPECT_EQ(first.updates.size(), 1u);
+}
+
+int main() {
+  for (int i = 0; i < 2; i++) {
+    sensors[i].set_name(i == 0 ? "Raw" : "Derived", i + 1);
+    App.register_sensor(&sensors[i]);
+  }
+  ControllerRegistry::register_controller(&first);
+  ControllerRegistry::register_controller(&second);
+  RUN_TEST(test_updates_are_coalesced_until_flush);
+  RUN_TEST(test_publish_from_controller_during_flush);
+  RUN_TEST(test_republish_of_delivered_entity_during_flush);
+  return host_test::failures;
+}
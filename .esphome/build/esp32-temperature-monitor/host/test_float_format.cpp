@@ -0,0 +1,91 @@
+// format_float_fixed_to() against glibc's snprintf("%.*f") for 0 to FORMAT_FLOAT_FIXED_MAX_DECIMALS + 1 decimals
+//
+//   build/test_float_format         strided sweeps, a few seconds
+//   build/test_float_format full    also every positive float below 2^21 (about an hour)
+#include "esphome/core/helpers.h"
+#include "host_test.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace esphome;
+
+static size_t mismatches = 0;
+
+static bool same_as_printf(float value, uint8_t decimals) {
+  char expected[64], actual[64];
+  int expected_len = snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+  size_t actual_len = format_float_fixed_to(actual, sizeof(actual), value, decimals);
+  if (actual_len == size_t(expected_len) && strcmp(actual, expected) == 0)
+    return true;
+  if (mismatches++ < 10)
+    printf("  %a with %u decimals: \"%s\", printf gives \"%s\"\n", value, decimals, actual, expected);
+  return false;
+}
+
+/// Every bit pattern from `first` up to (not including) `last`, in steps of `stride`, optionally also negated
+static bool sweep(uint32_t first, uint32_t last, uint32_t stride, bool negative = true) {
+  bool ok = true;
+  for (uint64_t bits = first; bits < last; bits += stride) {
+    for (uint32_t sign : {0u, 0x80000000u}) {
+      if (sign != 0 && !negative)
+        break;
+      uint32_t pattern = uint32_t(bits) | sign;
+      float value;
+      memcpy(&value, &pattern, sizeof(value));
+      for (uint8_t decimals = 0; decimals <= FORMAT_FLOAT_FIXED_MAX_DECIMALS + 1; decimals++)
+        ok &= same_as_printf(value, decimals);
+    }
+  }
+  return ok;
+}
+
+static uint32_t bits_of(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+void test_special_values() {
+  for (float value : {0.0f, -0.0f, NAN, -NAN, INFINITY, -INFINITY, 1e-45f, -1e-45f, 3.4028235e38f, 5e14f, 6e14f})
+    for (uint8_t decimals = 0; decimals <= FORMAT_FLOAT_FIXED_MAX_DECIMALS + 1; decimals++)
+      EXPECT_TRUE(same_as_printf(value, decimals));
+}
+
+void test_ties_round_to_even() {
+  // Exactly representable halves: printf rounds them to even, never away from zero
+  for (float value : {0.5f, 1.5f, 2.5f, -2.5f, 0.25f, 0.125f, 0.0625f, 1.03125f, 2.5e-5f})
+    for (uint8_t decimals = 0; decimals <= FORMAT_FLOAT_FIXED_MAX_DECIMALS; decimals++)
+      EXPECT_TRUE(same_as_printf(value, decimals));
+}
+
+void test_truncates_like_printf() {
+  char buf[4];
+  EXPECT_EQ(format_float_fixed_to(buf, sizeof(buf), 123.45f, 2), 3u);
+  EXPECT_EQ(strcmp(buf, "123"), 0);
+  EXPECT_EQ(format_float_fixed_to(buf, 0, 1.0f, 1), 0u);
+}
+
+void test_every_float_of_a_sensor_range() {
+  // Every float in [20, 21), where most room temperatures fall
+  EXPECT_TRUE(sweep(bits_of(20.0f), bits_of(21.0f), 1));
+}
+
+void test_strided_sweep_of_all_floats() {
+  EXPECT_TRUE(sweep(0, 0x80000000u, 65521));
+  EXPECT_TRUE(sweep(0, bits_of(2097152.0f), 4093));
+}
+
+void test_every_float_below_2_pow_21() { EXPECT_TRUE(sweep(0, bits_of(2097152.0f), 1, false)); }
+
+int main(int argc, char **argv) {
+  RUN_TEST(test_special_values);
+  RUN_TEST(test_ties_round_to_even);
+  RUN_TEST(test_truncates_like_printf);
+  RUN_TEST(test_every_float_of_a_sensor_range);
+  RUN_TEST(test_strided_sweep_of_all_floats);
+  if (argc > 1 && strcmp(argv[1], "full") == 0)
+    RUN_TEST(test_every_float_below_2_pow_21);
+  return host_test::failures;
+}
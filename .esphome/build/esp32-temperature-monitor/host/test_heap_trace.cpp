@@ -0,0 +1,101 @@
+// HeapTracer attribution through Application::loop() and the scheduler
+#include "esphome/components/debug/heap_trace.h"
+#include "esphome/core/application.h"
+#include "host_test.h"
+#include <cstdlib>
+
+using namespace esphome;
+using debug::global_heap_tracer;
+using debug::HeapTraceEntry;
+using debug::HeapTracer;
+
+/// Keeps one block per loop() and one per scheduled callback until release()
+class Allocator : public Component {
+ public:
+  void loop() override { this->keep_(this->loop_block_, 100); }
+  void schedule() {
+    this->set_timeout(0, [this]() { this->keep_(this->timeout_block_, 200); });
+  }
+  void release() {
+    free(this->loop_block_);
+    free(this->timeout_block_);
+    this->loop_block_ = this->timeout_block_ = nullptr;
+  }
+
+ protected:
+  void keep_(void *&block, size_t size) {
+    free(block);
+    block = malloc(size);
+  }
+  void *loop_block_{nullptr};
+  void *timeout_block_{nullptr};
+};
+
+static Allocator *allocator;
+// Keeps the compiler from pairing up and eliding the test's own malloc()/free() calls
+static void *volatile escaped;
+
+static HeapTraceEntry entry_for(uint8_t slot) {
+  HeapTraceEntry entries[HeapTracer::MAX_SLOTS];
+  size_t count = global_heap_tracer.snapshot(entries, HeapTracer::MAX_SLOTS);
+  for (size_t i = 0; i < count; i++) {
+    if (entries[i].slot == slot)
+      return entries[i];
+  }
+  return HeapTraceEntry{};
+}
+
+static HeapTraceEntry entry_for(const Component *component) {
+  HeapTraceEntry entries[HeapTracer::MAX_SLOTS];
+  size_t count = global_heap_tracer.snapshot(entries, HeapTracer::MAX_SLOTS);
+  for (size_t i = 0; i < count; i++) {
+    if (entries[i].component == component)
+      return entries[i];
+  }
+  return HeapTraceEntry{};
+}
+
+void test_loop_allocation_is_charged_to_component() {
+  App.loop();
+  EXPECT_TRUE(App.get_current_component() == nullptr);
+  EXPECT_EQ(entry_for(allocator).live_bytes, 100u);
+}
+
+void test_allocation_after_component_lands_in_core() {
+  App.loop();
+  uint32_t core_before = entry_for(HeapTracer::SLOT_CORE).live_bytes;
+  escaped = malloc(64);
+  void *block = escaped;
+  EXPECT_EQ(entry_for(HeapTracer::SLOT_CORE).live_bytes, core_before + 64);
+  EXPECT_EQ(entry_for(allocator).live_bytes, 100u);
+  free(block);
+  EXPECT_EQ(entry_for(HeapTracer::SLOT_CORE).live_bytes, core_before);
+}
+
+void test_allocation_after_scheduled_callback_lands_in_core() {
+  allocator->schedule();
+  App.loop();
+  EXPECT_TRUE(App.get_current_component() == nullptr);
+  EXPECT_EQ(entry_for(allocator).live_bytes, 300u);
+  uint32_t core_before = entry_for(HeapTracer::SLOT_CORE).live_bytes;
+  escaped = malloc(48);
+  void *block = escaped;
+  EXPECT_EQ(entry_for(HeapTracer::SLOT_CORE).live_bytes, core_before + 48);
+  EXPECT_EQ(entry_for(allocator).live_bytes, 300u);
+  free(block);
+  allocator->release();
+  EXPECT_EQ(entry_for(allocator).live_bytes, 0u);
+}
+
+int main() {
+  App.pre_setup("heap-trace", "", false);
+  allocator = new Allocator();
+  App.register_component(allocator);
+  App.setup();
+  global_heap_tracer.start();
+
+  RUN_TEST(test_loop_allocation_is_charged_to_component);
+  RUN_TEST(test_allocation_after_component_lands_in_core);
+  RUN_TEST(test_allocation_after_scheduled_callback_lands_in_core);
+  return host_test::failures;
+}
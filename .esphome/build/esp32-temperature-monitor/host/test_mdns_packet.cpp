@@ -0,0 +1,147 @@
+// MDNSAnswerPacket: legacy unicast replies (RFC 6762 Section 6.7)
+#include "esphome/components/mdns/mdns_packet.h"
+#include "host_test.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::mdns;
+
+static const uint8_t IPV4[4] = {192, 168, 1, 200};
+
+static void build_packet(MDNSAnswerPacket &packet) {
+  StaticVector<MDNSService, MDNS_SERVICE_COUNT> services;
+  auto &api = services.emplace_next();
+  api.service_type = MDNS_STR("_esphomelib");
+  api.proto = MDNS_STR("_tcp");
+  api.port = 6053;
+  api.txt_records.init(2);
+  api.txt_records.push_back({MDNS_STR("version"), MDNS_STR("2026.2.2")});
+  api.txt_records.push_back({MDNS_STR("platform"), MDNS_STR("ESP32")});
+  auto &http = services.emplace_next();
+  http.service_type = MDNS_STR("_http");
+  http.proto = MDNS_STR("_tcp");
+  http.port = 80;
+  packet.build("monitor", IPV4, services);
+}
+
+/// A query for `name` (dotted) from a legacy resolver; the second question reuses the first by pointer.
+static std::vector<uint8_t> make_query(uint16_t id, const char *name, bool second_question) {
+  std::vector<uint8_t> query = {uint8_t(id >> 8), uint8_t(id), 0, 0, 0, uint8_t(second_question ? 2 : 1), 0, 0, 0, 0, 0, 0};
+  std::string labels(name);
+  size_t start = 0;
+  while (start < labels.size()) {
+    size_t dot = labels.find('.', start);
+    if (dot == std::string::npos)
+      dot = labels.size();
+    query.push_back(uint8_t(dot - start));
+    query.insert(query.end(), labels.begin() + start, labels.begin() + dot);
+    start = dot + 1;
+  }
+  query.insert(query.end(), {0, 0, 12, 0, 1});  // QTYPE PTR, QCLASS IN
+  if (second_question)
+    query.insert(query.end(), {0xC0, 12, 0, 16, 0, 1});  // same name, QTYPE TXT
+  return query;
+}
+
+static size_t skip_name(const uint8_t *buf, size_t pos) {
+  while (buf[pos] != 0) {
+    if ((buf[pos] & 0xC0) == 0xC0)
+      return pos + 2;
+    pos += 1 + buf[pos];
+  }
+  return pos + 1;
+}
+
+static std::string decode_name(const uint8_t *buf, size_t len, size_t pos) {
+  std::string name;
+  for (int hops = 0; pos < len && buf[pos] != 0 && hops < 16;) {
+    if ((buf[pos] & 0xC0) == 0xC0) {
+      pos = ((buf[pos] & 0x3F) << 8) | buf[pos + 1];
+      hops++;
+      continue;
+    }
+    if (!name.empty())
+      name += '.';
+    name.append(reinterpret_cast<const char *>(buf + pos + 1), buf[pos]);
+    pos += 1 + buf[pos];
+  }
+  return name;
+}
+
+void test_unicast_reply_echoes_question() {
+  MDNSAnswerPacket packet;
+  build_packet(packet);
+  auto query = make_query(0xBEEF, "_http._tcp.local", true);
+  EXPECT_TRUE(packet.answers_query(query.data(), query.size()));
+
+  uint8_t reply[2048];
+  size_t len = packet.build_unicast_reply(query.data(), query.size(), reply, sizeof(reply));
+  EXPECT_EQ(len, packet.size() + query.size() - 12);
+  EXPECT_EQ(reply[0], 0xBE);
+  EXPECT_EQ(reply[1], 0xEF);
+  EXPECT_EQ(reply[2], 0x84);  // response, authoritative
+  EXPECT_EQ(reply[5], 2);     // both questions echoed
+  EXPECT_EQ(reply[7], packet.data()[7]);
+  EXPECT_TRUE(memcmp(reply + 12, query.data() + 12, query.size() - 12) == 0);
+  // The multicast packet itself is left untouched
+  EXPECT_EQ(packet.data()[0], 0);
+  EXPECT_EQ(packet.data()[1], 0);
+}
+
+void test_unicast_reply_records() {
+  MDNSAnswerPacket packet;
+  build_packet(packet);
+  auto query = make_query(1, "monitor.local", false);
+  uint8_t reply[2048];
+  size_t len = packet.build_unicast_reply(query.data(), query.size(), reply, sizeof(reply));
+  EXPECT_TRUE(len > 0);
+
+  std::vector<std::string> owners, targets;
+  size_t pos = query.size();
+  uint16_t answers = (reply[6] << 8) | reply[7];
+  EXPECT_EQ(answers, 7);
+  for (uint16_t i = 0; i < answers && pos < len; i++) {
+    owners.push_back(decode_name(reply, len, pos));
+    pos = skip_name(reply, pos);
+    uint16_t type = (reply[pos] << 8) | reply[pos + 1];
+    uint16_t rrclass = (reply[pos + 2] << 8) | reply[pos + 3];
+    uint32_t ttl = (uint32_t(reply[pos + 4]) << 24) | (reply[pos + 5] << 16) | (reply[pos + 6] << 8) | reply[pos + 7];
+    uint16_t rdlength = (reply[pos + 8] << 8) | reply[pos + 9];
+    EXPECT_EQ(rrclass, 1);  // cache-flush bit cleared
+    EXPECT_TRUE(ttl > 0 && ttl <= MDNSAnswerPacket::LEGACY_UNICAST_TTL);
+    size_t rdata = pos + 10;
+    if (type == 1)
+      EXPECT_TRUE(memcmp(reply + rdata, IPV4, 4) == 0);
+    if (type == 12)
+      targets.push_back(decode_name(reply, len, rdata));
+    if (type == 33)
+      targets.push_back(decode_name(reply, len, rdata + 6));
+    pos = rdata + rdlength;
+  }
+  EXPECT_EQ(pos, len);
+  EXPECT_TRUE(owners[0] == "monitor.local");
+  EXPECT_TRUE(owners[1] == "_esphomelib._tcp.local");
+  EXPECT_TRUE(owners[2] == "monitor._esphomelib._tcp.local");
+  EXPECT_TRUE(owners[4] == "_http._tcp.local");
+  EXPECT_TRUE(targets[0] == "monitor._esphomelib._tcp.local");
+  EXPECT_TRUE(targets[1] == "monitor.local");
+  EXPECT_TRUE(targets[2] == "monitor._http._tcp.local");
+}
+
+void test_unicast_reply_rejects_truncated_query() {
+  MDNSAnswerPacket packet;
+  build_packet(packet);
+  auto query = make_query(1, "monitor.local", false);
+  uint8_t reply[2048];
+  EXPECT_EQ(packet.build_unicast_reply(query.data(), query.size() - 3, reply, sizeof(reply)), 0);
+  EXPECT_EQ(packet.build_unicast_reply(query.data(), query.size(), reply, packet.size()), 0);
+}
+
+int main() {
+  RUN_TEST(test_unicast_reply_echoes_question);
+  RUN_TEST(test_unicast_reply_records);
+  RUN_TEST(test_unicast_reply_rejects_truncated_query);
+  return host_test::failures;
+}
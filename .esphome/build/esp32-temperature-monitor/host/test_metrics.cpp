@@ -0,0 +1,78 @@
+// PrometheusMetrics: scrapes from one thread while another rewrites the value slots, and values wider than a slot
+#include "esphome/components/web_server/metrics.h"
+#include "esphome/core/application.h"
+#include "host_test.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace esphome;
+using web_server::PrometheusMetrics;
+
+static sensor::Sensor sensors[2];
+
+/// The value of the sample line starting with `metric{id="<id>"`, or NaN if the slot doesn't parse as a number
+static double sample(const char *document, const char *id) {
+  std::string key = std::string("esphome_sensor_value{id=\"") + id + "\"";
+  const char *line = strstr(document, key.c_str());
+  if (line == nullptr)
+    return NAN;
+  const char *value = strchr(line, '}') + 1;
+  char *end;
+  double parsed = strtod(value, &end);
+  return (end == value || *end != '\n') ? NAN : parsed;
+}
+
+void test_scrape_never_sees_a_partial_slot() {
+  PrometheusMetrics metrics;
+  metrics.init(true);
+  sensors[0].state = 5.0f;
+  metrics.update_sensor(&sensors[0]);
+  // Alternate between values of different widths, so a torn slot would be blank, doubled or truncated
+  std::atomic<bool> stop{false};
+  std::thread writer([&]() {
+    for (uint32_t k = 0; !stop; k++) {
+      sensors[0].state = (k & 1) ? 5.0f : 12345.5f;
+      metrics.update_sensor(&sensors[0]);
+    }
+  });
+
+  size_t bad = 0;
+  for (int i = 0; i < 2000000; i++) {
+    double value = sample(metrics.prepare(), "first");
+    if (value != 5.0 && value != 12345.5)
+      bad++;
+  }
+  stop = true;
+  writer.join();
+  EXPECT_EQ(bad, 0u);
+}
+
+void test_wide_values_use_exponent_notation() {
+  PrometheusMetrics metrics;
+  metrics.init(true);
+  sensors[1].state = -3.5e20f;
+  metrics.update_sensor(&sensors[1]);
+  double value = sample(metrics.prepare(), "second");
+  EXPECT_TRUE(std::fabs(value / -3.5e20 - 1) < 1e-7);
+
+  // Ordinary values keep their accuracy decimals
+  sensors[1].state = 21.25f;
+  metrics.update_sensor(&sensors[1]);
+  EXPECT_TRUE(strstr(metrics.prepare(), "{id=\"second\",name=\"second\"}           21.25\n") != nullptr);
+}
+
+int main() {
+  sensors[0].set_name("first");
+  sensors[1].set_name("second");
+  for (auto &sensor : sensors) {
+    sensor.set_accuracy_decimals(2);
+    App.register_sensor(&sensor);
+  }
+  RUN_TEST(test_scrape_never_sees_a_partial_slot);
+  RUN_TEST(test_wide_values_use_exponent_notation);
+  return host_test::failures;
+}
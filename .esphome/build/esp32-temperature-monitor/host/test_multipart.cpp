@@ -0,0 +1,153 @@
+// MultipartReader: upload bodies fed in chunks split at every offset, near-miss delimiters in the content, and CRLF
+// pairs cut by a chunk edge
+#include "esphome/components/web_server_idf/multipart.h"
+#include "host_test.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using esphome::web_server_idf::MultipartReader;
+
+static const char BOUNDARY[] = "----WebKitFormBoundaryX7a";
+
+/// What the reader delivered for one body
+struct Upload {
+  std::string data;
+  std::string filename;
+  int parts_completed{0};
+  bool done{false};
+  size_t consumed{0};
+};
+
+/// A form with a plain field before the file part, so the data callback must skip the first part
+static std::string form_body(const std::string &file) {
+  std::string body = "preamble is ignored\r\n--";
+  body += BOUNDARY;
+  body += "\r\nContent-Disposition: form-data; name=\"note\"\r\n\r\nnot a file\r\n--";
+  body += BOUNDARY;
+  body += " \t\r\nContent-Disposition: form-data; name=\"update\"; filename=\"firmware.bin\"\r\n"
+          "Content-Type: application/octet-stream\r\n\r\n";
+  body += file;
+  body += "\r\n--";
+  body += BOUNDARY;
+  body += "--\r\nepilogue is ignored\r\n";
+  return body;
+}
+
+/// Feeds `body` to a fresh reader in the chunks ending at `cuts`, then the rest
+static Upload upload(const std::string &body, const std::vector<size_t> &cuts) {
+  Upload result;
+  MultipartReader reader(BOUNDARY, strlen(BOUNDARY));
+  reader.set_data_callback([&](const uint8_t *data, size_t len) {
+    result.data.append(reinterpret_cast<const char *>(data), len);
+    result.filename = reader.get_current_part().filename;
+  });
+  reader.set_part_complete_callback([&]() { result.parts_completed++; });
+  size_t start = 0;
+  for (size_t cut : cuts) {
+    result.consumed += reader.parse(body.data() + start, cut - start);
+    start = cut;
+  }
+  result.consumed += reader.parse(body.data() + start, body.size() - start);
+  result.done = reader.is_done();
+  return result;
+}
+
+static bool delivered(const Upload &result, const std::string &body, const std::string &file) {
+  return result.data == file && result.filename == "firmware.bin" && result.parts_completed == 2 && result.done &&
+         result.consumed == body.size();
+}
+
+/// Content that repeatedly starts the delimiter and breaks off at every possible byte, plus bare CRs and LFs
+static std::string near_misses() {
+  const std::string delimiter = std::string("\r\n--") + BOUNDARY;
+  std::string file = "\r";
+  for (size_t len = 1; len < delimiter.size(); len++) {
+    file += delimiter.substr(0, len);
+    file += '!';
+  }
+  // Prefixes running straight into another delimiter start, and one ending right before the real delimiter
+  file += "\r\r\n\r\n-\r\n--\r\n--" + std::string(BOUNDARY, 10) + delimiter.substr(0, delimiter.size() - 1);
+  return file;
+}
+
+void test_every_two_chunk_split() {
+  const std::string file = near_misses();
+  const std::string body = form_body(file);
+  size_t failed = 0;
+  for (size_t cut = 0; cut <= body.size(); cut++)
+    failed += !delivered(upload(body, {cut}), body, file);
+  EXPECT_EQ(failed, 0u);
+}
+
+void test_every_three_chunk_split() {
+  const std::string file = near_misses();
+  const std::string body = form_body(file);
+  size_t failed = 0;
+  for (size_t first = 0; first <= body.size(); first++)
+    for (size_t second = first; second <= body.size(); second++)
+      failed += !delivered(upload(body, {first, second}), body, file);
+  EXPECT_EQ(failed, 0u);
+}
+
+void test_one_byte_at_a_time() {
+  const std::string file = near_misses();
+  const std::string body = form_body(file);
+  std::vector<size_t> cuts;
+  for (size_t i = 1; i < body.size(); i++)
+    cuts.push_back(i);
+  EXPECT_TRUE(delivered(upload(body, cuts), body, file));
+}
+
+void test_random_content_and_chunk_sizes() {
+  // Content drawn mostly from delimiter characters, so partial matches are everywhere
+  const std::string delimiter = std::string("\r\n--") + BOUNDARY;
+  const char alphabet[] = "\r\n-\r\n--WebKitFormBoundaryX7a";
+  std::mt19937 rng(59);
+  size_t failed = 0;
+  for (int round = 0; round < 2000; round++) {
+    std::string file(1 + rng() % 2048, '\0');
+    for (auto &c : file)
+      c = alphabet[rng() % (sizeof(alphabet) - 1)];
+    // A body can't contain its own delimiter; break any accidental one
+    for (size_t at = file.find(delimiter); at != std::string::npos; at = file.find(delimiter, at))
+      file[at + delimiter.size() - 1] = '_';
+    const std::string body = form_body(file);
+    std::vector<size_t> cuts;
+    for (size_t at = rng() % 64; at < body.size(); at += 1 + rng() % 64)
+      cuts.push_back(at);
+    failed += !delivered(upload(body, cuts), body, file);
+  }
+  EXPECT_EQ(failed, 0u);
+}
+
+void test_delimiter_at_start_of_body() {
+  // No preamble: the first delimiter has no leading CRLF
+  std::string body = std::string("--") + BOUNDARY +
+                     "\r\nContent-Disposition: form-data; name=\"update\"; filename=\"a.bin\"\r\n\r\nxyz\r\n--" +
+                     BOUNDARY + "--";
+  for (size_t cut = 0; cut <= body.size(); cut++) {
+    Upload result = upload(body, {cut});
+    EXPECT_EQ(result.data, std::string("xyz"));
+    EXPECT_TRUE(result.done);
+  }
+}
+
+void test_malformed_body_stops_early() {
+  // Garbage after a delimiter where "--" or CRLF belongs
+  std::string body = std::string("--") + BOUNDARY + "x\r\n\r\ncontent";
+  Upload result = upload(body, {});
+  EXPECT_EQ(result.consumed, strlen(BOUNDARY) + 2);
+  EXPECT_TRUE(!result.done);
+}
+
+int main() {
+  RUN_TEST(test_every_two_chunk_split);
+  RUN_TEST(test_every_three_chunk_split);
+  RUN_TEST(test_one_byte_at_a_time);
+  RUN_TEST(test_random_content_and_chunk_sizes);
+  RUN_TEST(test_delimiter_at_start_of_body);
+  RUN_TEST(test_malformed_body_stops_early);
+  return host_test::failures;
+}
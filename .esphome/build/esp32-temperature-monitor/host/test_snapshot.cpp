@@ -0,0 +1,61 @@
+// SensorSnapshot served from one thread while another patches it, as the httpd task and the main loop do
+#include "esphome/components/web_server/snapshot.h"
+#include "esphome/core/application.h"
+#include "host_test.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace esphome;
+using web_server::SensorSnapshot;
+
+static sensor::Sensor sensors[2];
+
+static uint32_t get_u32_le(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | uint32_t(p[3]) << 24; }
+
+static float get_f32_le(const uint8_t *p) {
+  uint32_t bits = get_u32_le(p);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void test_copy_matches_its_sequence() {
+  SensorSnapshot snapshot;
+  snapshot.init(true);
+  EXPECT_EQ(snapshot.size(), SensorSnapshot::HEADER_SIZE + 2 * SensorSnapshot::RECORD_SIZE);
+
+  // Round k sets both sensors to k, one after the other, so the sequence pins down both values:
+  // sequence 2k means both hold k, 2k - 1 means the first holds k and the second k - 1
+  std::atomic<bool> stop{false};
+  std::thread writer([&]() {
+    for (uint32_t k = 1; !stop; k++) {
+      for (auto &sensor : sensors) {
+        sensor.state = float(k);
+        snapshot.update_sensor(&sensor);
+      }
+    }
+  });
+
+  size_t inconsistent = 0;
+  for (int i = 0; i < 200000; i++) {
+    const uint8_t *data = snapshot.prepare();
+    uint32_t sequence = get_u32_le(data + 12);
+    float first = get_f32_le(data + SensorSnapshot::HEADER_SIZE + 4);
+    float second = get_f32_le(data + SensorSnapshot::HEADER_SIZE + SensorSnapshot::RECORD_SIZE + 4);
+    if (sequence != 0 && (first != float((sequence + 1) / 2) || second != float(sequence / 2)))
+      inconsistent++;
+  }
+  stop = true;
+  writer.join();
+  EXPECT_EQ(inconsistent, 0u);
+}
+
+int main() {
+  for (auto &sensor : sensors) {
+    sensor.set_name("sensor");
+    App.register_sensor(&sensor);
+  }
+  RUN_TEST(test_copy_matches_its_sequence);
+  return host_test::failures;
+}
@@ -0,0 +1,247 @@
+// APIServer::StateEncodeCache: several clients handed the same sensor states, during a controller flush and during a
+// loop pass in which one client's message publishes a sensor the others already encoded
+#include "esphome/components/api/api_connection.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+#include "esphome/core/controller_registry.h"
+#include "host_test.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using api::APIConnection;
+
+static constexpr uint8_t HELLO_REQUEST = 1;
+static constexpr uint8_t SUBSCRIBE_STATES_REQUEST = 20;
+static constexpr uint8_t SENSOR_STATE_RESPONSE = 25;
+static constexpr uint8_t HOME_ASSISTANT_STATE_RESPONSE = 40;
+static constexpr size_t CLIENTS = 3;
+
+/// A connected client socket: reads what the test queued in rx, accepts writes only while the TX window has room
+class FakeSocket : public socket::Socket {
+ public:
+  std::vector<uint8_t> rx;
+  std::vector<uint8_t> tx;
+  size_t window{SIZE_MAX};
+
+  ssize_t read(void *buf, size_t len) override {
+    if (this->rx.empty()) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    len = std::min(len, this->rx.size());
+    memcpy(buf, this->rx.data(), len);
+    this->rx.erase(this->rx.begin(), this->rx.begin() + len);
+    return len;
+  }
+  ssize_t readv(const struct iovec *iov, int iovcnt) override { return this->read(iov[0].iov_base, iov[0].iov_len); }
+  ssize_t write(const void *buf, size_t len) override {
+    struct iovec iov = {const_cast<void *>(buf), len};
+    return this->writev(&iov, 1);
+  }
+  ssize_t writev(const struct iovec *iov, int iovcnt) override {
+    if (this->window == 0) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    size_t written = 0;
+    for (int i = 0; i < iovcnt && this->window > 0; i++) {
+      size_t n = std::min(iov[i].iov_len, this->window);
+      auto *data = static_cast<const uint8_t *>(iov[i].iov_base);
+      this->tx.insert(this->tx.end(), data, data + n);
+      this->window -= n;
+      written += n;
+    }
+    return written;
+  }
+  int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
+    auto *in = reinterpret_cast<struct sockaddr_in *>(addr);
+    memset(in, 0, sizeof(*in));
+    in->sin_family = AF_INET;
+    in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    *addrlen = sizeof(*in);
+    return 0;
+  }
+  int getsockname(struct sockaddr *addr, socklen_t *addrlen) override { return this->getpeername(addr, addrlen); }
+  int setsockopt(int level, int optname, const void *optval, socklen_t optlen) override { return 0; }
+  int getsockopt(int level, int optname, void *optval, socklen_t *optlen) override { return 0; }
+  int setblocking(bool blocking) override { return 0; }
+  int close() override { return 0; }
+  int shutdown(int how) override { return 0; }
+  std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) override { return nullptr; }
+  int bind(const struct sockaddr *addr, socklen_t addrlen) override { return -1; }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return -1; }
+  int listen(int backlog) override { return -1; }
+  ssize_t recvfrom(void *buf, size_t len, sockaddr *addr, socklen_t *addr_len) override { return -1; }
+  ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) override {
+    return -1;
+  }
+};
+
+struct Frame {
+  uint8_t type;
+  std::vector<uint8_t> payload;
+};
+
+static void put_varint(std::vector<uint8_t> &out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+static uint32_t get_varint(const std::vector<uint8_t> &in, size_t &pos) {
+  uint32_t value = 0;
+  for (uint8_t shift = 0; pos < in.size(); shift += 7) {
+    uint8_t b = in[pos++];
+    value |= uint32_t(b & 0x7F) << shift;
+    if ((b & 0x80) == 0)
+      break;
+  }
+  return value;
+}
+
+static void put_frame(std::vector<uint8_t> &out, uint8_t type, const std::vector<uint8_t> &payload) {
+  out.push_back(0x00);
+  put_varint(out, payload.size());
+  put_varint(out, type);
+  out.insert(out.end(), payload.begin(), payload.end());
+}
+
+/// Splits everything the device wrote into plaintext frames; a truncated tail is left out
+static std::vector<Frame> parse_frames(const std::vector<uint8_t> &tx) {
+  std::vector<Frame> frames;
+  size_t pos = 0;
+  while (pos < tx.size() && tx[pos] == 0x00) {
+    pos++;
+    uint32_t len = get_varint(tx, pos);
+    uint8_t type = get_varint(tx, pos);
+    if (pos + len > tx.size())
+      break;
+    frames.push_back({type, std::vector<uint8_t>(tx.begin() + pos, tx.begin() + pos + len)});
+    pos += len;
+  }
+  return frames;
+}
+
+/// Adds connections the way accept_new_connections_() does, without a listening socket
+class TestServer : public api::APIServer {
+ public:
+  void add_client(std::unique_ptr<socket::Socket> sock) {
+    auto *conn = new APIConnection(std::move(sock), this);
+    this->clients_.emplace_back(conn);
+    conn->start();
+  }
+};
+
+static TestServer *server;
+static sensor::Sensor sensors[2];
+static FakeSocket *socks[CLIENTS];
+
+/// The sensor state frames a client was sent since the last call, as raw payloads
+static std::vector<std::vector<uint8_t>> take_states(FakeSocket *sock) {
+  std::vector<std::vector<uint8_t>> states;
+  for (auto &frame : parse_frames(sock->tx)) {
+    if (frame.type == SENSOR_STATE_RESPONSE)
+      states.push_back(frame.payload);
+  }
+  sock->tx.clear();
+  return states;
+}
+
+/// The float state (field 2) of a SensorStateResponse
+static float state_of(const std::vector<uint8_t> &payload) {
+  for (size_t pos = 0; pos + 5 <= payload.size(); pos++) {
+    if (payload[pos] == 0x15) {
+      float value;
+      memcpy(&value, &payload[pos + 1], 4);
+      return value;
+    }
+  }
+  return -1.0f;
+}
+
+void test_frames_identical_across_clients() {
+  // Every client subscribes in the same pass; client 1's first message is a Home Assistant state push whose
+  // subscription publishes sensor 0. Client 0 has already encoded sensor 0 in that pass by then.
+  std::vector<uint8_t> push = {0x0A, 12};
+  for (char c : std::string("sensor.house"))
+    push.push_back(c);
+  push.insert(push.end(), {0x12, 3, '2', '5', '0'});
+  put_frame(socks[1]->rx, HOME_ASSISTANT_STATE_RESPONSE, push);
+  for (auto *sock : socks)
+    put_frame(sock->rx, SUBSCRIBE_STATES_REQUEST, {});
+  server->loop();
+
+  std::vector<std::vector<uint8_t>> initial[CLIENTS];
+  for (size_t i = 0; i < CLIENTS; i++)
+    initial[i] = take_states(socks[i]);
+  EXPECT_EQ(initial[0].size(), 2u);
+  if (initial[0].size() != 2)
+    return;
+  EXPECT_EQ(state_of(initial[0][0]), 1.0f);
+  // Clients 1 and 2 encoded sensor 0 after the publish, so neither may be handed client 0's frame
+  EXPECT_EQ(state_of(initial[1][0]), 250.0f);
+  EXPECT_TRUE(initial[1] == initial[2]);
+  EXPECT_TRUE(initial[0][1] == initial[1][1]);
+
+  // The flush at the end of the loop iteration delivers the new state to every client, byte for byte the same
+  server->loop();
+  ControllerRegistry::flush();
+  server->loop();
+  std::vector<std::vector<uint8_t>> flushed[CLIENTS];
+  for (size_t i = 0; i < CLIENTS; i++)
+    flushed[i] = take_states(socks[i]);
+  EXPECT_EQ(flushed[0].size(), 1u);
+  if (flushed[0].size() != 1)
+    return;
+  EXPECT_EQ(state_of(flushed[0][0]), 250.0f);
+  EXPECT_TRUE(flushed[0] == flushed[1]);
+  EXPECT_TRUE(flushed[0] == flushed[2]);
+
+  // Two states changing within one iteration reach every client identically too
+  sensors[0].publish_state(3.0f);
+  sensors[1].publish_state(4.0f);
+  ControllerRegistry::flush();
+  server->loop();
+  for (size_t i = 0; i < CLIENTS; i++)
+    flushed[i] = take_states(socks[i]);
+  EXPECT_EQ(flushed[0].size(), 2u);
+  EXPECT_TRUE(flushed[0] == flushed[1]);
+  EXPECT_TRUE(flushed[0] == flushed[2]);
+}
+
+int main() {
+  for (int i = 0; i < 2; i++) {
+    sensors[i].set_name(i == 0 ? "House power" : "House energy", i + 1);
+    App.register_sensor(&sensors[i]);
+  }
+  sensors[0].publish_state(1.0f);
+  sensors[1].publish_state(2.0f);
+
+  server = new TestServer();
+  // Immediate sends, as with batch_delay: 0, so nothing waits on the loop time
+  server->set_batch_delay(0);
+  ControllerRegistry::register_controller(server);
+  server->subscribe_home_assistant_state("sensor.house", nullptr,
+                                         [](StringRef state) { sensors[0].publish_state(atof(state.c_str())); });
+  for (auto *&sock : socks) {
+    auto owned = std::make_unique<FakeSocket>();
+    sock = owned.get();
+    std::vector<uint8_t> hello = {0x0A, 4, 't', 'e', 's', 't', 0x10, 1, 0x18, 14};
+    put_frame(sock->rx, HELLO_REQUEST, hello);
+    server->add_client(std::move(owned));
+  }
+  server->loop();
+  for (auto *sock : socks)
+    sock->tx.clear();
+
+  RUN_TEST(test_frames_identical_across_clients);
+  return host_test::failures;
+}
@@ -0,0 +1,99 @@
+// Heap allocations and time per TextSensor::publish_state() through a filter chain:
+//  - to_lower -> substitute -> map -> prepend -> append, edited in place in the sensor's FilterBuffer
+//  - the same steps as std::string lambda filters, the by-value path every filter used to take
+//  - a value longer than the inline buffer, which moves the FilterBuffer to the heap once and stays there
+#include "esphome/components/text_sensor/text_sensor.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace esphome;
+using namespace esphome::text_sensor;
+
+static const int ROUNDS = 200000;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t size) noexcept { operator delete(p); }
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Publishes `values` round-robin and prints allocations and ns per publish; returns false if the state is wrong
+static bool run(const char *name, TextSensor &sensor, const std::string *values, size_t count,
+                const std::string &expected_last) {
+  // The first round may size buffers; only the steady state counts
+  for (size_t i = 0; i < count; i++)
+    sensor.publish_state(values[i]);
+  size_t before = allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; i++)
+    sensor.publish_state(values[i % count]);
+  double seconds = seconds_since(start);
+  printf("%-16s %5.2f allocations  %6.1f ns per publish\n", name, double(allocations - before) / ROUNDS,
+         seconds * 1e9 / ROUNDS);
+  if (sensor.get_state() != expected_last) {
+    printf("unexpected state \"%s\"\n", sensor.get_state().c_str());
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  // Alternating states, so every publish changes the value; all longer than std::string's inline capacity
+  static const std::string STATES[2] = {"Heating_Stage_1_Auxiliary", "Idle_Waiting_For_Demand"};
+  const size_t last = (ROUNDS - 1) % 2;
+
+  TextSensor in_place;
+  in_place.set_name("in place");
+  in_place.add_filters({new ToLowerFilter(), new SubstituteFilter({{"_", " "}}),
+                        new MapFilter({{"idle waiting for demand", "standby"},
+                                       {"heating stage 1 auxiliary", "auxiliary heat"}}),
+                        new PrependFilter("mode: "), new AppendFilter(".")});
+  bool ok = run("in place", in_place, STATES, 2, last == 0 ? "mode: auxiliary heat." : "mode: standby.");
+
+  // The same five steps as lambdas: each one takes and returns the value by std::string
+  TextSensor by_value;
+  by_value.set_name("by value");
+  by_value.add_filters({
+      new LambdaFilter([](std::string value) -> optional<std::string> {
+        for (auto &c : value)
+          c = ::tolower(c);
+        return value;
+      }),
+      new LambdaFilter([](std::string value) -> optional<std::string> {
+        for (auto &c : value)
+          c = c == '_' ? ' ' : c;
+        return value;
+      }),
+      new LambdaFilter([](std::string value) -> optional<std::string> {
+        if (value == "idle waiting for demand")
+          return std::string("standby");
+        if (value == "heating stage 1 auxiliary")
+          return std::string("auxiliary heat");
+        return value;
+      }),
+      new LambdaFilter([](std::string value) -> optional<std::string> { return "mode: " + value; }),
+      new LambdaFilter([](std::string value) -> optional<std::string> { return value + "."; }),
+  });
+  ok &= run("by value", by_value, STATES, 2, last == 0 ? "mode: auxiliary heat." : "mode: standby.");
+
+  static const std::string LONG_STATES[2] = {std::string(600, 'a'), std::string(601, 'b')};
+  TextSensor long_values;
+  long_values.set_name("long values");
+  long_values.add_filters({new ToUpperFilter(), new AppendFilter("!")});
+  ok &= run("over inline size", long_values, LONG_STATES, 2,
+            std::string(last == 0 ? 600 : 601, last == 0 ? 'A' : 'B') + "!");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+// Clock text rendered once per second over a day, in ns per tick: ESPTimeFormatter::update() against a full
+// strftime_to() on every tick, which the display lambda did before, for the formats a clock display uses. Checks that
+// both produce the same text on every tick.
+#include "esphome/core/time.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace esphome;
+
+static const time_t START = 1767225600;  // 2026-01-01 00:00:00 UTC
+static const int TICKS = 86400;
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  // Broken-down times are computed up front: the display gets them from the time component either way
+  std::vector<ESPTime> ticks;
+  ticks.reserve(TICKS);
+  for (int i = 0; i < TICKS; i++)
+    ticks.push_back(ESPTime::from_epoch_utc(START + i));
+
+  for (const char *format : {"%H:%M:%S", "%H:%M", "%Y-%m-%d"}) {
+    char full[ESPTime::STRFTIME_BUFFER_SIZE];
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &tick : ticks)
+      checksum += tick.strftime_to(full, format) + full[0];
+    double full_s = seconds_since(start);
+
+    ESPTimeFormatter formatter(format);
+    size_t redraws = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto &tick : ticks)
+      redraws += formatter.update(tick);
+    double cached_s = seconds_since(start);
+
+    printf("%-9s strftime %6.1f ns  formatter %6.1f ns  (%zu of %d ticks changed the text)\n", format,
+           full_s * 1e9 / TICKS, cached_s * 1e9 / TICKS, redraws, TICKS);
+
+    ESPTimeFormatter check(format);
+    for (auto &tick : ticks) {
+      check.update(tick);
+      tick.strftime_to(full, format);
+      if (strcmp(check.c_str(), full) != 0) {
+        printf("mismatch at %lld: \"%s\", strftime gives \"%s\"\n", (long long) tick.timestamp, check.c_str(), full);
+        return 1;
+      }
+    }
+    (void) checksum;
+  }
+  return 0;
+}
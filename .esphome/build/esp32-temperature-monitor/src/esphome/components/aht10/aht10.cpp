@@ -41,8 +41,12 @@ void AHT10Component::setup() {
   if (this->write(AHT10_SOFTRESET_CMD, sizeof(AHT10_SOFTRESET_CMD)) != i2c::ERROR_OK) {
     ESP_LOGE(TAG, "Reset failed");
   }
-  delay(AHT10_SOFTRESET_DELAY);
+  // Reset and calibration waits run from the scheduler so the rest of the setup is not held up
+  this->begin_async_setup_();
+  this->set_timeout(AHT10_SOFTRESET_DELAY, [this]() { this->initialize_(); });
+}
 
+void AHT10Component::initialize_() {
   i2c::ErrorCode error_code = i2c::ERROR_INVALID_ARGUMENT;
   switch (this->variant_) {
     case AHT10Variant::AHT20:
@@ -57,27 +61,32 @@ void AHT10Component::setup() {
     this->mark_failed();
     return;
   }
-  uint8_t cal_attempts = 0;
-  uint8_t data = AHT10_STATUS_BUSY;
-  while (data & AHT10_STATUS_BUSY) {
-    delay(AHT10_DEFAULT_DELAY);
-    if (this->read(&data, 1) != i2c::ERROR_OK) {
-      ESP_LOGE(TAG, ESP_LOG_MSG_COMM_FAIL);
-      this->mark_failed();
-      return;
-    }
-    ++cal_attempts;
-    if (cal_attempts > AHT10_INIT_ATTEMPTS) {
+  this->init_attempts_ = 0;
+  this->set_timeout(AHT10_DEFAULT_DELAY, [this]() { this->check_calibration_(); });
+}
+
+void AHT10Component::check_calibration_() {
+  uint8_t data;
+  if (this->read(&data, 1) != i2c::ERROR_OK) {
+    ESP_LOGE(TAG, ESP_LOG_MSG_COMM_FAIL);
+    this->mark_failed();
+    return;
+  }
+  if (data & AHT10_STATUS_BUSY) {
+    if (++this->init_attempts_ >= AHT10_INIT_ATTEMPTS) {
       ESP_LOGE(TAG, "Initialization timed out");
       this->mark_failed();
       return;
     }
+    this->set_timeout(AHT10_DEFAULT_DELAY, [this]() { this->check_calibration_(); });
+    return;
   }
   if ((data & 0x68) != 0x08) {  // Bit[6:5] = 0b00, NORMAL mode and Bit[3] = 0b1, CALIBRATED
     ESP_LOGE(TAG, "Initialization failed");
     this->mark_failed();
     return;
   }
+  this->finish_async_setup_();
 }
 
 void AHT10Component::restart_read_() {
@@ -140,7 +149,7 @@ void AHT10Component::read_data_() {
   this->read_count_ = 0;
 }
 void AHT10Component::update() {
-  if (this->read_count_ != 0)
+  if (this->read_count_ != 0 || !this->is_setup_finished())
     return;
   this->start_time_ = millis();
   if (this->write(AHT10_MEASURE_CMD, sizeof(AHT10_MEASURE_CMD)) != i2c::ERROR_OK) {
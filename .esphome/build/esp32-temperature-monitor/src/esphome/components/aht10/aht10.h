@@ -26,6 +26,9 @@ class AHT10Component : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *humidity_sensor_{nullptr};
   AHT10Variant variant_{};
   unsigned read_count_{};
+  uint8_t init_attempts_{};
+  void initialize_();
+  void check_calibration_();
   void read_data_();
   void restart_read_();
   uint32_t start_time_{};
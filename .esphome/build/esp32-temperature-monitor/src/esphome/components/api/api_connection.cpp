@@ -23,6 +23,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 #include "esphome/core/version.h"
 
 #ifdef USE_DEEP_SLEEP
@@ -101,6 +102,10 @@ static const int CAMERA_STOP_STREAM = 5000;
 #endif  // USE_DEVICES
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent) : parent_(parent) {
+#ifdef USE_TRACE_RECORDER
+  static uint8_t next_trace_id = 0;
+  this->trace_id_ = next_trace_id++;
+#endif
 #if defined(USE_API_PLAINTEXT) && defined(USE_API_NOISE)
   auto &noise_ctx = parent->get_noise_ctx();
   if (noise_ctx.has_psk()) {
@@ -286,15 +291,21 @@ void APIConnection::process_active_iterator_() {
 }
 
 void APIConnection::process_iterator_batch_(ComponentIterator &iterator) {
-  size_t initial_size = this->deferred_batch_.size();
+  // Flow control: only pull entities while the socket can take another batch. While the TX queue
+  // still holds data the iterator stays paused at its current entity and resumes from exactly there
+  // on a later loop, so a slow reader never makes us queue more than one batch ahead.
+  if (!this->try_to_clear_buffer(false))
+    return;
+
+  // Items left over from a partially sent batch (or pending state updates) count against the window
   size_t max_batch = this->get_max_batch_size_();
-  while (!iterator.completed() && (this->deferred_batch_.size() - initial_size) < max_batch) {
+  while (!iterator.completed() && this->deferred_batch_.size() < max_batch) {
     iterator.advance();
   }
 
-  // If the batch is full, process it immediately
+  // The socket is writable, so encode the window straight out instead of waiting for the batch delay
   // Note: iterator.advance() already calls schedule_batch_() via schedule_message_()
-  if (this->deferred_batch_.size() >= max_batch) {
+  if (!this->deferred_batch_.empty()) {
     this->process_batch_();
   }
 }
@@ -373,6 +384,59 @@ uint16_t APIConnection::encode_message_to_buffer(ProtoMessage &msg, uint8_t mess
   return static_cast<uint16_t>(actual_total_size);
 }
 
+uint16_t APIConnection::encode_state_to_buffer(EntityBase *entity, ProtoMessage &msg, uint8_t message_type,
+                                               APIConnection *conn, uint32_t remaining_size) {
+  auto &cache = conn->parent_->get_state_encode_cache();
+  bool cacheable = cache.is_enabled();
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  cacheable = cacheable && !conn->flags_.log_only_mode;
+#endif
+#ifdef USE_EVENT
+  // Events of one entity differ by event_type, so (entity, message_type) does not identify the payload
+  cacheable = cacheable && message_type != EventResponse::MESSAGE_TYPE;
+#endif
+  // Published and not flushed yet, e.g. by an earlier client message in this pass: an entry may hold the old state
+  cacheable = cacheable && !entity->is_controller_pending();
+  if (!cacheable)
+    return encode_message_to_buffer(msg, message_type, conn, remaining_size);
+
+  auto cached = cache.find(entity, message_type);
+  if (!cached.empty())
+    return append_payload_to_buffer(cached, conn, remaining_size);
+
+  uint16_t total_size = encode_message_to_buffer(msg, message_type, conn, remaining_size);
+  if (total_size != 0) {
+    // The payload is the tail of the shared buffer: everything after this message's header padding
+    auto &shared_buf = conn->parent_->get_shared_buffer_ref();
+    uint16_t payload_size = total_size - conn->helper_->frame_header_padding() - conn->helper_->frame_footer_size();
+    cache.store(entity, message_type, shared_buf.data() + shared_buf.size() - payload_size, payload_size);
+  }
+  return total_size;
+}
+
+uint16_t APIConnection::append_payload_to_buffer(std::span<const uint8_t> payload, APIConnection *conn,
+                                                 uint32_t remaining_size) {
+  const uint8_t header_padding = conn->helper_->frame_header_padding();
+  const uint8_t footer_size = conn->helper_->frame_footer_size();
+  size_t total_size = payload.size() + header_padding + footer_size;
+  if (total_size > remaining_size) {
+    return 0;  // Doesn't fit
+  }
+
+  std::vector<uint8_t> &shared_buf = conn->parent_->get_shared_buffer_ref();
+  if (conn->flags_.batch_first_message) {
+    // First message - buffer already prepared by caller, just clear flag
+    conn->flags_.batch_first_message = false;
+  } else {
+    // Add padding for previous message footer + this message header
+    size_t current_size = shared_buf.size();
+    shared_buf.reserve(current_size + total_size);
+    shared_buf.resize(current_size + footer_size + header_padding);
+  }
+  shared_buf.insert(shared_buf.end(), payload.begin(), payload.end());
+  return static_cast<uint16_t>(total_size);
+}
+
 #ifdef USE_BINARY_SENSOR
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor) {
   return this->send_message_smart_(binary_sensor, BinarySensorStateResponse::MESSAGE_TYPE,
@@ -1681,33 +1745,7 @@ void APIConnection::on_home_assistant_state_response(const HomeAssistantStateRes
     return;
   }
 
-  for (auto &it : this->parent_->get_state_subs()) {
-    // Compare entity_id: check length matches and content matches
-    size_t entity_id_len = strlen(it.entity_id);
-    if (entity_id_len != msg.entity_id.size() ||
-        memcmp(it.entity_id, msg.entity_id.c_str(), msg.entity_id.size()) != 0) {
-      continue;
-    }
-
-    // Compare attribute: either both have matching attribute, or both have none
-    size_t sub_attr_len = it.attribute != nullptr ? strlen(it.attribute) : 0;
-    if (sub_attr_len != msg.attribute.size() ||
-        (sub_attr_len > 0 && memcmp(it.attribute, msg.attribute.c_str(), sub_attr_len) != 0)) {
-      continue;
-    }
-
-    // Create null-terminated state for callback (parse_number needs null-termination)
-    // HA state max length is 255 characters, but attributes can be much longer
-    // Use stack buffer for common case (states), heap fallback for large attributes
-    size_t state_len = msg.state.size();
-    SmallBufferWithHeapFallback<MAX_STATE_LEN + 1> state_buf_alloc(state_len + 1);
-    char *state_buf = reinterpret_cast<char *>(state_buf_alloc.get());
-    if (state_len > 0) {
-      memcpy(state_buf, msg.state.c_str(), state_len);
-    }
-    state_buf[state_len] = '\0';
-    it.callback(StringRef(state_buf, state_len));
-  }
+  this->parent_->dispatch_home_assistant_state(msg.entity_id, msg.attribute, msg.state);
 }
 #endif
 #ifdef USE_API_USER_DEFINED_ACTIONS
@@ -1850,6 +1888,9 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint8_t message_type) {
     this->fatal_error_with_log_(LOG_STR("Packet write failed"), err);
     return false;
   }
+  // Connections come and go and each traced source is interned for good, so they are traced under the server
+  ESPHOME_TRACE(API_SEND, this->parent_, "api", ESPHOME_TRACE_NOW(), message_type | this->trace_id_ << 8,
+                buffer.get_buffer()->size());
   // Do not set last_traffic_ on send
   return true;
 }
@@ -2039,6 +2080,15 @@ void APIConnection::process_batch_multi_(std::vector<uint8_t> &shared_buf, size_
     if (err != APIError::OK && err != APIError::WOULD_BLOCK) {
       this->fatal_error_with_log_(LOG_STR("Batch write failed"), err);
     }
+#ifdef USE_TRACE_RECORDER
+    if (err == APIError::OK) {
+      const uint32_t trace_now = ESPHOME_TRACE_NOW();
+      for (size_t i = 0; i < items_processed; i++) {
+        ESPHOME_TRACE(API_SEND, this->parent_, "api", trace_now, message_info[i].message_type | this->trace_id_ << 8,
+                      message_info[i].payload_size);
+      }
+    }
+#endif
 
 #ifdef HAS_PROTO_MESSAGE_DUMP
     // Log messages after send attempt for VV debugging
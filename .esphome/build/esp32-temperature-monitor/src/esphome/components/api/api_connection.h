@@ -315,6 +315,12 @@ class APIConnection final : public APIServerConnectionBase {
   // Non-template helper to encode any ProtoMessage
   static uint16_t encode_message_to_buffer(ProtoMessage &msg, uint8_t message_type, APIConnection *conn,
                                            uint32_t remaining_size);
+  // Encode a state message, reusing the payload another connection already encoded during this fan-out
+  static uint16_t encode_state_to_buffer(EntityBase *entity, ProtoMessage &msg, uint8_t message_type,
+                                         APIConnection *conn, uint32_t remaining_size);
+  // Append an already encoded payload to the shared buffer with this connection's framing padding
+  static uint16_t append_payload_to_buffer(std::span<const uint8_t> payload, APIConnection *conn,
+                                           uint32_t remaining_size);
 
   // Helper to fill entity state base and encode message
   static uint16_t fill_and_encode_entity_state(EntityBase *entity, StateResponseProtoMessage &msg, uint8_t message_type,
@@ -323,7 +329,7 @@ class APIConnection final : public APIServerConnectionBase {
 #ifdef USE_DEVICES
     msg.device_id = entity->get_device_id();
 #endif
-    return encode_message_to_buffer(msg, message_type, conn, remaining_size);
+    return encode_state_to_buffer(entity, msg, message_type, conn, remaining_size);
   }
 
   // Helper to fill entity info base and encode message
@@ -375,6 +381,7 @@ class APIConnection final : public APIServerConnectionBase {
   void __attribute__((noinline)) process_active_iterator_();
 
   // Helper method to process multiple entities from an iterator in a batch.
+  // Only advances while the socket is writable, so at most one batch is encoded ahead of the reader.
   // Takes ComponentIterator base class reference to avoid duplicate template instantiations.
   void process_iterator_batch_(ComponentIterator &iterator);
 
@@ -603,7 +610,13 @@ class APIConnection final : public APIServerConnectionBase {
   uint16_t client_api_version_minor_{0};
   // 1-byte type to fill padding
   ActiveIterator active_iterator_{ActiveIterator::NONE};
+#ifdef USE_TRACE_RECORDER
+  // Numbers this connection in API_SEND trace records, which are all under the server's source
+  uint8_t trace_id_;
+  // Total: 2 (flags) + 2 + 2 + 1 + 1 = 8 bytes, no padding
+#else
   // Total: 2 (flags) + 2 + 2 + 1 = 7 bytes, then 1 byte padding to next 4-byte boundary
+#endif
 
   uint32_t get_batch_delay_ms_() const;
   // Message will use 8 more bytes than the minimum size, and typical
@@ -0,0 +1,233 @@
+#include "api_frame_helper_plaintext.h"
+#ifdef USE_API
+#ifdef USE_API_PLAINTEXT
+#include "api_connection.h"  // For ClientInfo struct
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "proto.h"
+#include <cstring>
+#include <cinttypes>
+
+namespace esphome::api {
+
+static const char *const TAG = "api.plaintext";
+
+// Maximum bytes to log in hex format (168 * 3 = 504, under TX buffer size of 512)
+static constexpr size_t API_MAX_LOG_BYTES = 168;
+
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
+#define HELPER_LOG(msg, ...) \
+  do { \
+    char peername_buf[socket::SOCKADDR_STR_LEN]; \
+    this->get_peername_to(peername_buf); \
+    ESP_LOGVV(TAG, "%s (%s): " msg, this->client_name_, peername_buf, ##__VA_ARGS__); \
+  } while (0)
+#else
+#define HELPER_LOG(msg, ...) ((void) 0)
+#endif
+
+#ifdef HELPER_LOG_PACKETS
+#define LOG_PACKET_RECEIVED(buffer) \
+  do { \
+    char hex_buf_[format_hex_pretty_size(API_MAX_LOG_BYTES)]; \
+    ESP_LOGVV(TAG, "Received frame: %s", \
+              format_hex_pretty_to(hex_buf_, (buffer).data(), \
+                                   (buffer).size() < API_MAX_LOG_BYTES ? (buffer).size() : API_MAX_LOG_BYTES)); \
+  } while (0)
+#else
+#define LOG_PACKET_RECEIVED(buffer) ((void) 0)
+#endif
+
+/// Initialize the frame helper, returns OK if successful.
+APIError APIPlaintextFrameHelper::init() {
+  APIError err = init_common_();
+  if (err != APIError::OK) {
+    return err;
+  }
+
+  state_ = State::DATA;
+  return APIError::OK;
+}
+
+APIError APIPlaintextFrameHelper::loop() {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+  // Use base class implementation for buffer sending
+  return APIFrameHelper::loop();
+}
+
+/** Read a packet into the rx_buf_.
+ *
+ * @return APIError::OK if a full packet is in rx_buf_
+ *
+ * errno EWOULDBLOCK: Packet could not be read without blocking. Try again later.
+ * errno ENOMEM: Not enough memory for reading packet.
+ * errno API_ERROR_BAD_INDICATOR: Bad indicator byte at start of frame.
+ * errno API_ERROR_BAD_DATA_PACKET: Header malformed or message too big.
+ */
+APIError APIPlaintextFrameHelper::try_read_frame_() {
+  // read header: indicator + size varint + type varint, one byte at a time since
+  // the varint lengths aren't known up front
+  while (!rx_header_parsed_) {
+    uint8_t data;
+    ssize_t received = this->socket_->read(&data, 1);
+    APIError err = handle_socket_read_result_(received);
+    if (err != APIError::OK) {
+      return err;
+    }
+
+    if (rx_header_buf_pos_ == 0 && data != 0x00) {
+      state_ = State::FAILED;
+      HELPER_LOG("Bad indicator byte %u", data);
+      return APIError::BAD_INDICATOR;
+    }
+    if (rx_header_buf_pos_ == sizeof(rx_header_buf_)) {
+      state_ = State::FAILED;
+      HELPER_LOG("Header buffer overflow");
+      return APIError::BAD_DATA_PACKET;
+    }
+    rx_header_buf_[rx_header_buf_pos_++] = data;
+    if (rx_header_buf_pos_ == 1) {
+      // only the indicator so far
+      continue;
+    }
+
+    uint32_t consumed = 0;
+    auto msg_size_varint = ProtoVarInt::parse(&rx_header_buf_[1], rx_header_buf_pos_ - 1, &consumed);
+    if (!msg_size_varint.has_value()) {
+      // size varint not complete yet
+      continue;
+    }
+    if (msg_size_varint->as_uint32() > MAX_MESSAGE_SIZE) {
+      state_ = State::FAILED;
+      HELPER_LOG("Bad packet: message size %" PRIu32 " exceeds maximum %u", msg_size_varint->as_uint32(),
+                 MAX_MESSAGE_SIZE);
+      return APIError::BAD_DATA_PACKET;
+    }
+    rx_header_parsed_len_ = msg_size_varint->as_uint16();
+
+    uint32_t type_offset = 1 + consumed;
+    auto msg_type_varint =
+        ProtoVarInt::parse(&rx_header_buf_[type_offset], rx_header_buf_pos_ - type_offset, &consumed);
+    if (!msg_type_varint.has_value()) {
+      // type varint not complete yet
+      continue;
+    }
+    if (msg_type_varint->as_uint32() > std::numeric_limits<uint16_t>::max()) {
+      state_ = State::FAILED;
+      HELPER_LOG("Bad packet: message type %" PRIu32 " exceeds maximum", msg_type_varint->as_uint32());
+      return APIError::BAD_DATA_PACKET;
+    }
+    rx_header_parsed_type_ = msg_type_varint->as_uint16();
+    rx_header_parsed_ = true;
+  }
+
+  // read body
+  uint16_t msg_size = rx_header_parsed_len_;
+
+  // Reserve space for body
+  if (this->rx_buf_.size() != msg_size) {
+    this->rx_buf_.resize(msg_size);
+  }
+
+  if (rx_buf_len_ < msg_size) {
+    // more data to read
+    uint16_t to_read = msg_size - rx_buf_len_;
+    ssize_t received = this->socket_->read(&rx_buf_[rx_buf_len_], to_read);
+    APIError err = handle_socket_read_result_(received);
+    if (err != APIError::OK) {
+      return err;
+    }
+    rx_buf_len_ += static_cast<uint16_t>(received);
+    if (static_cast<uint16_t>(received) != to_read) {
+      // not all read
+      return APIError::WOULD_BLOCK;
+    }
+  }
+
+  LOG_PACKET_RECEIVED(this->rx_buf_);
+
+  // Clear state for next frame (rx_buf_ and the parsed header still describe this one for the caller)
+  this->rx_buf_len_ = 0;
+  this->rx_header_buf_pos_ = 0;
+  this->rx_header_parsed_ = false;
+
+  return APIError::OK;
+}
+
+APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
+  if (this->state_ != State::DATA) {
+    return APIError::WOULD_BLOCK;
+  }
+
+  APIError aerr = this->try_read_frame_();
+  if (aerr != APIError::OK)
+    return aerr;
+
+  buffer->data = this->rx_buf_.data();
+  buffer->data_len = this->rx_header_parsed_len_;
+  buffer->type = this->rx_header_parsed_type_;
+  return APIError::OK;
+}
+
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint8_t type, ProtoWriteBuffer buffer) {
+  MessageInfo msg{type, 0, static_cast<uint16_t>(buffer.get_buffer()->size() - frame_header_padding_)};
+  return write_protobuf_messages(buffer, std::span<const MessageInfo>(&msg, 1));
+}
+
+APIError APIPlaintextFrameHelper::write_protobuf_messages(ProtoWriteBuffer buffer,
+                                                          std::span<const MessageInfo> messages) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+
+  if (messages.empty()) {
+    return APIError::OK;
+  }
+
+  uint8_t *buffer_data = buffer.get_buffer()->data();
+
+  // Stack-allocated iovec array - no heap allocation
+  StaticVector<struct iovec, MAX_MESSAGES_PER_BATCH> iovs;
+  uint16_t total_write_len = 0;
+
+  for (const auto &msg : messages) {
+    // The header is written right-aligned in the padding so it directly precedes the payload;
+    // unused leading padding bytes are skipped by the iovec
+    uint8_t size_varint_len = ProtoSize::varint(static_cast<uint32_t>(msg.payload_size));
+    uint8_t type_varint_len = ProtoSize::varint(static_cast<uint32_t>(msg.message_type));
+    uint8_t total_header_len = 1 + size_varint_len + type_varint_len;
+    uint8_t header_offset = frame_header_padding_ - total_header_len;
+    uint8_t *buf_start = buffer_data + msg.offset + header_offset;
+
+    buf_start[0] = 0x00;  // indicator
+    uint8_t *p = buf_start + 1;
+    uint32_t value = msg.payload_size;
+    while (value >= 0x80) {
+      *p++ = static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(value);
+    value = msg.message_type;
+    while (value >= 0x80) {
+      *p++ = static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+    }
+    *p = static_cast<uint8_t>(value);
+
+    // Add iovec for this message (header + payload)
+    size_t msg_len = static_cast<size_t>(total_header_len + msg.payload_size);
+    iovs.push_back({buf_start, msg_len});
+    total_write_len += msg_len;
+  }
+
+  // Send all messages in one writev call
+  return this->write_raw_(iovs.data(), iovs.size(), total_write_len);
+}
+
+}  // namespace esphome::api
+#endif  // USE_API_PLAINTEXT
+#endif  // USE_API
@@ -144,6 +144,8 @@ void APIServer::loop() {
     // Continue to process and clean up the clients below
   }
 
+  // Deferred batches of several clients often expire in the same pass and carry the same entities
+  this->state_encode_cache_.begin(this->clients_.size() > 1);
   size_t client_index = 0;
   while (client_index < this->clients_.size()) {
     auto &client = this->clients_[client_index];
@@ -161,6 +163,7 @@ void APIServer::loop() {
       client_index++;
     }
   }
+  this->state_encode_cache_.end();
 }
 
 void APIServer::remove_client_(size_t client_index) {
@@ -257,10 +260,12 @@ void APIServer::handle_disconnect(APIConnection *conn) {}
   void APIServer::on_##entity_name##_update(entity_type *obj) { /* NOLINT(bugprone-macro-parentheses) */ \
     if (obj->is_internal()) \
       return; \
+    this->state_encode_cache_.begin(this->clients_.size() > 1); \
     for (auto &c : this->clients_) { \
       if (c->flags_.state_subscription) \
         c->send_##entity_name##_state(obj); \
     } \
+    this->state_encode_cache_.end(); \
   }
 
 #ifdef USE_BINARY_SENSOR
@@ -351,10 +356,12 @@ void APIServer::on_event(event::Event *obj) {
 void APIServer::on_update(update::UpdateEntity *obj) {
   if (obj->is_internal())
     return;
+  this->state_encode_cache_.begin(this->clients_.size() > 1);
   for (auto &c : this->clients_) {
     if (c->flags_.state_subscription)
       c->send_update_state(obj);
   }
+  this->state_encode_cache_.end();
 }
 #endif
 
@@ -435,8 +442,9 @@ void APIServer::handle_action_response(uint32_t call_id, bool success, StringRef
 // Helper to add subscription (reduces duplication)
 void APIServer::add_state_subscription_(const char *entity_id, const char *attribute, std::function<void(StringRef)> f,
                                         bool once) {
-  this->state_subs_.push_back(HomeAssistantStateSubscription{
-      .entity_id = entity_id, .attribute = attribute, .callback = std::move(f), .once = once,
+  this->push_state_subscription_(HomeAssistantStateSubscription{
+      .entity_id = entity_id, .attribute = attribute, .callback = std::move(f), .key = 0, .next = STATE_SUB_NONE,
+      .once = once,
       // entity_id_dynamic_storage and attribute_dynamic_storage remain nullptr (no heap allocation)
   });
 }
@@ -458,7 +466,82 @@ void APIServer::add_state_subscription_(std::string entity_id, optional<std::str
 
   sub.callback = std::move(f);
   sub.once = once;
+  this->push_state_subscription_(std::move(sub));
+}
+
+void APIServer::push_state_subscription_(HomeAssistantStateSubscription &&sub) {
+  sub.key = state_sub_key_(sub.entity_id, strlen(sub.entity_id), sub.attribute,
+                           sub.attribute != nullptr ? strlen(sub.attribute) : 0);
+  sub.next = STATE_SUB_NONE;
   this->state_subs_.push_back(std::move(sub));
+  this->state_sub_buckets_.clear();
+}
+
+uint32_t APIServer::state_sub_key_(const char *entity_id, size_t entity_id_len, const char *attribute,
+                                   size_t attribute_len) {
+  // FNV-1a over entity_id, a NUL separator, then attribute. A missing attribute hashes like an empty one.
+  uint32_t hash = FNV1_OFFSET_BASIS;
+  for (size_t i = 0; i < entity_id_len; i++)
+    hash = fnv1a_hash_extend(hash, static_cast<uint8_t>(entity_id[i]));
+  hash = fnv1a_hash_extend(hash, static_cast<uint8_t>(0));
+  for (size_t i = 0; i < attribute_len; i++)
+    hash = fnv1a_hash_extend(hash, static_cast<uint8_t>(attribute[i]));
+  return hash;
+}
+
+// Compare a null-terminated subscription field with a non-terminated message field
+static bool state_sub_field_equals(const char *field, StringRef value) {
+  return strnlen(field, value.size() + 1) == value.size() && memcmp(field, value.c_str(), value.size()) == 0;
+}
+
+void APIServer::index_state_subscriptions_() {
+  size_t buckets = 1;
+  while (buckets < this->state_subs_.size())
+    buckets <<= 1;
+  this->state_sub_buckets_.assign(buckets, STATE_SUB_NONE);
+  // Insert back to front so every chain runs in subscription order
+  for (size_t i = this->state_subs_.size(); i-- > 0;) {
+    auto &sub = this->state_subs_[i];
+    uint16_t &head = this->state_sub_buckets_[sub.key & (buckets - 1)];
+    sub.next = head;
+    head = static_cast<uint16_t>(i);
+  }
+}
+
+void APIServer::dispatch_home_assistant_state(StringRef entity_id, StringRef attribute, StringRef state) {
+  if (this->state_subs_.empty())
+    return;
+  if (this->state_sub_buckets_.empty())
+    this->index_state_subscriptions_();
+
+  uint32_t key = state_sub_key_(entity_id.c_str(), entity_id.size(), attribute.c_str(), attribute.size());
+  uint16_t index = this->state_sub_buckets_[key & (this->state_sub_buckets_.size() - 1)];
+  auto matches = [&](const HomeAssistantStateSubscription &sub) {
+    // Confirm the match, the key is only a hash
+    return sub.key == key && state_sub_field_equals(sub.entity_id, entity_id) &&
+           state_sub_field_equals(sub.attribute != nullptr ? sub.attribute : "", attribute);
+  };
+
+  while (index != STATE_SUB_NONE && !matches(this->state_subs_[index]))
+    index = this->state_subs_[index].next;
+  if (index == STATE_SUB_NONE)
+    return;
+
+  // Null-terminated copy of the state, made only once something matched (parse_number needs null-termination)
+  // HA state max length is 255 characters, but attributes can be much longer
+  // Use stack buffer for common case (states), heap fallback for large attributes
+  SmallBufferWithHeapFallback<MAX_STATE_LEN + 1> state_buf_alloc(state.size() + 1);
+  char *state_buf = reinterpret_cast<char *>(state_buf_alloc.get());
+  if (!state.empty()) {
+    memcpy(state_buf, state.c_str(), state.size());
+  }
+  state_buf[state.size()] = '\0';
+
+  for (; index != STATE_SUB_NONE; index = this->state_subs_[index].next) {
+    const auto &it = this->state_subs_[index];
+    if (matches(it))
+      it.callback(StringRef(state_buf, state.size()));
+  }
 }
 
 // New const char* overload (for internal components - zero allocation)
@@ -20,6 +20,8 @@
 #include "esphome/components/camera/camera.h"
 #endif
 
+#include <array>
+#include <span>
 #include <vector>
 
 namespace esphome::api {
@@ -71,6 +73,54 @@ class APIServer : public Component,
   // Get reference to shared buffer for API connections
   std::vector<uint8_t> &get_shared_buffer_ref() { return shared_write_buffer_; }
 
+  /// Encoded state payloads (protobuf body only, no framing) shared between connections.
+  /// Enabled only while one state change, or one loop pass over the clients, is being fanned out to
+  /// more than one client. A synchronous state change inside a loop pass restarts the cache through its
+  /// own fan-out; a coalesced one (sensor, text_sensor) only marks the entity pending until the end of
+  /// the loop iteration, so encode_state_to_buffer() bypasses the cache for pending entities.
+  /// Each connection still frames and (for Noise) encrypts its own copy.
+  class StateEncodeCache {
+   public:
+    static constexpr uint8_t MAX_ENTRIES = 16;
+
+    void begin(bool enabled) {
+      this->count_ = 0;
+      this->payloads_.clear();
+      this->enabled_ = enabled;
+    }
+    void end() { this->begin(false); }
+    bool is_enabled() const { return this->enabled_; }
+
+    /// Return the cached payload for (entity, message_type), or an empty span.
+    std::span<const uint8_t> find(const EntityBase *entity, uint8_t message_type) const {
+      for (uint8_t i = 0; i < this->count_; i++) {
+        const auto &e = this->entries_[i];
+        if (e.entity == entity && e.message_type == message_type)
+          return {this->payloads_.data() + e.offset, e.length};
+      }
+      return {};
+    }
+    void store(const EntityBase *entity, uint8_t message_type, const uint8_t *data, uint16_t length) {
+      if (this->count_ >= MAX_ENTRIES)
+        return;
+      this->entries_[this->count_++] = {entity, static_cast<uint16_t>(this->payloads_.size()), length, message_type};
+      this->payloads_.insert(this->payloads_.end(), data, data + length);
+    }
+
+   protected:
+    struct Entry {
+      const EntityBase *entity;
+      uint16_t offset;
+      uint16_t length;
+      uint8_t message_type;
+    };
+    std::array<Entry, MAX_ENTRIES> entries_{};
+    std::vector<uint8_t> payloads_;  // Capacity is kept between fan-outs
+    uint8_t count_{0};
+    bool enabled_{false};
+  };
+  StateEncodeCache &get_state_encode_cache() { return this->state_encode_cache_; }
+
 #ifdef USE_API_NOISE
   bool save_noise_psk(psk_t psk, bool make_active = true);
   bool clear_noise_psk(bool make_active = true);
@@ -196,6 +246,8 @@ class APIServer : public Component,
     const char *entity_id;  // Pointer to flash (internal) or heap (external)
     const char *attribute;  // Pointer to flash or nullptr (nullptr means no attribute)
     std::function<void(StringRef)> callback;
+    uint32_t key;   // state_sub_key_() of (entity_id, attribute), checked before comparing strings
+    uint16_t next;  // Next subscription in the same index bucket, STATE_SUB_NONE ends the chain
     bool once;
 
     // Dynamic storage for external components using std::string API (custom_api_device.h)
@@ -221,6 +273,9 @@ class APIServer : public Component,
                                 std::function<void(const std::string &)> f);
 
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
+  /// Invoke every subscription matching (entity_id, attribute). An empty attribute matches
+  /// subscriptions without one.
+  void dispatch_home_assistant_state(StringRef entity_id, StringRef attribute, StringRef state);
 #endif
 #ifdef USE_API_USER_DEFINED_ACTIONS
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
@@ -252,6 +307,12 @@ class APIServer : public Component,
   // Legacy helper: wraps std::string callback and delegates to StringRef version
   void add_state_subscription_(std::string entity_id, optional<std::string> attribute,
                                std::function<void(const std::string &)> f, bool once);
+  void push_state_subscription_(HomeAssistantStateSubscription &&sub);
+  // Rebuild state_sub_buckets_ after subscriptions were added (subscriptions are only added, never removed)
+  void index_state_subscriptions_();
+  static uint32_t state_sub_key_(const char *entity_id, size_t entity_id_len, const char *attribute,
+                                 size_t attribute_len);
+  static constexpr uint16_t STATE_SUB_NONE = 0xFFFF;
 #endif  // USE_API_HOMEASSISTANT_STATES
   // Pointers and pointer-like types first (4 bytes each)
   std::unique_ptr<socket::Socket> socket_ = nullptr;
@@ -269,8 +330,12 @@ class APIServer : public Component,
   // Vectors and strings (12 bytes each on 32-bit)
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::vector<uint8_t> shared_write_buffer_;  // Shared proto write buffer for all connections
+  StateEncodeCache state_encode_cache_;
 #ifdef USE_API_HOMEASSISTANT_STATES
   std::vector<HomeAssistantStateSubscription> state_subs_;
+  // Hash index over state_subs_: power-of-two bucket heads, chained through HomeAssistantStateSubscription::next.
+  // Emptied on every add and rebuilt on the next dispatch.
+  std::vector<uint16_t> state_sub_buckets_;
 #endif
 #ifdef USE_API_USER_DEFINED_ACTIONS
   std::vector<UserServiceDescriptor *> user_services_;
@@ -1,18 +1,16 @@
 #include "filter.h"
 
 #include "binary_sensor.h"
+#include "esphome/core/application.h"
 
 namespace esphome::binary_sensor {
 
 static const char *const TAG = "sensor.filter";
 
-// Timeout IDs for filter classes.
-// Each filter is its own Component instance, so the scheduler scopes
-// IDs by component pointer — no risk of collisions between instances.
-constexpr uint32_t FILTER_TIMEOUT_ID = 0;
-// AutorepeatFilter needs two distinct IDs (both timeouts on the same component)
-constexpr uint32_t AUTOREPEAT_TIMING_ID = 0;
-constexpr uint32_t AUTOREPEAT_ON_OFF_ID = 1;
+/// Wraparound-safe "a is at or before b" for millis() timestamps.
+static inline bool deadline_reached(uint32_t deadline, uint32_t now) {
+  return static_cast<int32_t>(now - deadline) >= 0;
+}
 
 void Filter::output(bool value) {
   if (this->next_ == nullptr) {
@@ -30,46 +28,111 @@ void Filter::input(bool value) {
   }
 }
 
+// FilterTimer
+TimedFilter *FilterTimer::head_{nullptr};
+uint32_t FilterTimer::scheduled_deadline_{0};
+bool FilterTimer::scheduled_{false};
+bool FilterTimer::servicing_{false};
+
+void FilterTimer::arm(TimedFilter *filter) {
+  if (!filter->linked_) {
+    filter->next_timed_ = head_;
+    head_ = filter;
+    filter->linked_ = true;
+  }
+  // While servicing, the timeout is scheduled once for the earliest deadline at the end
+  if (servicing_)
+    return;
+  // A later deadline is picked up when the current timeout fires; only an earlier one needs rescheduling
+  if (!scheduled_ || static_cast<int32_t>(filter->deadline_ - scheduled_deadline_) < 0)
+    schedule_(filter->deadline_, millis());
+}
+
+void FilterTimer::schedule_(uint32_t deadline, uint32_t now) {
+  scheduled_deadline_ = deadline;
+  scheduled_ = true;
+  uint32_t delay = deadline_reached(deadline, now) ? 0 : deadline - now;
+  // Captureless lambda: fits std::function's small buffer, no heap allocation
+  App.scheduler.set_timeout(nullptr, InternalSchedulerID::BINARY_SENSOR_FILTER_TIMER, delay, []() { service_(); });
+}
+
+void FilterTimer::service_() {
+  scheduled_ = false;
+  servicing_ = true;
+  const uint32_t now = millis();
+
+  // Detach the list; filters that stay (or become) armed are linked back in as they are visited.
+  // Callbacks may arm other filters: unvisited ones are still marked linked and get re-linked when visited.
+  TimedFilter *filter = head_;
+  head_ = nullptr;
+  while (filter != nullptr) {
+    TimedFilter *next = filter->next_timed_;
+    filter->linked_ = false;
+    if (filter->armed_ && deadline_reached(filter->deadline_, now)) {
+      filter->armed_ = false;
+      filter->on_deadline_();
+    }
+    if (filter->armed_ && !filter->linked_) {
+      filter->next_timed_ = head_;
+      head_ = filter;
+      filter->linked_ = true;
+    }
+    filter = next;
+  }
+  servicing_ = false;
+
+  // Schedule the single shared timeout for the earliest remaining deadline
+  bool found = false;
+  uint32_t earliest = 0;
+  for (TimedFilter *it = head_; it != nullptr; it = it->next_timed_) {
+    if (!found || static_cast<int32_t>(it->deadline_ - earliest) < 0) {
+      earliest = it->deadline_;
+      found = true;
+    }
+  }
+  if (found)
+    schedule_(earliest, millis());
+}
+
 void TimeoutFilter::input(bool value) {
-  this->set_timeout(FILTER_TIMEOUT_ID, this->timeout_delay_.value(), [this]() { this->parent_->invalidate_state(); });
+  this->arm_(this->timeout_delay_.value());
   // we do not de-dup here otherwise changes from invalid to valid state will not be output
   this->output(value);
 }
 
+void TimeoutFilter::on_deadline_() { this->parent_->invalidate_state(); }
+
 optional<bool> DelayedOnOffFilter::new_value(bool value) {
-  if (value) {
-    this->set_timeout(FILTER_TIMEOUT_ID, this->on_delay_.value(), [this]() { this->output(true); });
-  } else {
-    this->set_timeout(FILTER_TIMEOUT_ID, this->off_delay_.value(), [this]() { this->output(false); });
-  }
+  this->pending_value_ = value;
+  this->arm_(value ? this->on_delay_.value() : this->off_delay_.value());
   return {};
 }
 
-float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOnOffFilter::on_deadline_() { this->output(this->pending_value_); }
 
 optional<bool> DelayedOnFilter::new_value(bool value) {
   if (value) {
-    this->set_timeout(FILTER_TIMEOUT_ID, this->delay_.value(), [this]() { this->output(true); });
+    this->arm_(this->delay_.value());
     return {};
   } else {
-    this->cancel_timeout(FILTER_TIMEOUT_ID);
+    this->disarm_();
     return false;
   }
 }
 
-float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOnFilter::on_deadline_() { this->output(true); }
 
 optional<bool> DelayedOffFilter::new_value(bool value) {
   if (!value) {
-    this->set_timeout(FILTER_TIMEOUT_ID, this->delay_.value(), [this]() { this->output(false); });
+    this->arm_(this->delay_.value());
     return {};
   } else {
-    this->cancel_timeout(FILTER_TIMEOUT_ID);
+    this->disarm_();
     return true;
   }
 }
 
-float DelayedOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOffFilter::on_deadline_() { this->output(false); }
 
 optional<bool> InvertFilter::new_value(bool value) { return !value; }
 
@@ -82,23 +145,49 @@ optional<bool> AutorepeatFilter::new_value(bool value) {
       return {};
 
     this->next_timing_();
+    this->rearm_();
     return true;
   } else {
-    this->cancel_timeout(AUTOREPEAT_TIMING_ID);
-    this->cancel_timeout(AUTOREPEAT_ON_OFF_ID);
+    this->timing_pending_ = false;
+    this->toggle_pending_ = false;
+    this->disarm_();
     this->active_timing_ = 0;
     return false;
   }
 }
 
+void AutorepeatFilter::on_deadline_() {
+  const uint32_t now = millis();
+  if (this->timing_pending_ && deadline_reached(this->timing_deadline_, now)) {
+    this->timing_pending_ = false;
+    this->next_timing_();
+  }
+  if (this->toggle_pending_ && deadline_reached(this->toggle_deadline_, now)) {
+    this->toggle_pending_ = false;
+    this->next_value_(this->toggle_value_);
+  }
+  this->rearm_();
+}
+
+void AutorepeatFilter::rearm_() {
+  if (this->timing_pending_ &&
+      (!this->toggle_pending_ || static_cast<int32_t>(this->timing_deadline_ - this->toggle_deadline_) <= 0)) {
+    this->arm_at_(this->timing_deadline_);
+  } else if (this->toggle_pending_) {
+    this->arm_at_(this->toggle_deadline_);
+  } else {
+    this->disarm_();
+  }
+}
+
 void AutorepeatFilter::next_timing_() {
   // Entering this method
   // 1st time: starts waiting the first delay
   // 2nd time: starts waiting the second delay and starts toggling with the first time_off / _on
   // last time: no delay to start but have to bump the index to reflect the last
   if (this->active_timing_ < this->timings_.size()) {
-    this->set_timeout(AUTOREPEAT_TIMING_ID, this->timings_[this->active_timing_].delay,
-                      [this]() { this->next_timing_(); });
+    this->timing_deadline_ = millis() + this->timings_[this->active_timing_].delay;
+    this->timing_pending_ = true;
   }
 
   if (this->active_timing_ <= this->timings_.size()) {
@@ -114,31 +203,36 @@ void AutorepeatFilter::next_timing_() {
 void AutorepeatFilter::next_value_(bool val) {
   const AutorepeatFilterTiming &timing = this->timings_[this->active_timing_ - 2];
   this->output(val);  // This is at least the second one so not initial
-  this->set_timeout(AUTOREPEAT_ON_OFF_ID, val ? timing.time_on : timing.time_off,
-                    [this, val]() { this->next_value_(!val); });
+  this->toggle_deadline_ = millis() + (val ? timing.time_on : timing.time_off);
+  this->toggle_value_ = !val;
+  this->toggle_pending_ = true;
 }
 
-float AutorepeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
 LambdaFilter::LambdaFilter(std::function<optional<bool>(bool)> f) : f_(std::move(f)) {}
 
 optional<bool> LambdaFilter::new_value(bool value) { return this->f_(value); }
 
 optional<bool> SettleFilter::new_value(bool value) {
   if (!this->steady_) {
-    this->set_timeout(FILTER_TIMEOUT_ID, this->delay_.value(), [this, value]() {
-      this->steady_ = true;
-      this->output(value);
-    });
+    this->pending_value_ = value;
+    this->output_pending_ = true;
+    this->arm_(this->delay_.value());
     return {};
   } else {
     this->steady_ = false;
     this->output(value);
-    this->set_timeout(FILTER_TIMEOUT_ID, this->delay_.value(), [this]() { this->steady_ = true; });
+    this->output_pending_ = false;
+    this->arm_(this->delay_.value());
     return value;
   }
 }
 
-float SettleFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void SettleFilter::on_deadline_() {
+  this->steady_ = true;
+  if (this->output_pending_) {
+    this->output_pending_ = false;
+    this->output(this->pending_value_);
+  }
+}
 
 }  // namespace esphome::binary_sensor
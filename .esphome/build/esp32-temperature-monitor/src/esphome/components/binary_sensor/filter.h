@@ -2,6 +2,7 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 namespace esphome::binary_sensor {
@@ -24,51 +25,103 @@ class Filter {
   Deduplicator<bool> dedup_;
 };
 
-class TimeoutFilter : public Filter, public Component {
+class TimedFilter;
+
+/** Single shared timer that services the deadline slots of all TimedFilters.
+ *
+ * Armed filters are kept in an intrusive list and the scheduler only ever holds one timeout,
+ * set to the earliest deadline. Re-arming a slot to a later deadline or disarming it costs no
+ * scheduler operation at all; the timer simply re-evaluates the list when it fires.
+ */
+class FilterTimer {
+ public:
+  /// Link `filter` into the list and make sure the shared timeout fires no later than its deadline.
+  static void arm(TimedFilter *filter);
+
+ protected:
+  static void service_();
+  static void schedule_(uint32_t deadline, uint32_t now);
+
+  static TimedFilter *head_;
+  static uint32_t scheduled_deadline_;
+  static bool scheduled_;
+  static bool servicing_;
+};
+
+/** Base class for filters that act after a delay.
+ *
+ * Each filter owns one deadline slot. There is no Component and no captured lambda per filter;
+ * FilterTimer calls on_deadline_() once the armed deadline has passed.
+ */
+class TimedFilter : public Filter {
+ protected:
+  friend FilterTimer;
+
+  /// Called by the shared timer once the armed deadline has passed. The slot is already disarmed.
+  virtual void on_deadline_() = 0;
+
+  void arm_(uint32_t delay) { this->arm_at_(millis() + delay); }
+  void arm_at_(uint32_t deadline) {
+    this->deadline_ = deadline;
+    this->armed_ = true;
+    FilterTimer::arm(this);
+  }
+  void disarm_() { this->armed_ = false; }
+
+  TimedFilter *next_timed_{nullptr};
+  uint32_t deadline_{0};
+  bool armed_{false};
+  bool linked_{false};
+};
+
+class TimeoutFilter : public TimedFilter {
  public:
   optional<bool> new_value(bool value) override { return value; }
   void input(bool value) override;
   template<typename T> void set_timeout_value(T timeout) { this->timeout_delay_ = timeout; }
 
  protected:
+  void on_deadline_() override;
+
   TemplatableValue<uint32_t> timeout_delay_{};
 };
 
-class DelayedOnOffFilter : public Filter, public Component {
+class DelayedOnOffFilter : public TimedFilter {
  public:
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
   template<typename T> void set_on_delay(T delay) { this->on_delay_ = delay; }
   template<typename T> void set_off_delay(T delay) { this->off_delay_ = delay; }
 
  protected:
+  void on_deadline_() override;
+
   TemplatableValue<uint32_t> on_delay_{};
   TemplatableValue<uint32_t> off_delay_{};
+  bool pending_value_{false};
 };
 
-class DelayedOnFilter : public Filter, public Component {
+class DelayedOnFilter : public TimedFilter {
  public:
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
   template<typename T> void set_delay(T delay) { this->delay_ = delay; }
 
  protected:
+  void on_deadline_() override;
+
   TemplatableValue<uint32_t> delay_{};
 };
 
-class DelayedOffFilter : public Filter, public Component {
+class DelayedOffFilter : public TimedFilter {
  public:
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
   template<typename T> void set_delay(T delay) { this->delay_ = delay; }
 
  protected:
+  void on_deadline_() override;
+
   TemplatableValue<uint32_t> delay_{};
 };
 
@@ -83,20 +136,27 @@ struct AutorepeatFilterTiming {
   uint32_t time_on;
 };
 
-class AutorepeatFilter : public Filter, public Component {
+/// Autorepeat multiplexes its two timers (next timing stage and next on/off toggle) onto one deadline slot.
+class AutorepeatFilter : public TimedFilter {
  public:
   explicit AutorepeatFilter(std::initializer_list<AutorepeatFilterTiming> timings);
 
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
  protected:
+  void on_deadline_() override;
   void next_timing_();
   void next_value_(bool val);
+  /// Arm the slot for whichever pending timer is due first.
+  void rearm_();
 
   FixedVector<AutorepeatFilterTiming> timings_;
+  uint32_t timing_deadline_{0};
+  uint32_t toggle_deadline_{0};
   uint8_t active_timing_{0};
+  bool timing_pending_{false};
+  bool toggle_pending_{false};
+  bool toggle_value_{false};
 };
 
 class LambdaFilter : public Filter {
@@ -124,17 +184,19 @@ class StatelessLambdaFilter : public Filter {
   optional<bool> (*f_)(bool);
 };
 
-class SettleFilter : public Filter, public Component {
+class SettleFilter : public TimedFilter {
  public:
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
   template<typename T> void set_delay(T delay) { this->delay_ = delay; }
 
  protected:
+  void on_deadline_() override;
+
   TemplatableValue<uint32_t> delay_{};
   bool steady_{true};
+  bool output_pending_{false};
+  bool pending_value_{false};
 };
 
 }  // namespace esphome::binary_sensor
@@ -5,6 +5,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 #include "esphome/core/version.h"
 #include <cinttypes>
 #include <climits>
@@ -14,11 +15,89 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+#if defined(USE_DEBUG_HEAP_TRACE) || (defined(USE_TRACE_RECORDER) && defined(USE_WEBSERVER) && defined(USE_ESP32))
+void DebugComponent::setup() {
+#ifdef USE_WEBSERVER
+  if (web_server_base::global_web_server_base != nullptr) {
+#ifdef USE_DEBUG_HEAP_TRACE
+    web_server_base::global_web_server_base->add_handler(&this->heap_trace_handler_);
+#endif
+#if defined(USE_TRACE_RECORDER) && defined(USE_ESP32)
+    web_server_base::global_web_server_base->add_handler(&this->trace_handler_);
+#endif
+  }
+#endif
+}
+#endif
+
+#if defined(USE_TRACE_RECORDER) && defined(USE_WEBSERVER) && defined(USE_ESP32)
+bool TraceHandler::canHandle(AsyncWebServerRequest *request) const {
+  if (request->method() != HTTP_GET)
+    return false;
+  char url_buf[AsyncWebServerRequest::URL_BUF_SIZE];
+  StringRef url = request->url_to(url_buf);
+  return url == ESPHOME_F("/debug/trace") || url == ESPHOME_F("/debug/trace.json");
+}
+
+void TraceHandler::handleRequest(AsyncWebServerRequest *request) {
+  char url_buf[AsyncWebServerRequest::URL_BUF_SIZE];
+  bool json = request->url_to(url_buf) == ESPHOME_F("/debug/trace.json");
+  // The trace is far larger than a response buffer, so stream it straight out as chunks
+  httpd_req_t *req = *request;
+  httpd_resp_set_type(req, json ? "application/json" : "application/octet-stream");
+  auto send_chunk = [](void *ctx, const char *data, size_t len) {
+    httpd_resp_send_chunk(static_cast<httpd_req_t *>(ctx), data, len);
+  };
+  if (json) {
+    global_trace_recorder.export_chrome_json(send_chunk, req);
+  } else {
+    global_trace_recorder.export_binary(send_chunk, req);
+  }
+  httpd_resp_send_chunk(req, nullptr, 0);
+}
+#endif
+
+#ifdef USE_DEBUG_HEAP_TRACE
+// Top allocators published to the heap trace text sensor
+static constexpr size_t HEAP_TRACE_SENSOR_TOP = 5;
+
+#ifdef USE_WEBSERVER
+bool HeapTraceHandler::canHandle(AsyncWebServerRequest *request) const {
+  if (request->method() != HTTP_GET)
+    return false;
+#ifdef USE_ESP32
+  char url_buf[AsyncWebServerRequest::URL_BUF_SIZE];
+  StringRef url = request->url_to(url_buf);
+#else
+  const auto &url = request->url();
+#endif
+  return url == ESPHOME_F("/debug/heap");
+}
+
+void HeapTraceHandler::handleRequest(AsyncWebServerRequest *request) {
+  char report[REPORT_SIZE];
+  global_heap_tracer.report_to(report, sizeof(report), REPORT_TOP);
+  request->send(200, "text/plain", report);
+}
+#endif  // USE_WEBSERVER
+#endif  // USE_DEBUG_HEAP_TRACE
+
 void DebugComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Debug component:");
 #ifdef USE_TEXT_SENSOR
   LOG_TEXT_SENSOR("  ", "Device info", this->device_info_);
+#ifdef USE_DEBUG_HEAP_TRACE
+  LOG_TEXT_SENSOR("  ", "Heap trace", this->heap_trace_);
+#endif
 #endif  // USE_TEXT_SENSOR
+#ifdef USE_DEBUG_HEAP_TRACE
+  ESP_LOGCONFIG(TAG, "  Heap tracing: enabled (%u untracked allocations)",
+                static_cast<unsigned>(global_heap_tracer.get_untracked()));
+#endif
+#ifdef USE_TRACE_RECORDER
+  ESP_LOGCONFIG(TAG, "  Trace recorder: %u records x %u cores", static_cast<unsigned>(TraceRecorder::RING_SIZE),
+                static_cast<unsigned>(TraceRecorder::NUM_CORES));
+#endif
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Free space on heap", this->free_sensor_);
   LOG_SENSOR("  ", "Largest free heap block", this->block_sensor_);
@@ -89,6 +168,18 @@ void DebugComponent::update() {
 
 #endif  // USE_SENSOR
   update_platform_();
+
+#ifdef USE_DEBUG_HEAP_TRACE
+  // Allocation rates are reported per update interval
+  global_heap_tracer.roll_window();
+#ifdef USE_TEXT_SENSOR
+  if (this->heap_trace_ != nullptr) {
+    char summary[256];
+    size_t len = global_heap_tracer.summary_to(summary, sizeof(summary), HEAP_TRACE_SENSOR_TOP);
+    this->heap_trace_->publish_state(summary, len);
+  }
+#endif
+#endif
 }
 
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
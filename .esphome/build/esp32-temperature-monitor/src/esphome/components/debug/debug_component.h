@@ -12,6 +12,12 @@
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
+#ifdef USE_DEBUG_HEAP_TRACE
+#include "heap_trace.h"
+#endif
+#if defined(USE_WEBSERVER) && (defined(USE_DEBUG_HEAP_TRACE) || (defined(USE_TRACE_RECORDER) && defined(USE_ESP32)))
+#include "esphome/components/web_server_base/web_server_base.h"
+#endif
 
 namespace esphome {
 namespace debug {
@@ -21,8 +27,37 @@ static constexpr size_t RESET_REASON_BUFFER_SIZE = 128;
 
 // buf_append_printf is now provided by esphome/core/helpers.h
 
+#if defined(USE_DEBUG_HEAP_TRACE) && defined(USE_WEBSERVER)
+/// Serves the heap allocation report at /debug/heap
+class HeapTraceHandler : public AsyncWebHandler {
+ public:
+  static constexpr size_t REPORT_SIZE = 1536;
+  static constexpr size_t REPORT_TOP = 16;
+
+  bool canHandle(AsyncWebServerRequest *request) const override;
+  void handleRequest(AsyncWebServerRequest *request) override;
+};
+#endif
+
+#if defined(USE_TRACE_RECORDER) && defined(USE_WEBSERVER) && defined(USE_ESP32)
+/// Streams the trace recorder: /debug/trace (binary) and /debug/trace.json (Chrome trace / Perfetto)
+class TraceHandler : public AsyncWebHandler {
+ public:
+  bool canHandle(AsyncWebServerRequest *request) const override;
+  void handleRequest(AsyncWebServerRequest *request) override;
+};
+#endif
+
 class DebugComponent : public PollingComponent {
  public:
+#ifdef USE_DEBUG_HEAP_TRACE
+  /// Tracing starts here rather than in setup(): main() constructs the components before App.setup(), so the
+  /// setup() allocations of components that run before this one are traced too
+  DebugComponent() { global_heap_tracer.start(); }
+#endif
+#if defined(USE_DEBUG_HEAP_TRACE) || (defined(USE_TRACE_RECORDER) && defined(USE_WEBSERVER) && defined(USE_ESP32))
+  void setup() override;
+#endif
   void loop() override;
   void update() override;
   float get_setup_priority() const override;
@@ -31,6 +66,9 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+#ifdef USE_DEBUG_HEAP_TRACE
+  void set_heap_trace_sensor(text_sensor::TextSensor *heap_trace) { heap_trace_ = heap_trace; }
+#endif
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -91,7 +129,16 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+#ifdef USE_DEBUG_HEAP_TRACE
+  text_sensor::TextSensor *heap_trace_{nullptr};
+#endif
 #endif  // USE_TEXT_SENSOR
+#if defined(USE_DEBUG_HEAP_TRACE) && defined(USE_WEBSERVER)
+  HeapTraceHandler heap_trace_handler_;
+#endif
+#if defined(USE_TRACE_RECORDER) && defined(USE_WEBSERVER) && defined(USE_ESP32)
+  TraceHandler trace_handler_;
+#endif
 
   const char *get_reset_reason_(std::span<char, RESET_REASON_BUFFER_SIZE> buffer);
   const char *get_wakeup_cause_(std::span<char, RESET_REASON_BUFFER_SIZE> buffer);
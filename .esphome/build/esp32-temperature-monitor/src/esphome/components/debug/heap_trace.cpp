@@ -0,0 +1,187 @@
+#include "heap_trace.h"
+#ifdef USE_DEBUG_HEAP_TRACE
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+
+namespace esphome {
+namespace debug {
+
+static constexpr size_t TRACKED_MASK = HeapTracer::MAX_TRACKED - 1;
+static constexpr uint32_t MAX_TRACKED_SIZE = (1u << 24) - 1;
+
+static inline ESPHOME_ALWAYS_INLINE size_t hash_ptr(uintptr_t ptr) {
+  // Heap blocks are at least 4-byte aligned; Fibonacci hashing spreads the remaining bits
+  return (static_cast<uint32_t>(ptr >> 2) * 2654435761u) & TRACKED_MASK;
+}
+
+void HeapTracer::start() {
+  heap_trace_platform_start();
+  heap_trace_lock();
+  this->running_ = true;
+  heap_trace_unlock();
+}
+
+// The record path runs inside the allocator, possibly while the flash cache is disabled; it and everything it calls
+// stay in IRAM, and the tracer itself is a zero-initialized global in DRAM
+uint8_t IRAM_ATTR HeapTracer::slot_for_(const Component *component) {
+  if (component == nullptr)
+    return SLOT_CORE;
+  if (component == this->last_component_)
+    return this->last_slot_;
+  uint8_t slot = 2;
+  while (slot < this->slot_count_ && this->slots_[slot].component != component)
+    slot++;
+  if (slot == this->slot_count_) {
+    if (this->slot_count_ == MAX_SLOTS)
+      return SLOT_CORE;
+    this->slots_[slot].component = component;
+    this->slot_count_++;
+  }
+  this->last_component_ = component;
+  this->last_slot_ = slot;
+  return slot;
+}
+
+size_t IRAM_ATTR HeapTracer::find_(uintptr_t ptr) const {
+  size_t i = hash_ptr(ptr);
+  while (this->tracked_[i].ptr != 0) {
+    if (this->tracked_[i].ptr == ptr)
+      return i;
+    i = (i + 1) & TRACKED_MASK;
+  }
+  return MAX_TRACKED;
+}
+
+void IRAM_ATTR HeapTracer::record_alloc(void *ptr, size_t size, bool main_task) {
+  if (!this->running_ || ptr == nullptr)
+    return;
+  uint8_t slot = main_task ? this->slot_for_(App.get_current_component()) : SLOT_OTHER_TASKS;
+  auto &entry = this->slots_[slot];
+  entry.total_allocs++;
+  entry.window_allocs++;
+
+  // Keep the table at most 7/8 full so probe sequences stay short
+  if (this->tracked_count_ >= MAX_TRACKED - MAX_TRACKED / 8 || size > MAX_TRACKED_SIZE) {
+    this->untracked_++;
+    return;
+  }
+  size_t i = hash_ptr(reinterpret_cast<uintptr_t>(ptr));
+  while (this->tracked_[i].ptr != 0)
+    i = (i + 1) & TRACKED_MASK;
+  this->tracked_[i] = {reinterpret_cast<uintptr_t>(ptr), static_cast<uint32_t>(size), slot};
+  this->tracked_count_++;
+
+  entry.live_bytes += size;
+  entry.live_count++;
+  if (entry.live_bytes > entry.peak_bytes)
+    entry.peak_bytes = entry.live_bytes;
+}
+
+void IRAM_ATTR HeapTracer::record_free(void *ptr) {
+  if (!this->running_ || ptr == nullptr)
+    return;
+  size_t i = this->find_(reinterpret_cast<uintptr_t>(ptr));
+  if (i == MAX_TRACKED)
+    return;  // Allocated before tracing started or while the table was full
+  auto &entry = this->slots_[this->tracked_[i].slot];
+  entry.live_bytes -= this->tracked_[i].size;
+  entry.live_count--;
+  this->tracked_count_--;
+
+  // Backward-shift deletion keeps linear probing correct without tombstones
+  size_t hole = i;
+  size_t j = i;
+  for (;;) {
+    j = (j + 1) & TRACKED_MASK;
+    if (this->tracked_[j].ptr == 0)
+      break;
+    size_t home = hash_ptr(this->tracked_[j].ptr);
+    // Move j into the hole unless its home lies cyclically in (hole, j]
+    bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+    if (!stays) {
+      this->tracked_[hole] = this->tracked_[j];
+      hole = j;
+    }
+  }
+  this->tracked_[hole] = {};
+}
+
+size_t HeapTracer::snapshot(HeapTraceEntry *out, size_t max_entries) {
+  size_t count = 0;
+  heap_trace_lock();
+  for (uint8_t slot = 0; slot < this->slot_count_; slot++) {
+    const auto &entry = this->slots_[slot];
+    if (entry.total_allocs == 0)
+      continue;
+    // Insertion sort by live bytes; there are at most MAX_SLOTS entries
+    size_t pos = count < max_entries ? count : max_entries;
+    while (pos > 0 && out[pos - 1].live_bytes < entry.live_bytes) {
+      if (pos < max_entries)
+        out[pos] = out[pos - 1];
+      pos--;
+    }
+    if (pos < max_entries) {
+      out[pos] = entry;
+      out[pos].slot = slot;
+      if (count < max_entries)
+        count++;
+    }
+  }
+  heap_trace_unlock();
+  return count;
+}
+
+void HeapTracer::roll_window() {
+  heap_trace_lock();
+  for (uint8_t slot = 0; slot < this->slot_count_; slot++) {
+    this->slots_[slot].last_window_allocs = this->slots_[slot].window_allocs;
+    this->slots_[slot].window_allocs = 0;
+  }
+  heap_trace_unlock();
+}
+
+const char *HeapTracer::slot_name_(const HeapTraceEntry &entry) {
+  if (entry.slot == SLOT_OTHER_TASKS)
+    return "other tasks";
+  if (entry.slot == SLOT_CORE)
+    return "core";
+  return LOG_STR_ARG(entry.component->get_component_log_str());
+}
+
+size_t HeapTracer::report_to(char *buf, size_t size, size_t top) {
+  HeapTraceEntry entries[MAX_SLOTS];
+  size_t count = this->snapshot(entries, top < MAX_SLOTS ? top : MAX_SLOTS);
+  size_t pos = buf_append_printf(buf, size, 0, "%-24s %10s %8s %10s %10s %8s\n", "owner", "live_bytes", "blocks",
+                                 "peak_bytes", "allocs", "window");
+  for (size_t i = 0; i < count; i++) {
+    const auto &e = entries[i];
+    pos = buf_append_printf(buf, size, pos,
+                            "%-24s %10" PRIu32 " %8" PRIu32 " %10" PRIu32 " %10" PRIu32 " %8" PRIu32 "\n",
+                            slot_name_(e), e.live_bytes, e.live_count, e.peak_bytes, e.total_allocs,
+                            e.last_window_allocs);
+  }
+  pos = buf_append_printf(buf, size, pos, "untracked allocs: %" PRIu32 "\n", this->untracked_);
+  return pos < size ? pos : size - 1;
+}
+
+size_t HeapTracer::summary_to(char *buf, size_t size, size_t top) {
+  HeapTraceEntry entries[MAX_SLOTS];
+  size_t count = this->snapshot(entries, top < MAX_SLOTS ? top : MAX_SLOTS);
+  size_t pos = 0;
+  if (size > 0)
+    buf[0] = '\0';
+  for (size_t i = 0; i < count; i++) {
+    pos = buf_append_printf(buf, size, pos, "%s%s=%" PRIu32 "/%" PRIu32, i == 0 ? "" : ", ", slot_name_(entries[i]),
+                            entries[i].live_bytes, entries[i].last_window_allocs);
+  }
+  return pos < size ? pos : (size > 0 ? size - 1 : 0);
+}
+
+HeapTracer global_heap_tracer;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace debug
+}  // namespace esphome
+#endif  // USE_DEBUG_HEAP_TRACE
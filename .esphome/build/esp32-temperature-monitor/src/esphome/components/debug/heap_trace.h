@@ -0,0 +1,94 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_DEBUG_HEAP_TRACE
+#include <cstddef>
+#include <cstdint>
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace debug {
+
+/// Allocation statistics attributed to one owner
+struct HeapTraceEntry {
+  /// Component running when the memory was allocated; nullptr for the core and other-task slots
+  const Component *component;
+  uint32_t live_bytes;
+  uint32_t live_count;
+  uint32_t peak_bytes;
+  uint32_t total_allocs;
+  /// Allocations in the current and the previous report window
+  uint32_t window_allocs;
+  uint32_t last_window_allocs;
+  uint8_t slot;
+};
+
+/** Opt-in heap allocation tracer.
+ *
+ * Platform hooks (heap_trace_esp32.cpp, heap_trace_host.cpp) feed every malloc/free into record_alloc() and
+ * record_free(). Allocations made on the main loop are attributed to App.get_current_component(), which
+ * Application and the scheduler set around each component's setup()/loop() and each scheduled callback; anything
+ * in between (the loop itself, API, logger, web server) lands in the "core" slot and allocations from other tasks
+ * share one slot. Live pointers are kept in a fixed open-addressing table so frees credit the owner of the allocation,
+ * not whoever happens to free it. Nothing here allocates, so it is safe to call from inside the allocator, and the
+ * record path is in IRAM so it also runs while the flash cache is disabled.
+ */
+class HeapTracer {
+ public:
+  static constexpr uint8_t MAX_SLOTS = 32;
+  /// Power of two; allocations beyond ~7/8 of this are counted as untracked
+  static constexpr size_t MAX_TRACKED = 1024;
+  static constexpr uint8_t SLOT_OTHER_TASKS = 0;
+  static constexpr uint8_t SLOT_CORE = 1;
+
+  /// Start tracing. Must be called from the main loop task; DebugComponent does so from its constructor.
+  void start();
+  bool is_running() const { return this->running_; }
+
+  void record_alloc(void *ptr, size_t size, bool main_task);
+  void record_free(void *ptr);
+
+  /// Copy the slots sorted by live bytes (largest first), returns the number copied
+  size_t snapshot(HeapTraceEntry *out, size_t max_entries);
+  /// Start a new allocation rate window
+  void roll_window();
+
+  /// Render a text report of the top allocators, returns the length written
+  size_t report_to(char *buf, size_t size, size_t top);
+  /// Render a compact "name=live/allocs" list for a text sensor, returns the length written
+  size_t summary_to(char *buf, size_t size, size_t top);
+
+  uint32_t get_untracked() const { return this->untracked_; }
+
+ protected:
+  struct Tracked {
+    uintptr_t ptr;
+    uint32_t size : 24;
+    uint32_t slot : 8;
+  };
+
+  uint8_t slot_for_(const Component *component);
+  size_t find_(uintptr_t ptr) const;
+  static const char *slot_name_(const HeapTraceEntry &entry);
+
+  Tracked tracked_[MAX_TRACKED]{};
+  HeapTraceEntry slots_[MAX_SLOTS]{};
+  const Component *last_component_{nullptr};
+  uint32_t tracked_count_{0};
+  uint32_t untracked_{0};
+  uint8_t slot_count_{2};
+  uint8_t last_slot_{SLOT_CORE};
+  bool running_{false};
+};
+
+/// Platform glue: remember the calling task as the main loop task and install the allocator hooks
+void heap_trace_platform_start();
+/// Platform lock around tracer state; the platform hooks hold it while calling record_alloc()/record_free()
+void heap_trace_lock();
+void heap_trace_unlock();
+
+extern HeapTracer global_heap_tracer;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace debug
+}  // namespace esphome
+#endif  // USE_DEBUG_HEAP_TRACE
@@ -0,0 +1,49 @@
+#include "heap_trace.h"
+#if defined(USE_ESP32) && defined(USE_DEBUG_HEAP_TRACE)
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef CONFIG_HEAP_USE_HOOKS
+#error "debug heap tracing requires CONFIG_HEAP_USE_HOOKS=y in sdkconfig"
+#endif
+
+namespace esphome {
+namespace debug {
+
+static portMUX_TYPE heap_trace_mux = portMUX_INITIALIZER_UNLOCKED;  // NOLINT
+static TaskHandle_t main_task = nullptr;                            // NOLINT
+
+void heap_trace_platform_start() { main_task = xTaskGetCurrentTaskHandle(); }
+void IRAM_ATTR heap_trace_lock() { taskENTER_CRITICAL(&heap_trace_mux); }
+void IRAM_ATTR heap_trace_unlock() { taskEXIT_CRITICAL(&heap_trace_mux); }
+
+}  // namespace debug
+}  // namespace esphome
+
+// ESP-IDF calls these after every heap_caps allocation and before every free when CONFIG_HEAP_USE_HOOKS is set.
+// They run on the allocating task, never from an ISR, and must not allocate themselves. The allocator is in IRAM and
+// may be called while the flash cache is disabled (a flash write, or code waiting on one), so the hooks, the lock and
+// HeapTracer's record path are IRAM_ATTR and touch only DRAM: the tracer, the mux and main_task are writable globals,
+// and xTaskGetCurrentTaskHandle() and the critical section are in IRAM with the default FreeRTOS placement.
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps) {
+  using esphome::debug::global_heap_tracer;
+  if (!global_heap_tracer.is_running())
+    return;
+  bool main = xTaskGetCurrentTaskHandle() == esphome::debug::main_task;
+  esphome::debug::heap_trace_lock();
+  global_heap_tracer.record_alloc(ptr, size, main);
+  esphome::debug::heap_trace_unlock();
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void *ptr) {
+  using esphome::debug::global_heap_tracer;
+  if (!global_heap_tracer.is_running())
+    return;
+  esphome::debug::heap_trace_lock();
+  global_heap_tracer.record_free(ptr);
+  esphome::debug::heap_trace_unlock();
+}
+
+#endif  // USE_ESP32 && USE_DEBUG_HEAP_TRACE
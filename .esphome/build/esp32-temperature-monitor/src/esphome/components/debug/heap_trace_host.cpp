@@ -0,0 +1,71 @@
+#include "heap_trace.h"
+#if defined(USE_HOST) && defined(USE_DEBUG_HEAP_TRACE)
+#include <atomic>
+#include <pthread.h>
+
+// glibc's real allocator entry points; the definitions below interpose the public names
+extern "C" void *__libc_malloc(size_t size);                // NOLINT
+extern "C" void *__libc_calloc(size_t count, size_t size);  // NOLINT
+extern "C" void *__libc_realloc(void *ptr, size_t size);    // NOLINT
+extern "C" void __libc_free(void *ptr);                     // NOLINT
+
+namespace esphome {
+namespace debug {
+
+static std::atomic_flag heap_trace_flag = ATOMIC_FLAG_INIT;  // NOLINT
+static pthread_t main_thread;                                // NOLINT
+
+void heap_trace_platform_start() { main_thread = pthread_self(); }
+void heap_trace_lock() {
+  while (heap_trace_flag.test_and_set(std::memory_order_acquire)) {
+  }
+}
+void heap_trace_unlock() { heap_trace_flag.clear(std::memory_order_release); }
+
+static void trace_alloc(void *ptr, size_t size) {
+  if (!global_heap_tracer.is_running())
+    return;
+  bool main = pthread_equal(pthread_self(), main_thread);
+  heap_trace_lock();
+  global_heap_tracer.record_alloc(ptr, size, main);
+  heap_trace_unlock();
+}
+
+static void trace_free(void *ptr) {
+  if (!global_heap_tracer.is_running())
+    return;
+  heap_trace_lock();
+  global_heap_tracer.record_free(ptr);
+  heap_trace_unlock();
+}
+
+}  // namespace debug
+}  // namespace esphome
+
+extern "C" void *malloc(size_t size) {
+  void *ptr = __libc_malloc(size);
+  esphome::debug::trace_alloc(ptr, size);
+  return ptr;
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+  void *ptr = __libc_calloc(count, size);
+  esphome::debug::trace_alloc(ptr, count * size);
+  return ptr;
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+  void *result = __libc_realloc(ptr, size);
+  // On failure the original block stays live and keeps its entry; realloc(ptr, 0) frees it
+  if (result != nullptr || size == 0)
+    esphome::debug::trace_free(ptr);
+  esphome::debug::trace_alloc(result, size);
+  return result;
+}
+
+extern "C" void free(void *ptr) {
+  esphome::debug::trace_free(ptr);
+  __libc_free(ptr);
+}
+
+#endif  // USE_HOST && USE_DEBUG_HEAP_TRACE
@@ -313,6 +313,15 @@ void ESPHomeOTAComponent::handle_data_() {
       ESP_LOGW(TAG, "Remote closed");
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
+    // Top up the chunk with data the network stack has already received, so the MD5 update and flash write run once
+    // per full chunk instead of once per TCP segment. Both still run synchronously on this task. Errors and EOF are
+    // left for the next read above to report.
+    while (static_cast<size_t>(read) < requested) {
+      ssize_t more = this->client_->read(buf + read, requested - read);
+      if (more <= 0)
+        break;
+      read += more;
+    }
 
     error_code = this->backend_->write(buf, read);
     if (error_code != ota::OTA_RESPONSE_OK) {
@@ -642,8 +651,9 @@ bool ESPHomeOTAComponent::handle_auth_read_() {
   sha256::SHA256 hasher;
 
   hasher.init();
-  hasher.add(this->password_.c_str(), this->password_.length());
-  hasher.add(nonce, hex_size * 2);  // Add both nonce and cnonce (contiguous in buffer)
+  // Password, then nonce and cnonce (contiguous in buffer)
+  hasher.add({{reinterpret_cast<const uint8_t *>(this->password_.c_str()), this->password_.length()},
+              {reinterpret_cast<const uint8_t *>(nonce), hex_size * 2}});
   hasher.calculate();
 
   ESP_LOGV(TAG, "Auth: CNonce is %.*s", hex_size, cnonce);
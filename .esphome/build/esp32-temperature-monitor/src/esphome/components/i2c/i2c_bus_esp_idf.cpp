@@ -9,6 +9,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 
 namespace esphome {
 namespace i2c {
@@ -185,7 +186,14 @@ ErrorCode IDFI2CBus::write_readv(uint8_t address, const uint8_t *write_buffer, s
   }
   jobs[num_jobs++].command = I2C_MASTER_CMD_STOP;
   ESP_LOGV(TAG, "Sending %zu jobs", num_jobs);
+#ifdef USE_TRACE_RECORDER
+  const uint32_t trace_start = ESPHOME_TRACE_NOW();
+#endif
   esp_err_t err = i2c_master_execute_defined_operations(this->dev_, jobs, num_jobs, 100);
+  ESPHOME_TRACE(I2C_TRANSFER, this, "i2c", trace_start,
+                address | std::min<size_t>(write_count, 0xFF) << 8 | std::min<size_t>(read_count, 0xFF) << 16 |
+                    static_cast<uint32_t>(err != ESP_OK) << 24,
+                ESPHOME_TRACE_NOW() - trace_start);
   if (err == ESP_ERR_INVALID_STATE) {
     ESP_LOGV(TAG, "TX to %02X failed: not acked", address);
     return ERROR_NOT_ACKNOWLEDGED;
@@ -0,0 +1,85 @@
+#include "i2c_bus_host.h"
+
+#ifdef USE_HOST
+
+#include <cinttypes>
+#include "esphome/core/log.h"
+#include "esphome/core/trace.h"
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c.host";
+
+void HostI2CBus::setup() {
+  if (this->scan_) {
+    ESP_LOGV(TAG, "Scanning for devices");
+    this->i2c_scan_();
+  }
+}
+
+void HostI2CBus::dump_config() {
+  ESP_LOGCONFIG(TAG,
+                "I2C Bus (simulated):\n"
+                "  Port: %d\n"
+                "  Devices: %u",
+                this->port_, static_cast<unsigned>(this->devices_.size()));
+  for (auto *device : this->devices_) {
+    ESP_LOGCONFIG(TAG, "  Model at address 0x%02X", device->get_address());
+  }
+  if (this->scan_) {
+    ESP_LOGCONFIG(TAG, "Results from bus scan:");
+    if (this->scan_results_.empty()) {
+      ESP_LOGCONFIG(TAG, "Found no devices");
+    } else {
+      for (const auto &s : this->scan_results_) {
+        ESP_LOGCONFIG(TAG, "Found device at address 0x%02X", s.first);
+      }
+    }
+  }
+}
+
+I2CDeviceModel *HostI2CBus::find_device_(uint8_t address) const {
+  for (auto *device : this->devices_) {
+    if (device->get_address() == address)
+      return device;
+  }
+  return nullptr;
+}
+
+ErrorCode HostI2CBus::write_readv(uint8_t address, const uint8_t *write_buffer, size_t write_count,
+                                  uint8_t *read_buffer, size_t read_count) {
+  I2CDeviceModel *device = this->find_device_(address);
+  if (device == nullptr) {
+    this->unanswered_++;
+    ESP_LOGVV(TAG, "TX to %02X failed: no device model", address);
+    return ERROR_NOT_ACKNOWLEDGED;
+  }
+  // An address-only probe (bus scan) is acknowledged without reaching the model
+  if (write_count == 0 && read_count == 0)
+    return ERROR_OK;
+
+#ifdef USE_TRACE_RECORDER
+  const uint32_t trace_start = ESPHOME_TRACE_NOW();
+#endif
+  ErrorCode err = device->transfer(write_buffer, write_count, read_buffer, read_count);
+  ESPHOME_TRACE(I2C_TRANSFER, this, "i2c", trace_start,
+                address | std::min<size_t>(write_count, 0xFF) << 8 | std::min<size_t>(read_count, 0xFF) << 16 |
+                    static_cast<uint32_t>(err != ERROR_OK) << 24,
+                ESPHOME_TRACE_NOW() - trace_start);
+
+  I2CTrafficStats &stats = device->stats_;
+  stats.transactions++;
+  if (err != ERROR_OK) {
+    stats.errors++;
+    return err;
+  }
+  stats.bytes_written += write_count;
+  stats.bytes_read += read_count;
+  return ERROR_OK;
+}
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HOST
+
+#include "esphome/core/component.h"
+#include "i2c_bus.h"
+
+namespace esphome {
+namespace i2c {
+
+/// Traffic counters kept per simulated device
+struct I2CTrafficStats {
+  uint32_t transactions{0};
+  uint32_t bytes_written{0};
+  uint32_t bytes_read{0};
+  uint32_t errors{0};
+};
+
+/** A simulated device answering on a HostI2CBus.
+ *
+ * Each write_readv() addressed to the device becomes one transfer() call, so a model sees exactly the
+ * transactions the driver would put on the wire.
+ */
+class I2CDeviceModel {
+ public:
+  explicit I2CDeviceModel(uint8_t address) : address_(address) {}
+  virtual ~I2CDeviceModel() = default;
+
+  /// Handle one write-then-read transaction. Return ERROR_NOT_ACKNOWLEDGED to NACK it.
+  virtual ErrorCode transfer(const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                             size_t read_count) = 0;
+
+  uint8_t get_address() const { return this->address_; }
+  const I2CTrafficStats &get_stats() const { return this->stats_; }
+  void reset_stats() { this->stats_ = {}; }
+
+ protected:
+  friend class HostI2CBus;
+
+  uint8_t address_;
+  I2CTrafficStats stats_{};
+};
+
+/// I2C bus for the host platform that routes transactions to in-process device models
+class HostI2CBus : public InternalI2CBus, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  ErrorCode write_readv(uint8_t address, const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                        size_t read_count) override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  void set_scan(bool scan) { this->scan_ = scan; }
+  void set_port(int port) { this->port_ = port; }
+  /// Attach a device model; it answers for its address from then on
+  void add_device(I2CDeviceModel *device) { this->devices_.push_back(device); }
+
+  int get_port() const override { return this->port_; }
+  /// Transactions to addresses no model answers for
+  uint32_t get_unanswered() const { return this->unanswered_; }
+
+ protected:
+  I2CDeviceModel *find_device_(uint8_t address) const;
+
+  std::vector<I2CDeviceModel *> devices_;
+  uint32_t unanswered_{0};
+  int port_{0};
+};
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
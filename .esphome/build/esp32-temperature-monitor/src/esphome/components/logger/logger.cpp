@@ -1,5 +1,7 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
@@ -24,7 +26,7 @@ static const char *const TAG = "logger";
 //
 // Optimized for the common case: 99.9% of logs come from the main thread
 void HOT Logger::log_vprintf_(uint8_t level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag))
+  if (!this->is_enabled(level, tag))
     return;
 
 #if defined(USE_ESP32) || defined(USE_LIBRETINY)
@@ -120,7 +122,7 @@ void Logger::log_vprintf_non_main_thread_(uint8_t level, const char *tag, int li
 // Logging calls are NOT thread-safe: global_recursion_guard_ is a plain bool and tx_buffer_ has no locking.
 // Not a problem in practice yet since Zephyr has no API support (logs are console-only).
 void HOT Logger::log_vprintf_(uint8_t level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || global_recursion_guard_)
+  if (!this->is_enabled(level, tag) || global_recursion_guard_)
     return;
   // Other single-task platforms don't have thread names, so pass nullptr
   this->log_message_to_buffer_and_send_(global_recursion_guard_, level, tag, line, format, args, nullptr);
@@ -136,7 +138,7 @@ void HOT Logger::log_vprintf_(uint8_t level, const char *tag, int line, const ch
 //
 void Logger::log_vprintf_(uint8_t level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || global_recursion_guard_)
+  if (!this->is_enabled(level, tag) || global_recursion_guard_)
     return;
 
   this->log_message_to_buffer_and_send_(global_recursion_guard_, level, tag, line, format, args, nullptr);
@@ -145,13 +147,28 @@ void Logger::log_vprintf_(uint8_t level, const char *tag, int line, const __Flas
 
 inline uint8_t Logger::level_for(const char *tag) {
 #ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
-  auto it = this->log_levels_.find(tag);
-  if (it != this->log_levels_.end())
-    return it->second;
+  // TAG constants are usually the same pointer as the configured string, so try identity before strcmp
+  for (uint8_t i = 0; i < this->tag_count_; i++) {
+    if (this->tag_names_[i] == tag)
+      return this->tag_levels_[i];
+  }
+  for (uint8_t i = 0; i < this->tag_count_; i++) {
+    if (strcmp(this->tag_names_[i], tag) == 0)
+      return this->tag_levels_[i];
+  }
 #endif
   return this->current_level_;
 }
 
+inline bool Logger::is_enabled(uint8_t level, const char *tag) {
+#ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
+  // Only levels between the floor and the macro gate depend on the tag
+  if (level <= this->floor_level_)
+    return true;
+#endif
+  return level <= this->level_for(tag);
+}
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   // NOLINTNEXTLINE(cppcoreguidelines-owning-memory) - allocated once, never freed
@@ -217,7 +234,20 @@ void Logger::process_messages_() {
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 #ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
-void Logger::set_log_level(const char *tag, uint8_t log_level) { this->log_levels_[tag] = log_level; }
+void Logger::set_log_level(const char *tag, uint8_t log_level) {
+  uint8_t i = 0;
+  while (i < this->tag_count_ && strcmp(this->tag_names_[i], tag) != 0)
+    i++;
+  if (i == this->tag_count_) {
+    if (this->tag_count_ == ESPHOME_LOGGER_MAX_TAG_LEVELS) {
+      ESP_LOGW(TAG, "Too many tag levels, ignoring '%s'", tag);
+      return;
+    }
+    this->tag_names_[this->tag_count_++] = tag;
+  }
+  this->tag_levels_[i] = log_level;
+  this->update_active_level_();
+}
 #endif
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY) || defined(USE_ZEPHYR)
@@ -257,8 +287,9 @@ void Logger::dump_config() {
 #endif
 
 #ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
-  for (auto &it : this->log_levels_) {
-    ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.first, LOG_STR_ARG(get_log_level_str(it.second)));
+  for (uint8_t i = 0; i < this->tag_count_; i++) {
+    ESP_LOGCONFIG(TAG, "  Level for '%s': %s", this->tag_names_[i],
+                  LOG_STR_ARG(get_log_level_str(this->tag_levels_[i])));
   }
 #endif
 }
@@ -270,12 +301,26 @@ void Logger::set_log_level(uint8_t level) {
              LOG_STR_ARG(get_log_level_str(ESPHOME_LOG_LEVEL)));
   }
   this->current_level_ = level;
+  this->update_active_level_();
 #ifdef USE_LOGGER_LEVEL_LISTENERS
   for (auto *listener : this->level_listeners_)
     listener->on_log_level_change(level);
 #endif
 }
 
+void Logger::update_active_level_() {
+  uint8_t ceiling = this->current_level_;
+#ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
+  uint8_t floor = this->current_level_;
+  for (uint8_t i = 0; i < this->tag_count_; i++) {
+    ceiling = std::max(ceiling, this->tag_levels_[i]);
+    floor = std::min(floor, this->tag_levels_[i]);
+  }
+  this->floor_level_ = floor;
+#endif
+  esp_log_active_level = ceiling;
+}
+
 Logger *global_logger = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome::logger
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdarg>
-#include <map>
 #include <span>
 #include <type_traits>
 #if defined(USE_ESP32) || defined(USE_HOST)
@@ -87,10 +86,10 @@ class LoggerLevelListener {
 #endif
 
 #ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
-// Comparison function for const char* keys in log_levels_ map
-struct CStrCompare {
-  bool operator()(const char *a, const char *b) const { return strcmp(a, b) < 0; }
-};
+#ifndef ESPHOME_LOGGER_MAX_TAG_LEVELS
+// Tags with an explicit level come from the `logs:` config, so this only needs to cover that list
+#define ESPHOME_LOGGER_MAX_TAG_LEVELS 16
+#endif
 #endif
 
 // Stack buffer size for retrieving thread/task names from the OS
@@ -185,6 +184,8 @@ class Logger : public Component {
   void dump_config() override;
 
   inline uint8_t level_for(const char *tag);
+  /// Whether a message at level from tag should be logged
+  inline bool is_enabled(uint8_t level, const char *tag);
 
 #ifdef USE_LOG_LISTENERS
   /// Register a log listener to receive log messages
@@ -208,6 +209,8 @@ class Logger : public Component {
 #endif
 
  protected:
+  /// Recompute the level gate checked inline by the log macros after any level change
+  void update_active_level_();
   // RAII guard for recursion flags - sets flag on construction, clears on destruction
   class RecursionGuard {
    public:
@@ -338,7 +341,9 @@ class Logger : public Component {
 
   // Large objects (internally aligned)
 #ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
-  std::map<const char *, uint8_t, CStrCompare> log_levels_{};
+  // Per-tag levels as parallel flat arrays; the slot index is the tag's ID
+  const char *tag_names_[ESPHOME_LOGGER_MAX_TAG_LEVELS];
+  uint8_t tag_levels_[ESPHOME_LOGGER_MAX_TAG_LEVELS];
 #endif
 #ifdef USE_LOG_LISTENERS
   StaticVector<LogListener *, ESPHOME_LOG_MAX_LISTENERS>
@@ -354,6 +359,11 @@ class Logger : public Component {
   // Group smaller types together at the end
   uint16_t tx_buffer_size_{0};
   uint8_t current_level_{ESPHOME_LOG_LEVEL_VERY_VERBOSE};
+#ifdef USE_LOGGER_RUNTIME_TAG_LEVELS
+  uint8_t tag_count_{0};
+  // Least verbose of the default and all tag levels: anything at or below it is enabled for every tag
+  uint8_t floor_level_{ESPHOME_LOG_LEVEL_VERY_VERBOSE};
+#endif
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_ZEPHYR)
   UARTSelection uart_{UART_SELECTION_UART0};
 #endif
@@ -91,6 +91,11 @@ class MDNSComponent : public Component {
   /// Helper to set up services and MAC buffers, then call platform-specific registration
   using PlatformRegisterFn = void (*)(MDNSComponent *, StaticVector<MDNSService, MDNS_SERVICE_COUNT> &);
 
+#ifdef USE_HOST
+  /// Drain pending queries and answer matching ones from the pre-serialized packet (see mdns_packet.h)
+  void respond_();
+#endif
+
   void setup_buffers_and_register_(PlatformRegisterFn platform_register) {
 #ifdef USE_MDNS_STORE_SERVICES
     auto &services = this->services_;
@@ -0,0 +1,148 @@
+#include "esphome/core/defines.h"
+#if defined(USE_HOST) && defined(USE_MDNS)
+
+// Host-only mDNS responder. ESP32 registers its records with the ESP-IDF responder instead (mdns_esp32.cpp), so
+// nothing here is compiled into the firmware.
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+#include "mdns_component.h"
+#include "mdns_packet.h"
+
+namespace esphome::mdns {
+
+static const char *const TAG = "mdns";
+
+static constexpr uint16_t MDNS_PORT = 5353;
+static constexpr const char *MDNS_GROUP = "224.0.0.251";
+// A query is never larger than one Ethernet frame in practice
+static constexpr size_t QUERY_BUFFER_SIZE = 1500;
+
+/// Lightweight responder: every multicast answer is the same pre-serialized packet, so a query costs one name
+/// match and one sendto(). Legacy unicast queries get a reply built from it with the question echoed.
+static MDNSAnswerPacket answer_packet;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int responder_fd = -1;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// The echoed question section is bounded by the query size
+static uint8_t unicast_reply[QUERY_BUFFER_SIZE + MDNSAnswerPacket::MAX_PACKET_SIZE];  // NOLINT
+
+/// First non-loopback IPv4 address of the host, or 0.0.0.0 if there is none.
+static void get_host_ipv4(uint8_t *ipv4) {
+  memset(ipv4, 0, 4);
+  struct ifaddrs *addrs;
+  if (getifaddrs(&addrs) != 0)
+    return;
+  for (struct ifaddrs *it = addrs; it != nullptr; it = it->ifa_next) {
+    if (it->ifa_addr == nullptr || it->ifa_addr->sa_family != AF_INET || (it->ifa_flags & IFF_LOOPBACK) != 0)
+      continue;
+    memcpy(ipv4, &reinterpret_cast<struct sockaddr_in *>(it->ifa_addr)->sin_addr, 4);
+    break;
+  }
+  freeifaddrs(addrs);
+}
+
+static int open_responder_socket() {
+  int fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (fd < 0)
+    return -1;
+  int enable = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#ifdef SO_REUSEPORT
+  setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+#endif
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(MDNS_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  struct ip_mreq mreq {};
+  inet_pton(AF_INET, MDNS_GROUP, &mreq.imr_multiaddr);
+  mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+  if (::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0 ||
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static void register_host(MDNSComponent *comp, StaticVector<MDNSService, MDNS_SERVICE_COUNT> &services) {
+  uint8_t ipv4[4];
+  get_host_ipv4(ipv4);
+  // TXT values may point at setup-time buffers; they are copied into the packet here and not referenced again
+  if (!answer_packet.build(App.get_name().c_str(), ipv4, services)) {
+    ESP_LOGW(TAG, "Records exceed %zu bytes", MDNSAnswerPacket::MAX_PACKET_SIZE);
+    comp->mark_failed();
+    return;
+  }
+  responder_fd = open_responder_socket();
+  if (responder_fd < 0) {
+    ESP_LOGW(TAG, "Could not open responder socket: %s", strerror(errno));
+    comp->mark_failed();
+    return;
+  }
+  ESP_LOGD(TAG, "Answer packet: %zu bytes", answer_packet.size());
+}
+
+void MDNSComponent::setup() {
+  this->setup_buffers_and_register_(register_host);
+  if (this->is_failed())
+    return;
+  this->set_interval(MDNS_UPDATE_INTERVAL_MS, [this]() { this->respond_(); });
+}
+
+void MDNSComponent::respond_() {
+  uint8_t query[QUERY_BUFFER_SIZE];
+  bool address_checked = false;
+  for (;;) {
+    struct sockaddr_in source {};
+    socklen_t source_len = sizeof(source);
+    ssize_t len = ::recvfrom(responder_fd, query, sizeof(query), 0, reinterpret_cast<struct sockaddr *>(&source),
+                             &source_len);
+    if (len <= 0)
+      return;
+    if (!answer_packet.answers_query(query, len))
+      continue;
+    if (!address_checked) {
+      // Address changes only touch the four A record bytes
+      uint8_t ipv4[4];
+      get_host_ipv4(ipv4);
+      answer_packet.set_address(ipv4);
+      address_checked = true;
+    }
+    if (ntohs(source.sin_port) != MDNS_PORT) {
+      // Legacy unicast query (RFC 6762 Section 6.7): reply directly to the querier's port
+      size_t reply_len = answer_packet.build_unicast_reply(query, len, unicast_reply, sizeof(unicast_reply));
+      if (reply_len != 0) {
+        ::sendto(responder_fd, unicast_reply, reply_len, 0, reinterpret_cast<struct sockaddr *>(&source),
+                 sizeof(source));
+      }
+      continue;
+    }
+    struct sockaddr_in dest {};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(MDNS_PORT);
+    inet_pton(AF_INET, MDNS_GROUP, &dest.sin_addr);
+    ::sendto(responder_fd, answer_packet.data(), answer_packet.size(), 0, reinterpret_cast<struct sockaddr *>(&dest),
+             sizeof(dest));
+  }
+}
+
+void MDNSComponent::on_shutdown() {
+  if (responder_fd >= 0) {
+    ::close(responder_fd);
+    responder_fd = -1;
+  }
+}
+
+}  // namespace esphome::mdns
+
+#endif  // USE_HOST
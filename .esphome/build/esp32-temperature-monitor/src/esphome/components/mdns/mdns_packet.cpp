@@ -0,0 +1,286 @@
+#include "esphome/core/defines.h"
+#ifdef USE_MDNS
+#include "mdns_packet.h"
+#include <cstring>
+
+namespace esphome::mdns {
+
+static constexpr uint16_t TYPE_A = 1;
+static constexpr uint16_t TYPE_PTR = 12;
+static constexpr uint16_t TYPE_TXT = 16;
+static constexpr uint16_t TYPE_SRV = 33;
+static constexpr uint16_t CLASS_IN = 0x0001;
+static constexpr uint16_t CLASS_CACHE_FLUSH = 0x8000;
+// RFC 6762 Section 10: 120s for records containing a host name, 75 minutes for the rest
+static constexpr uint32_t TTL_HOST = 120;
+static constexpr uint32_t TTL_OTHER = 4500;
+static constexpr size_t HEADER_SIZE = 12;
+static constexpr size_t MAX_NAME_LEN = 255;
+static constexpr uint8_t MAX_POINTER_HOPS = 16;
+
+static const char LOCAL_LABEL[] = "local";
+
+static inline char to_lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c; }
+
+/// Decode the (possibly compressed) name at pos into dotted, lowercase form and advance pos past it.
+static bool read_name(const uint8_t *buf, size_t len, size_t &pos, char *out, size_t &out_len) {
+  size_t at = pos;
+  bool jumped = false;
+  uint8_t hops = 0;
+  out_len = 0;
+  while (at < len) {
+    uint8_t label_len = buf[at];
+    if (label_len == 0) {
+      if (!jumped)
+        pos = at + 1;
+      return true;
+    }
+    if ((label_len & 0xC0) == 0xC0) {
+      if (at + 1 >= len || ++hops > MAX_POINTER_HOPS)
+        return false;
+      if (!jumped)
+        pos = at + 2;
+      jumped = true;
+      at = ((label_len & 0x3F) << 8) | buf[at + 1];
+      continue;
+    }
+    if ((label_len & 0xC0) != 0 || at + 1 + label_len > len || out_len + label_len + 1 > MAX_NAME_LEN)
+      return false;
+    if (out_len > 0)
+      out[out_len++] = '.';
+    for (uint8_t i = 0; i < label_len; i++)
+      out[out_len++] = to_lower(static_cast<char>(buf[at + 1 + i]));
+    at += 1 + label_len;
+  }
+  return false;
+}
+
+bool MDNSAnswerPacket::write_u8_(uint8_t value) {
+  if (this->size_ + 1 > MAX_PACKET_SIZE)
+    return false;
+  this->buffer_[this->size_++] = value;
+  return true;
+}
+
+bool MDNSAnswerPacket::write_u16_(uint16_t value) {
+  if (this->size_ + 2 > MAX_PACKET_SIZE)
+    return false;
+  this->buffer_[this->size_++] = value >> 8;
+  this->buffer_[this->size_++] = value & 0xFF;
+  return true;
+}
+
+bool MDNSAnswerPacket::write_u32_(uint32_t value) { return this->write_u16_(value >> 16) && this->write_u16_(value); }
+
+bool MDNSAnswerPacket::write_label_(const char *label, size_t len) {
+  if (len == 0 || len > 63 || this->size_ + 1 + len > MAX_PACKET_SIZE)
+    return false;
+  this->buffer_[this->size_++] = static_cast<uint8_t>(len);
+  memcpy(this->buffer_ + this->size_, label, len);
+  this->size_ += len;
+  return true;
+}
+
+bool MDNSAnswerPacket::write_pointer_(uint16_t offset) {
+  if (this->pointer_count_ >= MAX_POINTERS)
+    return false;
+  this->pointers_[this->pointer_count_++] = this->size_;
+  return this->write_u16_(0xC000 | offset);
+}
+
+bool MDNSAnswerPacket::begin_record_(uint16_t type, bool cache_flush, uint32_t ttl, size_t &rdlength_at) {
+  if (this->record_count_ >= MAX_RECORDS)
+    return false;
+  this->records_[this->record_count_++] = this->size_;
+  if (!this->write_u16_(type) || !this->write_u16_(CLASS_IN | (cache_flush ? CLASS_CACHE_FLUSH : 0)) ||
+      !this->write_u32_(ttl))
+    return false;
+  rdlength_at = this->size_;
+  return this->write_u16_(0);
+}
+
+void MDNSAnswerPacket::end_rdata_(size_t rdlength_at) {
+  size_t rdlength = this->size_ - rdlength_at - 2;
+  this->buffer_[rdlength_at] = rdlength >> 8;
+  this->buffer_[rdlength_at + 1] = rdlength & 0xFF;
+}
+
+bool MDNSAnswerPacket::build(const char *hostname, const uint8_t *ipv4,
+                             const StaticVector<MDNSService, MDNS_SERVICE_COUNT> &services) {
+  if (this->build_records_(hostname, ipv4, services))
+    return true;
+  this->size_ = 0;
+  this->owner_name_count_ = 0;
+  this->record_count_ = 0;
+  this->pointer_count_ = 0;
+  return false;
+}
+
+bool MDNSAnswerPacket::build_records_(const char *hostname, const uint8_t *ipv4,
+                                      const StaticVector<MDNSService, MDNS_SERVICE_COUNT> &services) {
+  size_t hostname_len = strlen(hostname);
+  uint16_t answers = 0;
+  size_t rdlength_at;
+  this->owner_name_count_ = 0;
+  this->record_count_ = 0;
+  this->pointer_count_ = 0;
+
+  // Header: response, authoritative answer; ID stays 0 for multicast replies
+  memset(this->buffer_, 0, HEADER_SIZE);
+  this->buffer_[2] = 0x84;
+  this->size_ = HEADER_SIZE;
+
+  // A: <hostname>.local
+  uint16_t host_name_at = this->size_;
+  uint16_t local_at = host_name_at + 1 + hostname_len;
+  if (!this->write_label_(hostname, hostname_len) || !this->write_label_(LOCAL_LABEL, sizeof(LOCAL_LABEL) - 1) ||
+      !this->write_u8_(0) || !this->begin_record_(TYPE_A, true, TTL_HOST, rdlength_at) ||
+      this->size_ + 4 > MAX_PACKET_SIZE)
+    return false;
+  this->address_at_ = this->size_;
+  memcpy(this->buffer_ + this->size_, ipv4, 4);
+  this->size_ += 4;
+  this->end_rdata_(rdlength_at);
+  this->owner_names_[this->owner_name_count_++] = host_name_at;
+  answers++;
+
+  for (const auto &service : services) {
+    const char *service_type = MDNS_STR_ARG(service.service_type);
+    const char *proto = MDNS_STR_ARG(service.proto);
+    uint16_t port = const_cast<TemplatableValue<uint16_t> &>(service.port).value();
+
+    // PTR: <service>.<proto>.local -> <hostname>.<service>.<proto>.local
+    uint16_t service_name_at = this->size_;
+    if (!this->write_label_(service_type, strlen(service_type)) || !this->write_label_(proto, strlen(proto)) ||
+        !this->write_pointer_(local_at) || !this->begin_record_(TYPE_PTR, false, TTL_OTHER, rdlength_at))
+      return false;
+    uint16_t instance_name_at = this->size_;
+    if (!this->write_label_(hostname, hostname_len) || !this->write_pointer_(service_name_at))
+      return false;
+    this->end_rdata_(rdlength_at);
+
+    // SRV: instance -> priority 0, weight 0, port, <hostname>.local
+    if (!this->write_pointer_(instance_name_at) || !this->begin_record_(TYPE_SRV, true, TTL_HOST, rdlength_at) ||
+        !this->write_u16_(0) || !this->write_u16_(0) || !this->write_u16_(port) || !this->write_pointer_(host_name_at))
+      return false;
+    this->end_rdata_(rdlength_at);
+
+    // TXT: instance -> key=value strings; an empty TXT record is a single zero-length string
+    if (!this->write_pointer_(instance_name_at) || !this->begin_record_(TYPE_TXT, true, TTL_OTHER, rdlength_at))
+      return false;
+    for (const auto &record : service.txt_records) {
+      const char *key = MDNS_STR_ARG(record.key);
+      const char *value = MDNS_STR_ARG(record.value);
+      size_t key_len = strlen(key);
+      size_t value_len = strlen(value);
+      size_t entry_len = key_len + 1 + value_len;
+      if (entry_len > 255 || this->size_ + 1 + entry_len > MAX_PACKET_SIZE)
+        return false;
+      uint8_t *out = this->buffer_ + this->size_;
+      *out++ = static_cast<uint8_t>(entry_len);
+      memcpy(out, key, key_len);
+      out[key_len] = '=';
+      memcpy(out + key_len + 1, value, value_len);
+      this->size_ += 1 + entry_len;
+    }
+    if (service.txt_records.empty() && !this->write_u8_(0))
+      return false;
+    this->end_rdata_(rdlength_at);
+
+    this->owner_names_[this->owner_name_count_++] = service_name_at;
+    this->owner_names_[this->owner_name_count_++] = instance_name_at;
+    answers += 3;
+  }
+
+  this->buffer_[6] = answers >> 8;
+  this->buffer_[7] = answers & 0xFF;
+  return true;
+}
+
+bool MDNSAnswerPacket::set_address(const uint8_t *ipv4) {
+  if (this->empty() || memcmp(this->buffer_ + this->address_at_, ipv4, 4) == 0)
+    return false;
+  memcpy(this->buffer_ + this->address_at_, ipv4, 4);
+  return true;
+}
+
+/// Advance pos past `count` questions. Returns false if the section is truncated or malformed.
+static bool skip_questions(const uint8_t *query, size_t len, uint16_t count, size_t &pos) {
+  char name[MAX_NAME_LEN];
+  for (uint16_t q = 0; q < count; q++) {
+    size_t name_len;
+    if (!read_name(query, len, pos, name, name_len) || pos + 4 > len)
+      return false;
+    pos += 4;  // QTYPE, QCLASS
+  }
+  return true;
+}
+
+bool MDNSAnswerPacket::answers_query(const uint8_t *query, size_t len) const {
+  // Only standard queries (QR=0, OPCODE=0) with at least one question
+  if (this->empty() || len < HEADER_SIZE || (query[2] & 0xF8) != 0)
+    return false;
+  uint16_t questions = (query[4] << 8) | query[5];
+  size_t pos = HEADER_SIZE;
+  char question[MAX_NAME_LEN];
+  char owner[MAX_NAME_LEN];
+  for (uint16_t q = 0; q < questions; q++) {
+    size_t question_len;
+    if (!read_name(query, len, pos, question, question_len) || pos + 4 > len)
+      return false;
+    pos += 4;  // QTYPE, QCLASS
+    for (uint8_t i = 0; i < this->owner_name_count_; i++) {
+      size_t owner_pos = this->owner_names_[i];
+      size_t owner_len;
+      if (read_name(this->buffer_, this->size_, owner_pos, owner, owner_len) && owner_len == question_len &&
+          memcmp(owner, question, owner_len) == 0)
+        return true;
+    }
+  }
+  return false;
+}
+
+size_t MDNSAnswerPacket::build_unicast_reply(const uint8_t *query, size_t len, uint8_t *out, size_t capacity) const {
+  if (this->empty() || len < HEADER_SIZE)
+    return 0;
+  uint16_t questions = (query[4] << 8) | query[5];
+  size_t questions_end = HEADER_SIZE;
+  if (!skip_questions(query, len, questions, questions_end))
+    return 0;
+  const size_t question_len = questions_end - HEADER_SIZE;
+  const size_t reply_len = this->size_ + question_len;
+  // Relocated pointers must stay within the 14-bit offset range
+  if (reply_len > capacity || reply_len > 0x3FFF)
+    return 0;
+
+  // Header: the query ID, our flags and answer count, and the query's question count
+  memcpy(out, this->buffer_, HEADER_SIZE);
+  out[0] = query[0];
+  out[1] = query[1];
+  out[4] = query[4];
+  out[5] = query[5];
+  // The question section keeps its offset, so compression pointers inside it stay valid
+  memcpy(out + HEADER_SIZE, query + HEADER_SIZE, question_len);
+  memcpy(out + questions_end, this->buffer_ + HEADER_SIZE, this->size_ - HEADER_SIZE);
+
+  // Every pointer in our records targets an offset behind the header, which moved by question_len
+  for (uint8_t i = 0; i < this->pointer_count_; i++) {
+    uint8_t *pointer = out + this->pointers_[i] + question_len;
+    uint16_t target = (((pointer[0] & 0x3F) << 8) | pointer[1]) + question_len;
+    pointer[0] = 0xC0 | (target >> 8);
+    pointer[1] = target & 0xFF;
+  }
+  for (uint8_t i = 0; i < this->record_count_; i++) {
+    uint8_t *record = out + this->records_[i] + question_len;
+    record[2] &= ~(CLASS_CACHE_FLUSH >> 8);
+    uint32_t ttl = (uint32_t(record[4]) << 24) | (uint32_t(record[5]) << 16) | (uint32_t(record[6]) << 8) | record[7];
+    if (ttl > LEGACY_UNICAST_TTL) {
+      record[4] = record[5] = record[6] = 0;
+      record[7] = LEGACY_UNICAST_TTL;
+    }
+  }
+  return reply_len;
+}
+
+}  // namespace esphome::mdns
+#endif  // USE_MDNS
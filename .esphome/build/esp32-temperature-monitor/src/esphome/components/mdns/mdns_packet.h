@@ -0,0 +1,71 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_MDNS
+#include <cstddef>
+#include <cstdint>
+#include "mdns_component.h"
+
+namespace esphome::mdns {
+
+/// Pre-serialized mDNS response carrying every record this node advertises. Only the host responder
+/// (mdns_host.cpp) uses it; the other platforms hand their records to the SDK responder.
+///
+/// The packet is built once from the compiled services (A, then PTR/SRV/TXT per service) and answered from
+/// as-is for every matching multicast query. The A record sits at a fixed offset so an address change only patches
+/// four bytes; TXT data is fixed after setup, so a full rebuild is only needed if the service set changes.
+class MDNSAnswerPacket {
+ public:
+  static constexpr size_t MAX_PACKET_SIZE = 1024;
+  /// Upper bound on owner names matched against incoming questions (host + 2 per service)
+  static constexpr size_t MAX_OWNER_NAMES = 1 + 2 * MDNS_SERVICE_COUNT;
+  /// A, then PTR/SRV/TXT per service
+  static constexpr size_t MAX_RECORDS = 1 + 3 * MDNS_SERVICE_COUNT;
+  /// Name compression pointers written per service (PTR owner and target, SRV owner and target, TXT owner)
+  static constexpr size_t MAX_POINTERS = 5 * MDNS_SERVICE_COUNT;
+  /// TTL cap for legacy unicast replies (RFC 6762 Section 6.7)
+  static constexpr uint32_t LEGACY_UNICAST_TTL = 10;
+
+  /// Serialize all records. Returns false (and leaves the packet empty) if they don't fit MAX_PACKET_SIZE.
+  bool build(const char *hostname, const uint8_t *ipv4, const StaticVector<MDNSService, MDNS_SERVICE_COUNT> &services);
+  /// Patch the A record in place. Returns true if the address changed.
+  bool set_address(const uint8_t *ipv4);
+
+  /// Return true if any question in the query names one of our records.
+  bool answers_query(const uint8_t *query, size_t len) const;
+
+  /// Build the reply to a legacy unicast query (RFC 6762 Section 6.7) into `out`: the query ID and question
+  /// section are echoed, followed by every record with the cache-flush bit cleared and the TTL capped at
+  /// LEGACY_UNICAST_TTL. Returns the reply size, or 0 if the query can't be parsed or the reply doesn't fit.
+  size_t build_unicast_reply(const uint8_t *query, size_t len, uint8_t *out, size_t capacity) const;
+
+  const uint8_t *data() const { return this->buffer_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+
+ protected:
+  bool build_records_(const char *hostname, const uint8_t *ipv4,
+                      const StaticVector<MDNSService, MDNS_SERVICE_COUNT> &services);
+  bool write_u8_(uint8_t value);
+  bool write_u16_(uint16_t value);
+  bool write_u32_(uint32_t value);
+  bool write_label_(const char *label, size_t len);
+  bool write_pointer_(uint16_t offset);
+  /// Write TYPE, CLASS and TTL; returns the RDLENGTH offset to patch via end_rdata_()
+  bool begin_record_(uint16_t type, bool cache_flush, uint32_t ttl, size_t &rdlength_at);
+  void end_rdata_(size_t rdlength_at);
+
+  uint8_t buffer_[MAX_PACKET_SIZE];
+  size_t size_{0};
+  size_t address_at_{0};
+  uint16_t owner_names_[MAX_OWNER_NAMES];
+  uint8_t owner_name_count_{0};
+  // Offsets of each record's TYPE field and of each compression pointer, for relocating the records behind an
+  // echoed question section
+  uint16_t records_[MAX_RECORDS];
+  uint8_t record_count_{0};
+  uint16_t pointers_[MAX_POINTERS];
+  uint8_t pointer_count_{0};
+};
+
+}  // namespace esphome::mdns
+#endif  // USE_MDNS
@@ -3,6 +3,7 @@
 #include "esphome/core/controller_registry.h"
 #include "esphome/core/log.h"
 #include "esphome/core/progmem.h"
+#include "esphome/core/trace.h"
 
 namespace esphome::sensor {
 
@@ -63,6 +64,7 @@ StateClass Sensor::get_state_class() {
 }
 
 void Sensor::publish_state(float state) {
+  ESPHOME_TRACE(SENSOR_PUBLISH, this, this->name_.c_str(), ESPHOME_TRACE_NOW(), bit_cast<uint32_t>(state), 0);
   this->raw_state = state;
   this->raw_callback_.call(state);
 
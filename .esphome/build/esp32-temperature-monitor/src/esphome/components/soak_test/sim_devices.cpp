@@ -0,0 +1,126 @@
+#include "sim_devices.h"
+
+#ifdef USE_HOST
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome::soak_test {
+
+static constexpr uint8_t AHT10_CMD_INITIALIZE = 0xE1;
+static constexpr uint8_t AHT20_CMD_INITIALIZE = 0xBE;
+static constexpr uint8_t AHT10_CMD_MEASURE = 0xAC;
+static constexpr uint8_t AHT10_CMD_SOFTRESET = 0xBA;
+static constexpr uint8_t AHT10_STATUS_BUSY = 0x80;
+static constexpr uint8_t AHT10_STATUS_CALIBRATED = 0x08;
+static constexpr float AHT10_SCALE = 1048576.0f;  // 2^20
+
+static constexpr uint8_t SSD1306_CONTROL_DATA = 0x40;
+
+float AHT10Model::wave_(float base, float amplitude) const {
+  float phase = static_cast<float>(millis() % this->period_ms_) / static_cast<float>(this->period_ms_);
+  return base + amplitude * sinf(phase * 2.0f * static_cast<float>(M_PI));
+}
+
+i2c::ErrorCode AHT10Model::transfer(const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                                    size_t read_count) {
+  if (write_count > 0) {
+    switch (write_buffer[0]) {
+      case AHT10_CMD_SOFTRESET:
+        this->calibrated_ = false;
+        this->converting_ = false;
+        break;
+      case AHT10_CMD_INITIALIZE:
+      case AHT20_CMD_INITIALIZE:
+        this->calibrated_ = true;
+        break;
+      case AHT10_CMD_MEASURE:
+        this->converting_ = true;
+        this->conversion_start_ = millis();
+        break;
+      default:
+        return i2c::ERROR_NOT_ACKNOWLEDGED;
+    }
+  }
+  if (read_count == 0)
+    return i2c::ERROR_OK;
+
+  if (this->converting_ && millis() - this->conversion_start_ >= CONVERSION_TIME_MS) {
+    this->converting_ = false;
+    this->measurements_++;
+  }
+  uint8_t status = this->calibrated_ ? AHT10_STATUS_CALIBRATED : 0;
+  if (this->converting_)
+    status |= AHT10_STATUS_BUSY;
+
+  // Inverse of the driver's conversion: T = raw * 200 / 2^20 - 50, RH = raw * 100 / 2^20
+  float humidity = clamp(this->wave_(this->humidity_, this->humidity_amplitude_), 0.1f, 100.0f);
+  float temperature = clamp(this->wave_(this->temperature_, this->temperature_amplitude_), -50.0f, 150.0f);
+  uint32_t raw_humidity = std::min<uint32_t>(humidity * AHT10_SCALE / 100.0f, 0xFFFFF);
+  uint32_t raw_temperature = std::min<uint32_t>((temperature + 50.0f) * AHT10_SCALE / 200.0f, 0xFFFFF);
+  const uint8_t frame[6] = {
+      status,
+      static_cast<uint8_t>(raw_humidity >> 12),
+      static_cast<uint8_t>(raw_humidity >> 4),
+      static_cast<uint8_t>((raw_humidity & 0x0F) << 4 | raw_temperature >> 16),
+      static_cast<uint8_t>(raw_temperature >> 8),
+      static_cast<uint8_t>(raw_temperature),
+  };
+  for (size_t i = 0; i < read_count; i++)
+    read_buffer[i] = i < sizeof(frame) ? frame[i] : 0;
+  return i2c::ERROR_OK;
+}
+
+i2c::ErrorCode SSD1306Model::transfer(const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                                      size_t read_count) {
+  if (read_count > 0)
+    return i2c::ERROR_NOT_ACKNOWLEDGED;  // The controller is write-only over I2C
+  if (write_count < 2)
+    return i2c::ERROR_OK;
+  // The first byte is the control byte: Co = 0, D/C# selects data (0x40) or command (0x00)
+  if ((write_buffer[0] & SSD1306_CONTROL_DATA) != 0) {
+    this->data_bytes_ += write_count - 1;
+  } else {
+    this->command_bytes_ += write_count - 1;
+  }
+  return i2c::ERROR_OK;
+}
+
+void ScriptedPin::set_script(std::vector<PinStep> steps) {
+  this->steps_ = std::move(steps);
+  this->cycle_ms_ = 0;
+  for (const auto &step : this->steps_)
+    this->cycle_ms_ += step.duration_ms;
+  this->started_ = false;
+}
+
+bool ScriptedPin::digital_read() {
+  if (this->cycle_ms_ == 0)
+    return false;
+  const uint32_t now = millis();
+  if (!this->started_) {
+    this->start_ = now;
+    this->started_ = true;
+  }
+  uint32_t offset = (now - this->start_) % this->cycle_ms_;
+  for (const auto &step : this->steps_) {
+    if (offset < step.duration_ms)
+      return step.level;
+    offset -= step.duration_ms;
+  }
+  return this->steps_.back().level;
+}
+
+size_t ScriptedPin::dump_summary(char *buffer, size_t len) const {
+  return snprintf(buffer, len, "scripted (%u steps, %" PRIu32 " ms cycle)", static_cast<unsigned>(this->steps_.size()),
+                  this->cycle_ms_);
+}
+
+}  // namespace esphome::soak_test
+
+#endif  // USE_HOST
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HOST
+
+#include <vector>
+#include "esphome/components/i2c/i2c_bus_host.h"
+#include "esphome/core/gpio.h"
+
+namespace esphome::soak_test {
+
+/** AHT10/AHT20 model.
+ *
+ * Follows the command set the aht10 driver uses: soft reset, initialize (sets the calibrated bit), and
+ * measure, after which the status reads busy for the conversion time. Readings trace a slow sine wave
+ * so consecutive samples differ and downstream filters and publishers see real traffic.
+ */
+class AHT10Model : public i2c::I2CDeviceModel {
+ public:
+  static constexpr uint32_t CONVERSION_TIME_MS = 75;
+
+  explicit AHT10Model(uint8_t address = 0x38) : I2CDeviceModel(address) {}
+
+  i2c::ErrorCode transfer(const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                          size_t read_count) override;
+
+  void set_temperature(float base, float amplitude) {
+    this->temperature_ = base;
+    this->temperature_amplitude_ = amplitude;
+  }
+  void set_humidity(float base, float amplitude) {
+    this->humidity_ = base;
+    this->humidity_amplitude_ = amplitude;
+  }
+  /// Period of the simulated waveform
+  void set_period(uint32_t period_ms) { this->period_ms_ = period_ms; }
+
+  uint32_t get_measurements() const { return this->measurements_; }
+
+ protected:
+  float wave_(float base, float amplitude) const;
+
+  float temperature_{22.0f};
+  float temperature_amplitude_{3.0f};
+  float humidity_{45.0f};
+  float humidity_amplitude_{10.0f};
+  uint32_t period_ms_{600000};
+  uint32_t conversion_start_{0};
+  uint32_t measurements_{0};
+  bool calibrated_{false};
+  bool converting_{false};
+};
+
+/// SSD1306/SH1106 model: accepts the control-byte framed command and data writes and counts them
+class SSD1306Model : public i2c::I2CDeviceModel {
+ public:
+  explicit SSD1306Model(uint8_t address = 0x3C) : I2CDeviceModel(address) {}
+
+  i2c::ErrorCode transfer(const uint8_t *write_buffer, size_t write_count, uint8_t *read_buffer,
+                          size_t read_count) override;
+
+  uint32_t get_command_bytes() const { return this->command_bytes_; }
+  uint32_t get_data_bytes() const { return this->data_bytes_; }
+
+ protected:
+  uint32_t command_bytes_{0};
+  uint32_t data_bytes_{0};
+};
+
+/// One step of a ScriptedPin script
+struct PinStep {
+  uint32_t duration_ms;
+  bool level;
+};
+
+/** Input pin that replays a level script, looping forever.
+ *
+ * The script is walked against millis(), so a binary sensor polling the pin sees the same edges on
+ * every run. Writes are counted but do not change what the pin reads.
+ */
+class ScriptedPin : public GPIOPin {
+ public:
+  void set_script(std::vector<PinStep> steps);
+
+  void setup() override {}
+  void pin_mode(gpio::Flags flags) override { this->flags_ = flags; }
+  gpio::Flags get_flags() const override { return this->flags_; }
+  bool digital_read() override;
+  void digital_write(bool value) override { this->writes_++; }
+  size_t dump_summary(char *buffer, size_t len) const override;
+
+  uint32_t get_writes() const { return this->writes_; }
+
+ protected:
+  std::vector<PinStep> steps_;
+  uint32_t cycle_ms_{0};
+  uint32_t start_{0};
+  uint32_t writes_{0};
+  gpio::Flags flags_{gpio::FLAG_INPUT};
+  bool started_{false};
+};
+
+}  // namespace esphome::soak_test
+
+#endif  // USE_HOST
@@ -0,0 +1,223 @@
+#include "soak_test.h"
+
+#ifdef USE_HOST
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdlib>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome::soak_test {
+
+static const char *const TAG = "soak_test";
+
+// A probe that has not seen its first byte after this long counts as failed
+static constexpr uint32_t PROBE_TIMEOUT_US = 5000000;
+
+void SampleStats::add(uint32_t value) {
+  this->sum_ += value;
+  this->count_++;
+  if (value > this->max_)
+    this->max_ = value;
+  // Bucket b holds values below 2^b
+  size_t bucket = value == 0 ? 0 : 32 - __builtin_clz(value);
+  this->buckets_[std::min(bucket, BUCKETS - 1)]++;
+}
+
+uint32_t SampleStats::percentile_bound(uint8_t percentile) const {
+  if (this->count_ == 0)
+    return 0;
+  uint64_t target = (static_cast<uint64_t>(this->count_) * percentile + 99) / 100;
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+    seen += this->buckets_[bucket];
+    if (seen >= target)
+      return bucket == 0 ? 0 : std::min<uint64_t>((uint64_t{1} << bucket) - 1, this->max_);
+  }
+  return this->max_;
+}
+
+void LoopbackProbe::step(bool start) {
+  switch (this->state_) {
+    case State::IDLE: {
+      if (!start)
+        return;
+      this->fd_ = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+      if (this->fd_ < 0) {
+        this->fail_();
+        return;
+      }
+      fcntl(this->fd_, F_SETFL, fcntl(this->fd_, F_GETFL, 0) | O_NONBLOCK);
+      struct sockaddr_in addr {};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(this->port_);
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      this->start_us_ = micros();
+      if (::connect(this->fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 &&
+          errno != EINPROGRESS) {
+        this->fail_();
+        return;
+      }
+      this->state_ = State::CONNECTING;
+      return;
+    }
+    case State::CONNECTING: {
+      struct pollfd pfd {
+        .fd = this->fd_, .events = POLLOUT, .revents = 0
+      };
+      if (::poll(&pfd, 1, 0) == 0)
+        break;
+      int err = 0;
+      socklen_t len = sizeof(err);
+      getsockopt(this->fd_, SOL_SOCKET, SO_ERROR, &err, &len);
+      if (err != 0 || ::send(this->fd_, this->request_, this->request_len_, MSG_NOSIGNAL) !=
+                          static_cast<ssize_t>(this->request_len_)) {
+        this->fail_();
+        return;
+      }
+      this->state_ = State::WAITING;
+      break;
+    }
+    case State::WAITING: {
+      uint8_t byte;
+      ssize_t got = ::recv(this->fd_, &byte, 1, 0);
+      if (got == 1) {
+        this->latency_.add(micros() - this->start_us_);
+        this->state_ = State::DRAINING;
+        return;
+      }
+      if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        this->fail_();
+        return;
+      }
+      break;
+    }
+    case State::DRAINING: {
+      // Let the server close first, so it sees an orderly shutdown rather than a client dropping mid-answer
+      uint8_t rest[256];
+      ssize_t got;
+      while ((got = ::recv(this->fd_, rest, sizeof(rest), 0)) > 0) {
+      }
+      if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK) || micros() - this->start_us_ > PROBE_TIMEOUT_US)
+        this->close();
+      return;
+    }
+  }
+  if (micros() - this->start_us_ > PROBE_TIMEOUT_US)
+    this->fail_();
+}
+
+void LoopbackProbe::fail_() {
+  this->failures_++;
+  this->close();
+}
+
+void LoopbackProbe::close() {
+  if (this->fd_ >= 0)
+    ::close(this->fd_);
+  this->fd_ = -1;
+  this->state_ = State::IDLE;
+}
+
+size_t SoakTestComponent::heap_in_use_() {
+#ifdef __GLIBC__
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+void SoakTestComponent::setup() {
+  this->started_ = millis();
+  this->last_report_ = this->started_;
+  this->last_probe_ = this->started_;
+  this->last_loop_us_ = micros();
+}
+
+void SoakTestComponent::loop() {
+  const uint32_t now_us = micros();
+  this->loop_period_.add(now_us - this->last_loop_us_);
+  this->last_loop_us_ = now_us;
+  this->heap_peak_ = std::max(this->heap_peak_, heap_in_use_());
+
+  const uint32_t now = millis();
+  const bool start_probes = now - this->last_probe_ >= this->probe_interval_;
+  if (start_probes)
+    this->last_probe_ = now;
+  for (auto *probe : this->probes_)
+    probe->step(start_probes);
+
+  if (this->duration_ != 0 && now - this->started_ >= this->duration_) {
+    this->report_(true);
+    bool unanswered = false;
+    for (auto *probe : this->probes_)
+      unanswered |= probe->get_latency().count() == 0;
+    this->on_shutdown();
+    ::exit(unanswered ? EXIT_FAILURE : EXIT_SUCCESS);
+  }
+  if (now - this->last_report_ >= this->report_interval_) {
+    this->last_report_ = now;
+    this->report_(false);
+  }
+}
+
+void SoakTestComponent::report_(bool final) {
+  // key=value lines so runs can be diffed and graphed across upgrades
+  ESP_LOGI(TAG,
+           "%s t=%" PRIu32 "s loops=%" PRIu32 " loop_avg_us=%" PRIu32 " loop_p99_us<=%" PRIu32 " loop_max_us=%" PRIu32
+           " heap=%zu heap_peak=%zu",
+           final ? "final" : "report", (millis() - this->started_) / 1000, this->loop_period_.count(),
+           this->loop_period_.average(), this->loop_period_.percentile_bound(99), this->loop_period_.max(),
+           heap_in_use_(), this->heap_peak_);
+  for (auto *probe : this->probes_) {
+    const auto &latency = probe->get_latency();
+    ESP_LOGI(TAG,
+             "%s probe=%s ok=%" PRIu32 " failed=%" PRIu32 " avg_us=%" PRIu32 " p99_us<=%" PRIu32 " max_us=%" PRIu32,
+             final ? "final" : "report", probe->get_name(), latency.count(), probe->get_failures(), latency.average(),
+             latency.percentile_bound(99), latency.max());
+  }
+  for (const auto &named : this->devices_) {
+    const auto &stats = named.device->get_stats();
+    ESP_LOGI(TAG,
+             "%s i2c=%s addr=0x%02X transactions=%" PRIu32 " written=%" PRIu32 " read=%" PRIu32 " errors=%" PRIu32,
+             final ? "final" : "report", named.name, named.device->get_address(), stats.transactions,
+             stats.bytes_written, stats.bytes_read, stats.errors);
+  }
+  // Loop periods are reported per interval; latency and traffic are cumulative
+  this->loop_period_.reset();
+}
+
+void SoakTestComponent::on_shutdown() {
+  for (auto *probe : this->probes_)
+    probe->close();
+}
+
+void SoakTestComponent::dump_config() {
+  ESP_LOGCONFIG(TAG,
+                "Soak test:\n"
+                "  Report interval: %" PRIu32 " ms\n"
+                "  Probe interval: %" PRIu32 " ms\n"
+                "  Duration: %" PRIu32 " ms",
+                this->report_interval_, this->probe_interval_, this->duration_);
+  for (auto *probe : this->probes_) {
+    ESP_LOGCONFIG(TAG, "  Probe '%s' on port %u", probe->get_name(), probe->get_port());
+  }
+  for (const auto &named : this->devices_) {
+    ESP_LOGCONFIG(TAG, "  I2C model '%s' at 0x%02X", named.name, named.device->get_address());
+  }
+}
+
+}  // namespace esphome::soak_test
+
+#endif  // USE_HOST
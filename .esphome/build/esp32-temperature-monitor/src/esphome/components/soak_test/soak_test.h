@@ -0,0 +1,123 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HOST
+
+#include <vector>
+#include "esphome/components/i2c/i2c_bus_host.h"
+#include "esphome/core/component.h"
+
+namespace esphome::soak_test {
+
+/// Empty Noise handshake hello frame; the API server answers with its ServerHello
+static constexpr uint8_t API_NOISE_HELLO[] = {0x01, 0x00, 0x00};
+/// Empty plaintext HelloRequest and DisconnectRequest frames (indicator, size 0, type); the API server answers with
+/// its HelloResponse and then closes the connection itself, so the probe's close isn't logged as a dropped client
+static constexpr uint8_t API_PLAINTEXT_HELLO[] = {0x00, 0x00, 0x01, 0x00, 0x00, 0x05};
+/// Minimal web request; an auth-protected server still answers (with 401), which is all a probe needs
+static constexpr char WEB_ROOT_REQUEST[] = "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+
+/// Latency or duration samples: count, sum, max and a log2 histogram for percentile bounds
+class SampleStats {
+ public:
+  static constexpr size_t BUCKETS = 32;
+
+  void add(uint32_t value);
+  void reset() { *this = SampleStats{}; }
+
+  uint32_t count() const { return this->count_; }
+  uint32_t average() const { return this->count_ == 0 ? 0 : static_cast<uint32_t>(this->sum_ / this->count_); }
+  uint32_t max() const { return this->max_; }
+  /// Upper bound of the histogram bucket holding the given percentile (0-100)
+  uint32_t percentile_bound(uint8_t percentile) const;
+
+ protected:
+  uint64_t sum_{0};
+  uint32_t count_{0};
+  uint32_t max_{0};
+  uint32_t buckets_[BUCKETS]{};
+};
+
+/** Times request-to-first-byte against a local server over loopback.
+ *
+ * Fully non-blocking: the server under test runs on the same loop, so each step only polls the socket
+ * and returns. After the first byte the probe reads until the server closes.
+ */
+class LoopbackProbe {
+ public:
+  LoopbackProbe(const char *name, uint16_t port, const void *request, size_t request_len)
+      : name_(name), request_(request), request_len_(request_len), port_(port) {}
+
+  /// Advance the probe; starts a new request when idle and `start` is set
+  void step(bool start);
+  void close();
+
+  const char *get_name() const { return this->name_; }
+  uint16_t get_port() const { return this->port_; }
+  const SampleStats &get_latency() const { return this->latency_; }
+  uint32_t get_failures() const { return this->failures_; }
+
+ protected:
+  enum class State : uint8_t { IDLE, CONNECTING, WAITING, DRAINING };
+
+  void fail_();
+
+  const char *name_;
+  const void *request_;
+  size_t request_len_;
+  SampleStats latency_;
+  uint32_t failures_{0};
+  uint32_t start_us_{0};
+  int fd_{-1};
+  uint16_t port_;
+  State state_{State::IDLE};
+};
+
+/** Soak-test driver for host builds of a device configuration.
+ *
+ * Runs alongside the real components and periodically logs one machine-readable metrics line: main
+ * loop period, heap in use, API and web request-to-first-byte latency over loopback, and the traffic
+ * each simulated I2C device has seen (which, for a display model, is the display bytes). After the
+ * configured duration it logs a final summary and exits, non-zero if a probe never got an answer.
+ */
+class SoakTestComponent : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  void on_shutdown() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  void set_report_interval(uint32_t report_interval) { this->report_interval_ = report_interval; }
+  void set_probe_interval(uint32_t probe_interval) { this->probe_interval_ = probe_interval; }
+  /// Stop after this long; 0 runs until killed
+  void set_duration(uint32_t duration) { this->duration_ = duration; }
+  void add_probe(LoopbackProbe *probe) { this->probes_.push_back(probe); }
+  void add_i2c_device(const char *name, i2c::I2CDeviceModel *device) { this->devices_.push_back({name, device}); }
+
+ protected:
+  struct NamedDevice {
+    const char *name;
+    i2c::I2CDeviceModel *device;
+  };
+
+  void report_(bool final);
+  static size_t heap_in_use_();
+
+  std::vector<LoopbackProbe *> probes_;
+  std::vector<NamedDevice> devices_;
+  SampleStats loop_period_;
+  size_t heap_peak_{0};
+  uint32_t started_{0};
+  uint32_t last_loop_us_{0};
+  uint32_t last_report_{0};
+  uint32_t last_probe_{0};
+  uint32_t report_interval_{60000};
+  uint32_t probe_interval_{1000};
+  uint32_t duration_{0};
+};
+
+}  // namespace esphome::soak_test
+
+#endif  // USE_HOST
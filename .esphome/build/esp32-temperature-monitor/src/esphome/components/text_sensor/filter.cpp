@@ -3,24 +3,82 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace text_sensor {
 
 static const char *const TAG = "text_sensor.filter";
 
+// FilterBuffer
+FilterBuffer::~FilterBuffer() {
+  if (this->on_heap())
+    delete[] this->data_;
+}
+
+void FilterBuffer::reserve_(size_t len) {
+  if (len <= this->capacity_)
+    return;
+  // Grow geometrically so a value that keeps getting longer doesn't reallocate on every publish
+  size_t capacity = std::max(len, this->capacity_ * 2);
+  char *data = new char[capacity + 1];  // NOLINT(cppcoreguidelines-owning-memory)
+  memcpy(data, this->data_, this->len_ + 1);
+  if (this->on_heap())
+    delete[] this->data_;
+  ESP_LOGV(TAG, "Filter buffer moved to heap, %u chars", (unsigned) capacity);
+  this->data_ = data;
+  this->capacity_ = capacity;
+}
+
+void FilterBuffer::assign(const char *str, size_t len) {
+  this->len_ = 0;  // nothing to keep if the buffer has to grow
+  this->reserve_(len);
+  memcpy(this->data_, str, len);
+  this->len_ = len;
+  this->data_[len] = '\0';
+}
+
+void FilterBuffer::replace(size_t pos, size_t count, const char *str, size_t len) {
+  size_t tail_len = this->len_ - pos - count;
+  this->reserve_(pos + len + tail_len);
+  memmove(this->data_ + pos + len, this->data_ + pos + count, tail_len);
+  memcpy(this->data_ + pos, str, len);
+  this->len_ = pos + len + tail_len;
+  this->data_[this->len_] = '\0';
+}
+
+size_t FilterBuffer::find(const char *str, size_t len, size_t pos) const {
+  if (len == 0 || len > this->len_)
+    return std::string::npos;
+  for (size_t last = this->len_ - len; pos <= last; pos++) {
+    const void *hit = memchr(this->data_ + pos, str[0], last - pos + 1);
+    if (hit == nullptr)
+      return std::string::npos;
+    pos = static_cast<const char *>(hit) - this->data_;
+    if (memcmp(this->data_ + pos, str, len) == 0)
+      return pos;
+  }
+  return std::string::npos;
+}
+
+static CompiledSubstitution compile_substitution(const Substitution &sub) {
+  return {sub.from, sub.to, static_cast<uint16_t>(strlen(sub.from)), static_cast<uint16_t>(strlen(sub.to))};
+}
+
 // Filter
-void Filter::input(std::string value) {
+void Filter::input(FilterBuffer &value) {
   ESP_LOGVV(TAG, "Filter(%p)::input(%s)", this, value.c_str());
   if (this->new_value(value))
     this->output(value);
 }
-void Filter::output(std::string &value) {
+void Filter::output(FilterBuffer &value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%s) -> SENSOR", this, value.c_str());
-    this->parent_->internal_send_state_to_frontend(value);
+    this->parent_->internal_send_state_to_frontend(value.c_str(), value.size());
   } else {
     ESP_LOGVV(TAG, "Filter(%p)::output(%s) -> %p", this, value.c_str(), this->next_);
-    this->next_->input(std::move(value));
+    this->next_->input(value);
   }
 }
 void Filter::initialize(TextSensor *parent, Filter *next) {
@@ -34,11 +92,11 @@ LambdaFilter::LambdaFilter(lambda_filter_t lambda_filter) : lambda_filter_(std::
 const lambda_filter_t &LambdaFilter::get_lambda_filter() const { return this->lambda_filter_; }
 void LambdaFilter::set_lambda_filter(const lambda_filter_t &lambda_filter) { this->lambda_filter_ = lambda_filter; }
 
-bool LambdaFilter::new_value(std::string &value) {
-  auto result = this->lambda_filter_(value);
+bool LambdaFilter::new_value(FilterBuffer &value) {
+  auto result = this->lambda_filter_(value.ref().str());
   if (result.has_value()) {
     ESP_LOGVV(TAG, "LambdaFilter(%p)::new_value(%s) -> %s (continue)", this, value.c_str(), result->c_str());
-    value = std::move(*result);
+    value.assign(result->data(), result->size());
     return true;
   }
   ESP_LOGVV(TAG, "LambdaFilter(%p)::new_value(%s) -> (stop)", this, value.c_str());
@@ -46,58 +104,68 @@ bool LambdaFilter::new_value(std::string &value) {
 }
 
 // ToUpperFilter
-bool ToUpperFilter::new_value(std::string &value) {
-  for (char &c : value)
-    c = ::toupper(c);
+bool ToUpperFilter::new_value(FilterBuffer &value) {
+  char *data = value.data();
+  for (size_t i = 0; i < value.size(); i++)
+    data[i] = ::toupper(data[i]);
   return true;
 }
 
 // ToLowerFilter
-bool ToLowerFilter::new_value(std::string &value) {
-  for (char &c : value)
-    c = ::tolower(c);
+bool ToLowerFilter::new_value(FilterBuffer &value) {
+  char *data = value.data();
+  for (size_t i = 0; i < value.size(); i++)
+    data[i] = ::tolower(data[i]);
   return true;
 }
 
 // Append
-bool AppendFilter::new_value(std::string &value) {
-  value.append(this->suffix_);
+bool AppendFilter::new_value(FilterBuffer &value) {
+  value.append(this->suffix_, this->suffix_len_);
   return true;
 }
 
 // Prepend
-bool PrependFilter::new_value(std::string &value) {
-  value.insert(0, this->prefix_);
+bool PrependFilter::new_value(FilterBuffer &value) {
+  value.prepend(this->prefix_, this->prefix_len_);
   return true;
 }
 
 // Substitute
-SubstituteFilter::SubstituteFilter(const std::initializer_list<Substitution> &substitutions)
-    : substitutions_(substitutions) {}
+SubstituteFilter::SubstituteFilter(const std::initializer_list<Substitution> &substitutions) {
+  this->substitutions_.init(substitutions.size());
+  for (const auto &sub : substitutions)
+    this->substitutions_.push_back(compile_substitution(sub));
+}
 
-bool SubstituteFilter::new_value(std::string &value) {
+bool SubstituteFilter::new_value(FilterBuffer &value) {
   for (const auto &sub : this->substitutions_) {
-    // Compute lengths once per substitution (strlen is fast, called infrequently)
-    const size_t from_len = strlen(sub.from);
-    const size_t to_len = strlen(sub.to);
-    std::size_t pos = 0;
-    while ((pos = value.find(sub.from, pos, from_len)) != std::string::npos) {
-      value.replace(pos, from_len, sub.to, to_len);
+    size_t pos = 0;
+    while ((pos = value.find(sub.from, sub.from_len, pos)) != std::string::npos) {
+      value.replace(pos, sub.from_len, sub.to, sub.to_len);
       // Advance past the replacement to avoid infinite loop when
       // the replacement contains the search pattern (e.g., f -> foo)
-      pos += to_len;
+      pos += sub.to_len;
     }
   }
   return true;
 }
 
 // Map
-MapFilter::MapFilter(const std::initializer_list<Substitution> &mappings) : mappings_(mappings) {}
+MapFilter::MapFilter(const std::initializer_list<Substitution> &mappings) {
+  this->mappings_.init(mappings.size());
+  for (const auto &mapping : mappings)
+    this->mappings_.push_back(compile_substitution(mapping));
+}
 
-bool MapFilter::new_value(std::string &value) {
+bool MapFilter::new_value(FilterBuffer &value) {
+  const size_t len = value.size();
+  const char *data = value.c_str();
   for (const auto &mapping : this->mappings_) {
-    if (value == mapping.from) {
-      value.assign(mapping.to);
+    if (mapping.from_len != len || (len != 0 && mapping.from[0] != data[0]))
+      continue;
+    if (memcmp(mapping.from, data, len) == 0) {
+      value.assign(mapping.to, mapping.to_len);
       return true;
     }
   }
@@ -2,12 +2,59 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
 namespace esphome {
 namespace text_sensor {
 
+#ifndef TEXT_SENSOR_FILTER_BUFFER_SIZE
+#define TEXT_SENSOR_FILTER_BUFFER_SIZE 256
+#endif
+
 class TextSensor;
 
+/** String buffer that the filter chain edits in place.
+ *
+ * Each filtered TextSensor owns one, allocated once when the first filter is added,
+ * so publishing through ToUpper/Append/Prepend/Substitute/Map filters never touches the heap
+ * while the value fits the inline storage. A value that grows beyond it moves to a heap buffer,
+ * which is kept for later publishes, so long values are never cut short.
+ */
+class FilterBuffer {
+ public:
+  static constexpr size_t INLINE_CAPACITY = TEXT_SENSOR_FILTER_BUFFER_SIZE - 1;
+
+  FilterBuffer() = default;
+  ~FilterBuffer();
+  FilterBuffer(const FilterBuffer &) = delete;
+  FilterBuffer &operator=(const FilterBuffer &) = delete;
+
+  StringRef ref() const { return StringRef(this->data_, this->len_); }
+  const char *c_str() const { return this->data_; }
+  char *data() { return this->data_; }
+  size_t size() const { return this->len_; }
+  bool empty() const { return this->len_ == 0; }
+  /// Whether the value has outgrown the inline storage at some point.
+  bool on_heap() const { return this->data_ != this->inline_; }
+
+  void assign(const char *str, size_t len);
+  /// Replace `count` chars at `pos` with `str` - the primitive all other edits build on.
+  void replace(size_t pos, size_t count, const char *str, size_t len);
+  void append(const char *str, size_t len) { this->replace(this->len_, 0, str, len); }
+  void prepend(const char *str, size_t len) { this->replace(0, 0, str, len); }
+  /// Find `str` at or after `pos`, returns std::string::npos if not found.
+  size_t find(const char *str, size_t len, size_t pos) const;
+
+ protected:
+  /// Make room for `len` chars (plus the terminator), moving to the heap if needed.
+  void reserve_(size_t len);
+
+  char *data_{this->inline_};
+  size_t len_{0};
+  size_t capacity_{INLINE_CAPACITY};
+  char inline_[TEXT_SENSOR_FILTER_BUFFER_SIZE]{};
+};
+
 /** Apply a filter to text sensor values such as to_upper.
  *
  * This class is purposefully kept quite simple, since more complicated
@@ -23,14 +70,14 @@ class Filter {
    * @param value The value to filter (modified in place).
    * @return True to continue the filter chain, false to stop.
    */
-  virtual bool new_value(std::string &value) = 0;
+  virtual bool new_value(FilterBuffer &value) = 0;
 
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(TextSensor *parent, Filter *next);
 
-  void input(std::string value);
+  void input(FilterBuffer &value);
 
-  void output(std::string &value);
+  void output(FilterBuffer &value);
 
  protected:
   friend TextSensor;
@@ -46,12 +93,15 @@ using lambda_filter_t = std::function<optional<std::string>(std::string)>;
  * The constructor accepts a lambda of the form std::string -> optional<std::string>.
  * Return a modified string to continue the chain, or return {} to stop
  * (value will not be published).
+ *
+ * Note: the lambda signature requires materializing the value as std::string, so this is the
+ * only filter that allocates per publish.
  */
 class LambdaFilter : public Filter {
  public:
   explicit LambdaFilter(lambda_filter_t lambda_filter);
 
-  bool new_value(std::string &value) override;
+  bool new_value(FilterBuffer &value) override;
 
   const lambda_filter_t &get_lambda_filter() const;
   void set_lambda_filter(const lambda_filter_t &lambda_filter);
@@ -69,10 +119,10 @@ class StatelessLambdaFilter : public Filter {
  public:
   explicit StatelessLambdaFilter(optional<std::string> (*lambda_filter)(std::string)) : lambda_filter_(lambda_filter) {}
 
-  bool new_value(std::string &value) override {
-    auto result = this->lambda_filter_(value);
+  bool new_value(FilterBuffer &value) override {
+    auto result = this->lambda_filter_(value.ref().str());
     if (result.has_value()) {
-      value = std::move(*result);
+      value.assign(result->data(), result->size());
       return true;
     }
     return false;
@@ -85,33 +135,35 @@ class StatelessLambdaFilter : public Filter {
 /// A simple filter that converts all text to uppercase
 class ToUpperFilter : public Filter {
  public:
-  bool new_value(std::string &value) override;
+  bool new_value(FilterBuffer &value) override;
 };
 
 /// A simple filter that converts all text to lowercase
 class ToLowerFilter : public Filter {
  public:
-  bool new_value(std::string &value) override;
+  bool new_value(FilterBuffer &value) override;
 };
 
 /// A simple filter that adds a string to the end of another string
 class AppendFilter : public Filter {
  public:
-  explicit AppendFilter(const char *suffix) : suffix_(suffix) {}
-  bool new_value(std::string &value) override;
+  explicit AppendFilter(const char *suffix) : suffix_(suffix), suffix_len_(strlen(suffix)) {}
+  bool new_value(FilterBuffer &value) override;
 
  protected:
   const char *suffix_;
+  uint16_t suffix_len_;
 };
 
 /// A simple filter that adds a string to the start of another string
 class PrependFilter : public Filter {
  public:
-  explicit PrependFilter(const char *prefix) : prefix_(prefix) {}
-  bool new_value(std::string &value) override;
+  explicit PrependFilter(const char *prefix) : prefix_(prefix), prefix_len_(strlen(prefix)) {}
+  bool new_value(FilterBuffer &value) override;
 
  protected:
   const char *prefix_;
+  uint16_t prefix_len_;
 };
 
 struct Substitution {
@@ -119,14 +171,22 @@ struct Substitution {
   const char *to;
 };
 
+/// A Substitution with both lengths resolved once when the filter is constructed.
+struct CompiledSubstitution {
+  const char *from;
+  const char *to;
+  uint16_t from_len;
+  uint16_t to_len;
+};
+
 /// A simple filter that replaces a substring with another substring
 class SubstituteFilter : public Filter {
  public:
   explicit SubstituteFilter(const std::initializer_list<Substitution> &substitutions);
-  bool new_value(std::string &value) override;
+  bool new_value(FilterBuffer &value) override;
 
  protected:
-  FixedVector<Substitution> substitutions_;
+  FixedVector<CompiledSubstitution> substitutions_;
 };
 
 /** A filter that maps values from one set to another
@@ -152,14 +212,17 @@ class SubstituteFilter : public Filter {
  * - Faster for typical ESPHome usage (2-10 mappings common, 20+ rare)
  *
  * Break-even point: ~35-40 mappings, but ESPHome configs rarely exceed 20
+ *
+ * Keys are stored with their precomputed length, so non-matching entries are rejected by a
+ * length and first-character check before any memcmp.
  */
 class MapFilter : public Filter {
  public:
   explicit MapFilter(const std::initializer_list<Substitution> &mappings);
-  bool new_value(std::string &value) override;
+  bool new_value(FilterBuffer &value) override;
 
  protected:
-  FixedVector<Substitution> mappings_;
+  FixedVector<CompiledSubstitution> mappings_;
 };
 
 }  // namespace text_sensor
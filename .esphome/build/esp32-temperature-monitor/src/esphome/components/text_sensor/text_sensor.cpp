@@ -43,7 +43,8 @@ void TextSensor::publish_state(const char *state, size_t len) {
     }
     this->raw_callback_.call(this->raw_state);
     ESP_LOGV(TAG, "'%s': Received new state %s", this->name_.c_str(), this->raw_state.c_str());
-    this->filter_list_->input(this->raw_state);
+    this->filter_buffer_->assign(state, len);
+    this->filter_list_->input(*this->filter_buffer_);
 #pragma GCC diagnostic pop
   }
 }
@@ -52,6 +53,10 @@ void TextSensor::add_filter(Filter *filter) {
   // inefficient, but only happens once on every sensor setup and nobody's going to have massive amounts of
   // filters
   ESP_LOGVV(TAG, "TextSensor(%p)::add_filter(%p)", this, filter);
+  if (this->filter_buffer_ == nullptr) {
+    // Allocated once and kept across clear_filters(), so publishing values that fit it never allocates
+    this->filter_buffer_ = new FilterBuffer();  // NOLINT(cppcoreguidelines-owning-memory)
+  }
   if (this->filter_list_ == nullptr) {
     this->filter_list_ = filter;
   } else {
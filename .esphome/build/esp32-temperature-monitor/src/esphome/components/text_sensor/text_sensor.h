@@ -73,7 +73,8 @@ class TextSensor : public EntityBase, public EntityBase_DeviceClass {
   LazyCallbackManager<void(const std::string &)> raw_callback_;  ///< Storage for raw state callbacks.
   LazyCallbackManager<void(const std::string &)> callback_;      ///< Storage for filtered state callbacks.
 
-  Filter *filter_list_{nullptr};  ///< Store all active filters.
+  Filter *filter_list_{nullptr};            ///< Store all active filters.
+  FilterBuffer *filter_buffer_{nullptr};  ///< Scratch buffer the filter chain edits in place.
 };
 
 }  // namespace text_sensor
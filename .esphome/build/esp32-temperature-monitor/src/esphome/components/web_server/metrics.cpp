@@ -0,0 +1,211 @@
+#include "metrics.h"
+#ifdef USE_WEBSERVER
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome::web_server {
+
+static const char *const TAG = "web_server.metrics";
+
+void PrometheusMetrics::append_family_(std::string &out, const char *name, const char *help) {
+  out.append("# HELP ").append(name).append(" ").append(help).append("\n# TYPE ").append(name).append(" gauge\n");
+}
+
+// Label values escape backslash, double quote and newline as required by the exposition format
+static void append_label_value(std::string &out, const char *value, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = value[i];
+    if (c == '\\' || c == '"') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (c == '\n') {
+      out.append("\\n");
+    } else {
+      out.push_back(c);
+    }
+  }
+}
+
+void PrometheusMetrics::append_labels_(std::string &out, EntityBase *obj) {
+  char id_buf[OBJECT_ID_MAX_LEN];
+  size_t id_len = obj->write_object_id_to(id_buf, sizeof(id_buf));
+  out.append("{id=\"");
+  append_label_value(out, id_buf, id_len);
+  out.append("\",name=\"");
+  const StringRef &name = obj->get_name();
+  append_label_value(out, name.c_str(), name.size());
+  out.append("\"}");
+}
+
+uint16_t PrometheusMetrics::append_slot_(std::string &out) {
+  uint16_t offset = static_cast<uint16_t>(out.size());
+  out.append(VALUE_WIDTH, ' ');
+  out.push_back('\n');
+  return offset;
+}
+
+void PrometheusMetrics::write_slot_(char *buffer, uint16_t offset, const char *value, size_t len) {
+  if (len > VALUE_WIDTH) {
+    ESP_LOGW(TAG, "Value '%.*s' does not fit the %u char slot", static_cast<int>(len), value,
+             static_cast<unsigned>(VALUE_WIDTH));
+    value = "NaN";
+    len = 3;
+  }
+  char *slot = buffer + offset;
+  size_t pad = VALUE_WIDTH - len;
+  memset(slot, ' ', pad);
+  memcpy(slot + pad, value, len);
+}
+
+void PrometheusMetrics::write_slot_(char *buffer, uint16_t offset, float value, int8_t accuracy_decimals) {
+  if (std::isnan(value)) {
+    write_slot_(buffer, offset, "NaN", 3);
+  } else if (std::isinf(value)) {
+    write_slot_(buffer, offset, value > 0 ? "+Inf" : "-Inf", 4);
+  } else {
+    char buf[VALUE_ACCURACY_MAX_LEN];
+    size_t len = value_accuracy_to_buf(buf, value, accuracy_decimals);
+    if (len > VALUE_WIDTH) {
+      // Huge magnitudes or many decimals: "-1.23456789e+38" is at most 15 chars and keeps float precision
+      len = buf_append_printf(buf, sizeof(buf), 0, "%.9g", value);
+    }
+    write_slot_(buffer, offset, buf, len);
+  }
+}
+
+void PrometheusMetrics::init(bool include_internal) {
+  // Rendering allocates once at setup; offsets are kept in 16 bits
+  std::string out;
+#ifdef USE_SENSOR
+  size_t sensor_count = 0;
+  for (auto *obj : App.get_sensors()) {
+    if (include_internal || !obj->is_internal())
+      sensor_count++;
+  }
+  this->sensor_slots_.init(sensor_count);
+  if (sensor_count > 0) {
+    append_family_(out, "esphome_sensor_value", "Sensor state");
+    for (auto *obj : App.get_sensors()) {
+      if (!include_internal && obj->is_internal())
+        continue;
+      out.append("esphome_sensor_value");
+      append_labels_(out, obj);
+      this->sensor_slots_.push_back({obj, append_slot_(out)});
+    }
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  size_t binary_sensor_count = 0;
+  for (auto *obj : App.get_binary_sensors()) {
+    if (include_internal || !obj->is_internal())
+      binary_sensor_count++;
+  }
+  this->binary_sensor_slots_.init(binary_sensor_count);
+  if (binary_sensor_count > 0) {
+    append_family_(out, "esphome_binary_sensor_value", "Binary sensor state (1 = on)");
+    for (auto *obj : App.get_binary_sensors()) {
+      if (!include_internal && obj->is_internal())
+        continue;
+      out.append("esphome_binary_sensor_value");
+      append_labels_(out, obj);
+      this->binary_sensor_slots_.push_back({obj, append_slot_(out)});
+    }
+  }
+#endif
+  append_family_(out, "esphome_uptime_seconds", "Time since boot");
+  out.append("esphome_uptime_seconds");
+  this->uptime_offset_ = append_slot_(out);
+  append_family_(out, "esphome_free_heap_bytes", "Free internal heap");
+  out.append("esphome_free_heap_bytes");
+  this->free_heap_offset_ = append_slot_(out);
+
+  if (out.size() > UINT16_MAX) {
+    ESP_LOGE(TAG, "Metrics document too large (%u bytes)", static_cast<unsigned>(out.size()));
+    return;
+  }
+  this->size_ = out.size();
+  this->buffer_ = new char[this->size_ + 1];       // NOLINT(cppcoreguidelines-owning-memory)
+  this->send_buffer_ = new char[this->size_ + 1];  // NOLINT(cppcoreguidelines-owning-memory)
+  memcpy(this->buffer_, out.c_str(), this->size_ + 1);
+
+  // Initial values for entities that already have a state
+#ifdef USE_SENSOR
+  for (const auto &slot : this->sensor_slots_) {
+    auto *obj = static_cast<sensor::Sensor *>(slot.obj);
+    write_slot_(this->buffer_, slot.offset, obj->has_state() ? obj->state : NAN, obj->get_accuracy_decimals());
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (const auto &slot : this->binary_sensor_slots_) {
+    auto *obj = static_cast<binary_sensor::BinarySensor *>(slot.obj);
+    if (obj->has_state()) {
+      write_slot_(this->buffer_, slot.offset, obj->state ? "1" : "0", 1);
+    } else {
+      write_slot_(this->buffer_, slot.offset, "NaN", 3);
+    }
+  }
+#endif
+  ESP_LOGD(TAG, "Metrics: %u bytes", static_cast<unsigned>(this->size_));
+}
+
+const PrometheusMetrics::Slot *PrometheusMetrics::find_slot_(const FixedVector<Slot> &slots, EntityBase *obj) const {
+  for (const auto &slot : slots) {
+    if (slot.obj == obj)
+      return &slot;
+  }
+  return nullptr;
+}
+
+#ifdef USE_SENSOR
+void PrometheusMetrics::update_sensor(sensor::Sensor *obj) {
+  if (this->buffer_ == nullptr)
+    return;
+  const Slot *slot = this->find_slot_(this->sensor_slots_, obj);
+  if (slot == nullptr)
+    return;
+  LockGuard guard{this->lock_};
+  write_slot_(this->buffer_, slot->offset, obj->state, obj->get_accuracy_decimals());
+}
+#endif
+
+#ifdef USE_BINARY_SENSOR
+void PrometheusMetrics::update_binary_sensor(binary_sensor::BinarySensor *obj) {
+  if (this->buffer_ == nullptr)
+    return;
+  const Slot *slot = this->find_slot_(this->binary_sensor_slots_, obj);
+  if (slot == nullptr)
+    return;
+  LockGuard guard{this->lock_};
+  write_slot_(this->buffer_, slot->offset, obj->state ? "1" : "0", 1);
+}
+#endif
+
+const char *PrometheusMetrics::prepare() {
+  if (this->buffer_ == nullptr)
+    return nullptr;
+  {
+    LockGuard guard{this->lock_};
+    memcpy(this->send_buffer_, this->buffer_, this->size_ + 1);
+  }
+  char buf[12];
+  size_t len = buf_append_printf(buf, sizeof(buf), 0, "%" PRIu32, millis() / 1000);
+  write_slot_(this->send_buffer_, this->uptime_offset_, buf, len);
+#ifdef USE_ESP32
+  len = buf_append_printf(buf, sizeof(buf), 0, "%" PRIu32,
+                          static_cast<uint32_t>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)));
+  write_slot_(this->send_buffer_, this->free_heap_offset_, buf, len);
+#endif
+  return this->send_buffer_;
+}
+
+}  // namespace esphome::web_server
+#endif  // USE_WEBSERVER
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_WEBSERVER
+#include "esphome/core/entity_base.h"
+#include "esphome/core/helpers.h"
+
+#include <string>
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+namespace esphome::web_server {
+
+/** Pre-rendered Prometheus text exposition of all sensor and binary sensor states, served under '/metrics'.
+ *
+ * The whole document is rendered once in init(). Every sample value lives in a fixed-width, right-aligned slot, so
+ * a state update only rewrites its own slot and a scrape is a single send of the buffer, independent of the number
+ * of entities. Leading spaces in a slot are separator whitespace in the exposition format.
+ *
+ * Updates run on the main loop while scrapes are served from the httpd task, so slots are rewritten under a lock
+ * and prepare() copies the document, also under the lock, into a second buffer that only the httpd task reads. A
+ * scrape therefore never sees a slot in the middle of being rewritten.
+ */
+class PrometheusMetrics {
+ public:
+  /// Width of a value slot. Sensor values that don't fit with their accuracy decimals are written in exponent
+  /// notation, which always fits.
+  static constexpr size_t VALUE_WIDTH = 16;
+
+  /// Render the document for all entities; internal entities are only included if include_internal is set.
+  void init(bool include_internal);
+
+#ifdef USE_SENSOR
+  void update_sensor(sensor::Sensor *obj);
+#endif
+#ifdef USE_BINARY_SENSOR
+  void update_binary_sensor(binary_sensor::BinarySensor *obj);
+#endif
+
+  /// Copy the current document, refresh the per-scrape gauges (uptime, free heap) in it and return the copy.
+  /// Only call from one task (the httpd task); the copy stays valid until the next call.
+  const char *prepare();
+  size_t size() const { return this->size_; }
+
+ protected:
+  struct Slot {
+    EntityBase *obj;
+    uint16_t offset;
+  };
+
+  static void append_family_(std::string &out, const char *name, const char *help);
+  static void append_labels_(std::string &out, EntityBase *obj);
+  static uint16_t append_slot_(std::string &out);
+  static void write_slot_(char *buffer, uint16_t offset, const char *value, size_t len);
+  static void write_slot_(char *buffer, uint16_t offset, float value, int8_t accuracy_decimals);
+  const Slot *find_slot_(const FixedVector<Slot> &slots, EntityBase *obj) const;
+
+  /// Rewritten by the state updates, guarded by lock_
+  char *buffer_{nullptr};
+  /// Consistent copy handed to the httpd task by prepare()
+  char *send_buffer_{nullptr};
+  size_t size_{0};
+  Mutex lock_;
+  uint16_t uptime_offset_{0};
+  uint16_t free_heap_offset_{0};
+#ifdef USE_SENSOR
+  FixedVector<Slot> sensor_slots_;
+#endif
+#ifdef USE_BINARY_SENSOR
+  FixedVector<Slot> binary_sensor_slots_;
+#endif
+};
+
+}  // namespace esphome::web_server
+#endif  // USE_WEBSERVER
@@ -0,0 +1,146 @@
+#include "snapshot.h"
+#ifdef USE_WEBSERVER
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cmath>
+#include <cstring>
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome::web_server {
+
+static const char *const TAG = "web_server.snapshot";
+
+static inline void put_u16_le(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+static inline void put_u32_le(uint8_t *p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+static inline void put_f32_le(uint8_t *p, float v) {
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  put_u32_le(p, bits);
+}
+
+void SensorSnapshot::init(bool include_internal) {
+  size_t sensor_count = 0;
+  size_t binary_sensor_count = 0;
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors()) {
+    if (include_internal || !obj->is_internal())
+      sensor_count++;
+  }
+  this->sensors_.init(sensor_count);
+  for (auto *obj : App.get_sensors()) {
+    if (include_internal || !obj->is_internal())
+      this->sensors_.push_back(obj);
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors()) {
+    if (include_internal || !obj->is_internal())
+      binary_sensor_count++;
+  }
+  this->binary_sensors_.init(binary_sensor_count);
+  for (auto *obj : App.get_binary_sensors()) {
+    if (include_internal || !obj->is_internal())
+      this->binary_sensors_.push_back(obj);
+  }
+#endif
+
+  this->size_ = HEADER_SIZE + (sensor_count + binary_sensor_count) * RECORD_SIZE;
+  this->buffer_ = new uint8_t[this->size_]();       // NOLINT(cppcoreguidelines-owning-memory)
+  this->send_buffer_ = new uint8_t[this->size_]();  // NOLINT(cppcoreguidelines-owning-memory)
+
+  uint8_t *p = this->buffer_;
+  memcpy(p, "ESNP", 4);
+  p[4] = SNAPSHOT_VERSION;
+  put_u16_le(p + 6, static_cast<uint16_t>(sensor_count));
+  put_u16_le(p + 8, static_cast<uint16_t>(binary_sensor_count));
+  put_u16_le(p + 10, static_cast<uint16_t>(RECORD_SIZE));
+
+#ifdef USE_SENSOR
+  for (size_t i = 0; i < sensor_count; i++) {
+    auto *obj = static_cast<sensor::Sensor *>(this->sensors_[i]);
+    uint8_t *rec = this->record_(i);
+    put_u32_le(rec, obj->get_object_id_hash());
+    put_f32_le(rec + 4, obj->has_state() ? obj->state : NAN);
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (size_t i = 0; i < binary_sensor_count; i++) {
+    auto *obj = static_cast<binary_sensor::BinarySensor *>(this->binary_sensors_[i]);
+    uint8_t *rec = this->record_(sensor_count + i);
+    put_u32_le(rec, obj->get_object_id_hash());
+    rec[4] = obj->has_state() ? static_cast<uint8_t>(obj->state) : 0xFF;
+  }
+#endif
+  ESP_LOGD(TAG, "Snapshot: %u sensors, %u binary sensors, %u bytes", static_cast<unsigned>(sensor_count),
+           static_cast<unsigned>(binary_sensor_count), static_cast<unsigned>(this->size_));
+}
+
+int SensorSnapshot::find_record_(const FixedVector<EntityBase *> &entities, EntityBase *obj) const {
+  for (size_t i = 0; i < entities.size(); i++) {
+    if (entities[i] == obj)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void SensorSnapshot::bump_sequence_() { put_u32_le(this->buffer_ + 12, ++this->sequence_); }
+
+#ifdef USE_SENSOR
+void SensorSnapshot::update_sensor(sensor::Sensor *obj) {
+  if (this->buffer_ == nullptr)
+    return;
+  int index = this->find_record_(this->sensors_, obj);
+  if (index < 0)
+    return;
+  LockGuard guard{this->lock_};
+  uint8_t *rec = this->record_(index);
+  put_f32_le(rec + 4, obj->state);
+  put_u32_le(rec + 8, millis());
+  this->bump_sequence_();
+}
+#endif
+
+#ifdef USE_BINARY_SENSOR
+void SensorSnapshot::update_binary_sensor(binary_sensor::BinarySensor *obj) {
+  if (this->buffer_ == nullptr)
+    return;
+  int index = this->find_record_(this->binary_sensors_, obj);
+  if (index < 0)
+    return;
+  LockGuard guard{this->lock_};
+  uint8_t *rec = this->record_(this->sensors_count_() + index);
+  rec[4] = static_cast<uint8_t>(obj->state);
+  put_u32_le(rec + 8, millis());
+  this->bump_sequence_();
+}
+#endif
+
+const uint8_t *SensorSnapshot::prepare() {
+  {
+    LockGuard guard{this->lock_};
+    memcpy(this->send_buffer_, this->buffer_, this->size_);
+  }
+  put_u32_le(this->send_buffer_ + 16, millis());
+#ifdef USE_ESP32
+  put_u32_le(this->send_buffer_ + 20, heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+#endif
+  return this->send_buffer_;
+}
+
+}  // namespace esphome::web_server
+#endif  // USE_SENSOR || USE_BINARY_SENSOR
+#endif  // USE_WEBSERVER
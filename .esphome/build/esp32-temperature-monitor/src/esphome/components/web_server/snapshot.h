@@ -0,0 +1,98 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_WEBSERVER
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+#include "esphome/core/entity_base.h"
+#include "esphome/core/helpers.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+namespace esphome::web_server {
+
+/** Pre-encoded binary snapshot of all sensor and binary sensor states, served under '/snapshot'.
+ *
+ * The buffer is laid out once in init() and each state update only patches the affected record, so serving a
+ * request is a single send of the buffer without any formatting. All fields are little-endian.
+ *
+ * Updates run on the main loop while requests are served from the httpd task, so the records are patched under
+ * a lock and prepare() copies them, also under the lock, into a second buffer that only the httpd task reads. A
+ * response therefore never shows a half-written record or a sequence that doesn't match the records.
+ *
+ * Layout (SNAPSHOT_VERSION 1):
+ *   header, 24 bytes:
+ *     char[4]  magic "ESNP"
+ *     uint8    version
+ *     uint8    reserved
+ *     uint16   sensor count
+ *     uint16   binary sensor count
+ *     uint16   record size
+ *     uint32   sequence, incremented on every record change
+ *     uint32   uptime in ms, written when served
+ *     uint32   free internal heap in bytes, written when served (0 if unknown)
+ *   sensor records, 12 bytes each:
+ *     uint32   object id hash
+ *     float32  state (NaN if unknown)
+ *     uint32   uptime in ms of the last update
+ *   binary sensor records, 12 bytes each:
+ *     uint32   object id hash
+ *     uint8    state (0 = off, 1 = on, 0xFF = unknown)
+ *     uint8[3] reserved
+ *     uint32   uptime in ms of the last update
+ */
+class SensorSnapshot {
+ public:
+  static constexpr uint8_t SNAPSHOT_VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 24;
+  static constexpr size_t RECORD_SIZE = 12;
+
+  /// Lay out the buffer for all entities; internal entities are only included if include_internal is set.
+  void init(bool include_internal);
+
+#ifdef USE_SENSOR
+  void update_sensor(sensor::Sensor *obj);
+#endif
+#ifdef USE_BINARY_SENSOR
+  void update_binary_sensor(binary_sensor::BinarySensor *obj);
+#endif
+
+  /// Copy the current records, write the per-request health fields and return the copy.
+  /// Only call from one task (the httpd task); the copy stays valid until the next call.
+  const uint8_t *prepare();
+  size_t size() const { return this->size_; }
+
+ protected:
+  int find_record_(const FixedVector<EntityBase *> &entities, EntityBase *obj) const;
+  uint8_t *record_(size_t index) { return this->buffer_ + HEADER_SIZE + index * RECORD_SIZE; }
+  void bump_sequence_();
+  size_t sensors_count_() const {
+#ifdef USE_SENSOR
+    return this->sensors_.size();
+#else
+    return 0;
+#endif
+  }
+
+  /// Patched by the state updates, guarded by lock_
+  uint8_t *buffer_{nullptr};
+  /// Consistent copy handed to the httpd task by prepare()
+  uint8_t *send_buffer_{nullptr};
+  size_t size_{0};
+  uint32_t sequence_{0};
+  Mutex lock_;
+#ifdef USE_SENSOR
+  FixedVector<EntityBase *> sensors_;
+#endif
+#ifdef USE_BINARY_SENSOR
+  FixedVector<EntityBase *> binary_sensors_;
+#endif
+};
+
+}  // namespace esphome::web_server
+#endif  // USE_SENSOR || USE_BINARY_SENSOR
+#endif  // USE_WEBSERVER
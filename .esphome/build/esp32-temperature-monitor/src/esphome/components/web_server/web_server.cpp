@@ -401,6 +401,10 @@ void WebServer::setup() {
 #ifdef USE_ESP32
   this->base_->add_handler(&this->events_);
 #endif
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+  this->snapshot_.init(this->include_internal_);
+#endif
+  this->metrics_.init(this->include_internal_);
   this->base_->add_handler(this);
 
   // OTA is now handled by the web_server OTA platform
@@ -456,6 +460,29 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 }
 #endif
 
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+void WebServer::handle_snapshot_request(AsyncWebServerRequest *request) {
+  // A consistent copy of the pre-encoded records; only the uptime and heap fields are refreshed here
+  const uint8_t *data = this->snapshot_.prepare();
+  AsyncWebServerResponse *response =
+      request->beginResponse(200, "application/octet-stream", data, this->snapshot_.size());
+  request->send(response);
+}
+#endif
+
+void WebServer::handle_metrics_request(AsyncWebServerRequest *request) {
+  // The document is pre-rendered; state updates patch their own value slots
+  const char *data = this->metrics_.prepare();
+  if (data == nullptr) {
+    request->send(503);
+    return;
+  }
+  AsyncWebServerResponse *response =
+      request->beginResponse(200, "text/plain; version=0.0.4", reinterpret_cast<const uint8_t *>(data),
+                             this->metrics_.size());
+  request->send(response);
+}
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
 void WebServer::handle_pna_cors_request(AsyncWebServerRequest *request) {
   AsyncWebServerResponse *response = request->beginResponse(200, ESPHOME_F(""));
@@ -589,6 +616,8 @@ static JsonDetail get_request_detail(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj) {
+  this->snapshot_.update_sensor(obj);
+  this->metrics_.update_sensor(obj);
   if (!this->include_internal_ && obj->is_internal())
     return;
   this->events_.deferrable_send_state(obj, "state", sensor_state_json_generator);
@@ -793,6 +822,8 @@ std::string WebServer::button_json_(button::Button *obj, JsonDetail start_config
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj) {
+  this->snapshot_.update_binary_sensor(obj);
+  this->metrics_.update_binary_sensor(obj);
   if (!this->include_internal_ && obj->is_internal())
     return;
   this->events_.deferrable_send_state(obj, "state", binary_sensor_state_json_generator);
@@ -2187,6 +2218,12 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) const {
   if (url == ESPHOME_F("/0.js"))
     return true;
 #endif
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+  if (url == ESPHOME_F("/snapshot") && method == HTTP_GET)
+    return true;
+#endif
+  if (url == ESPHOME_F("/metrics") && method == HTTP_GET)
+    return true;
 
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
   if (method == HTTP_OPTIONS && request->hasHeader(ESPHOME_F("Access-Control-Request-Private-Network")))
@@ -2339,6 +2376,18 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+  if (url == ESPHOME_F("/snapshot")) {
+    this->handle_snapshot_request(request);
+    return;
+  }
+#endif
+
+  if (url == ESPHOME_F("/metrics")) {
+    this->handle_metrics_request(request);
+    return;
+  }
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
   if (request->method() == HTTP_OPTIONS && request->hasHeader(ESPHOME_F("Access-Control-Request-Private-Network"))) {
     this->handle_pna_cors_request(request);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "list_entities.h"
+#include "metrics.h"
+#include "snapshot.h"
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #ifdef USE_WEBSERVER
@@ -281,6 +283,14 @@ class WebServer : public Controller,
   void handle_pna_cors_request(AsyncWebServerRequest *request);
 #endif
 
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+  /// Handle a binary snapshot request of all sensor states under '/snapshot'.
+  void handle_snapshot_request(AsyncWebServerRequest *request);
+#endif
+
+  /// Handle a Prometheus scrape under '/metrics'.
+  void handle_metrics_request(AsyncWebServerRequest *request);
+
 #ifdef USE_SENSOR
   void on_sensor_update(sensor::Sensor *obj) override;
   /// Handle a sensor request under '/sensor/<id>'.
@@ -607,6 +617,10 @@ class WebServer : public Controller,
   const char *js_include_{nullptr};
 #endif
   bool expose_log_{true};
+#if defined(USE_SENSOR) || defined(USE_BINARY_SENSOR)
+  SensorSnapshot snapshot_;
+#endif
+  PrometheusMetrics metrics_;
 
  private:
 #ifdef USE_SENSOR
@@ -1,10 +1,9 @@
 #include "esphome/core/defines.h"
-#if defined(USE_ESP32) && defined(USE_WEBSERVER_OTA)
+#if defined(USE_WEBSERVER_OTA) && (defined(USE_ESP32) || defined(USE_HOST))
 #include "multipart.h"
 #include "utils.h"
 #include "esphome/core/log.h"
 #include <cstring>
-#include "multipart_parser.h"
 
 namespace esphome::web_server_idf {
 
@@ -12,97 +11,202 @@ static const char *const TAG = "multipart";
 
 // ========== MultipartReader Implementation ==========
 
-MultipartReader::MultipartReader(const std::string &boundary) {
-  // Initialize settings with callbacks
-  memset(&settings_, 0, sizeof(settings_));
-  settings_.on_header_field = on_header_field;
-  settings_.on_header_value = on_header_value;
-  settings_.on_part_data = on_part_data;
-  settings_.on_part_data_end = on_part_data_end;
-
-  ESP_LOGV(TAG, "Initializing multipart parser with boundary: '%s' (len: %zu)", boundary.c_str(), boundary.length());
-
-  // Create parser with boundary
-  parser_ = multipart_parser_init(boundary.c_str(), &settings_);
-  if (parser_) {
-    multipart_parser_set_data(parser_, this);
-  } else {
-    ESP_LOGE(TAG, "Failed to initialize multipart parser");
+MultipartReader::MultipartReader(const char *boundary, size_t boundary_len) {
+  if (boundary_len == 0 || boundary_len > MAX_BOUNDARY_LEN) {
+    ESP_LOGE(TAG, "Invalid multipart boundary length %zu", boundary_len);
+    this->state_ = State::ERROR;
+    return;
   }
+  memcpy(this->delimiter_, "\r\n--", 4);
+  memcpy(this->delimiter_ + 4, boundary, boundary_len);
+  this->delimiter_len_ = static_cast<uint8_t>(4 + boundary_len);
+  // The first delimiter may appear at the very start of the body without a preceding CRLF
+  this->match_ = 2;
+
+  ESP_LOGV(TAG, "Initializing multipart reader with boundary: '%.*s' (len: %zu)", static_cast<int>(boundary_len),
+           boundary, boundary_len);
 }
 
-MultipartReader::~MultipartReader() {
-  if (parser_) {
-    multipart_parser_free(parser_);
+size_t MultipartReader::parse(const char *data, size_t len) {
+  size_t pos = 0;
+  while (pos < len) {
+    switch (this->state_) {
+      case State::PREAMBLE:
+      case State::BODY: {
+        bool found = false;
+        bool in_body = this->state_ == State::BODY;
+        pos += this->scan_delimiter_(data + pos, len - pos, in_body, found);
+        if (!found)
+          break;
+        if (in_body) {
+          ESP_LOGV(TAG, "Part data end");
+          if (this->part_complete_callback_) {
+            this->part_complete_callback_();
+          }
+          // Clear part info for next part
+          this->current_part_ = Part{};
+        }
+        this->dashes_ = 0;
+        this->saw_cr_ = false;
+        this->state_ = State::AFTER_DELIMITER;
+        break;
+      }
+      case State::AFTER_DELIMITER:
+        pos += this->parse_after_delimiter_(data + pos, len - pos);
+        break;
+      case State::HEADERS:
+        pos += this->parse_headers_(data + pos, len - pos);
+        break;
+      case State::DONE:
+        return len;
+      case State::ERROR:
+        ESP_LOGW(TAG, "Parser consumed %zu of %zu bytes - possible error", pos, len);
+        return pos;
+    }
   }
+  return pos;
 }
 
-size_t MultipartReader::parse(const char *data, size_t len) {
-  if (!parser_) {
-    ESP_LOGE(TAG, "Parser not initialized");
-    return 0;
+size_t MultipartReader::scan_delimiter_(const char *data, size_t len, bool emit, bool &found) {
+  const size_t delimiter_len = this->delimiter_len_;
+  size_t start = 0;
+
+  if (this->match_ > 0) {
+    // Continue a delimiter match that started at the end of the previous chunk
+    size_t matched = this->match_;
+    size_t i = 0;
+    while (matched < delimiter_len && i < len && data[i] == this->delimiter_[matched]) {
+      matched++;
+      i++;
+    }
+    if (matched == delimiter_len) {
+      this->match_ = 0;
+      found = true;
+      return i;
+    }
+    if (i == len) {
+      this->match_ = static_cast<uint8_t>(matched);
+      return len;
+    }
+    // Not a delimiter: the held-back bytes and the ones matched here were content. They equal the delimiter
+    // prefix, and no suffix of it can start a new match because the boundary never contains CR.
+    if (emit)
+      this->emit_(this->delimiter_, matched);
+    this->match_ = 0;
+    start = i;
   }
 
-  size_t parsed = multipart_parser_execute(parser_, data, len);
-
-  if (parsed != len) {
-    ESP_LOGW(TAG, "Parser consumed %zu of %zu bytes - possible error", parsed, len);
+  size_t pos = start;
+  while (pos < len) {
+    const char *cr = static_cast<const char *>(memchr(data + pos, '\r', len - pos));
+    if (cr == nullptr)
+      break;
+    size_t at = cr - data;
+    size_t avail = len - at;
+    size_t cmp = avail < delimiter_len ? avail : delimiter_len;
+    if (memcmp(cr, this->delimiter_, cmp) == 0) {
+      if (emit && at > start)
+        this->emit_(data + start, at - start);
+      if (cmp == delimiter_len) {
+        found = true;
+        return at + delimiter_len;
+      }
+      // Possible delimiter cut off by the end of the chunk; decide on the next chunk
+      this->match_ = static_cast<uint8_t>(cmp);
+      return len;
+    }
+    pos = at + 1;
   }
-
-  return parsed;
+  if (emit && len > start)
+    this->emit_(data + start, len - start);
+  return len;
 }
 
-void MultipartReader::process_header_(const char *value, size_t length) {
-  // Process the completed header (field + value pair)
-  const char *field = current_header_field_.c_str();
-  size_t field_len = current_header_field_.length();
-
-  if (str_startswith_case_insensitive(field, field_len, "content-disposition")) {
-    // Parse name and filename from Content-Disposition
-    extract_header_param(value, length, "name", current_part_.name);
-    extract_header_param(value, length, "filename", current_part_.filename);
-  } else if (str_startswith_case_insensitive(field, field_len, "content-type")) {
-    str_trim(value, length, current_part_.content_type);
+size_t MultipartReader::parse_after_delimiter_(const char *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = data[i];
+    if (this->dashes_ == 1) {
+      if (c != '-') {
+        this->state_ = State::ERROR;
+        return i;
+      }
+      ESP_LOGV(TAG, "Closing delimiter");
+      this->state_ = State::DONE;
+      return i + 1;
+    }
+    if (c == '-' && !this->saw_cr_) {
+      this->dashes_ = 1;
+    } else if ((c == ' ' || c == '\t') && !this->saw_cr_) {
+      // Transport padding
+    } else if (c == '\r' && !this->saw_cr_) {
+      this->saw_cr_ = true;
+    } else if (c == '\n' && this->saw_cr_) {
+      this->saw_cr_ = false;
+      this->header_line_len_ = 0;
+      this->state_ = State::HEADERS;
+      return i + 1;
+    } else {
+      this->state_ = State::ERROR;
+      return i;
+    }
   }
-
-  // Clear field for next header
-  current_header_field_.clear();
+  return len;
 }
 
-int MultipartReader::on_header_field(multipart_parser *parser, const char *at, size_t length) {
-  MultipartReader *reader = static_cast<MultipartReader *>(multipart_parser_get_data(parser));
-  reader->current_header_field_.assign(at, length);
-  return 0;
+size_t MultipartReader::parse_headers_(const char *data, size_t len) {
+  size_t pos = 0;
+  while (pos < len) {
+    const char *nl = static_cast<const char *>(memchr(data + pos, '\n', len - pos));
+    size_t end = nl != nullptr ? static_cast<size_t>(nl - data) : len;
+
+    size_t copy = end - pos;
+    size_t room = MAX_HEADER_LINE_LEN - this->header_line_len_;
+    if (copy > room)
+      copy = room;
+    memcpy(this->header_line_ + this->header_line_len_, data + pos, copy);
+    this->header_line_len_ += copy;
+
+    if (nl == nullptr)
+      return len;
+    pos = end + 1;
+
+    if (this->header_line_len_ > 0 && this->header_line_[this->header_line_len_ - 1] == '\r')
+      this->header_line_len_--;
+    if (this->header_line_len_ == 0) {
+      // Empty line ends the part headers
+      this->state_ = State::BODY;
+      return pos;
+    }
+    this->process_header_line_();
+    this->header_line_len_ = 0;
+  }
+  return len;
 }
 
-int MultipartReader::on_header_value(multipart_parser *parser, const char *at, size_t length) {
-  MultipartReader *reader = static_cast<MultipartReader *>(multipart_parser_get_data(parser));
-  reader->process_header_(at, length);
-  return 0;
-}
+void MultipartReader::process_header_line_() {
+  const char *line = this->header_line_;
+  size_t line_len = this->header_line_len_;
+  const char *colon = static_cast<const char *>(memchr(line, ':', line_len));
+  if (colon == nullptr)
+    return;
+  size_t field_len = colon - line;
+  const char *value = colon + 1;
+  size_t value_len = line_len - field_len - 1;
 
-int MultipartReader::on_part_data(multipart_parser *parser, const char *at, size_t length) {
-  MultipartReader *reader = static_cast<MultipartReader *>(multipart_parser_get_data(parser));
-  // Only process file uploads
-  if (reader->has_file() && reader->data_callback_) {
-    // IMPORTANT: The 'at' pointer points to data within the parser's input buffer.
-    // This data is only valid during this callback. The callback handler MUST
-    // process or copy the data immediately - it cannot store the pointer for
-    // later use as the buffer will be overwritten.
-    reader->data_callback_(reinterpret_cast<const uint8_t *>(at), length);
+  if (str_startswith_case_insensitive(line, field_len, "content-disposition")) {
+    // Parse name and filename from Content-Disposition
+    extract_header_param(value, value_len, "name", this->current_part_.name);
+    extract_header_param(value, value_len, "filename", this->current_part_.filename);
+  } else if (str_startswith_case_insensitive(line, field_len, "content-type")) {
+    str_trim(value, value_len, this->current_part_.content_type);
   }
-  return 0;
 }
 
-int MultipartReader::on_part_data_end(multipart_parser *parser) {
-  MultipartReader *reader = static_cast<MultipartReader *>(multipart_parser_get_data(parser));
-  ESP_LOGV(TAG, "Part data end");
-  if (reader->part_complete_callback_) {
-    reader->part_complete_callback_();
+void MultipartReader::emit_(const char *data, size_t len) {
+  // Only process file uploads
+  if (this->has_file() && this->data_callback_) {
+    this->data_callback_(reinterpret_cast<const uint8_t *>(data), len);
   }
-  // Clear part info for next part
-  reader->current_part_ = Part{};
-  return 0;
 }
 
 // ========== Utility Functions ==========
@@ -260,4 +364,4 @@ void str_trim(const char *str, size_t len, std::string &out) {
 }
 
 }  // namespace esphome::web_server_idf
-#endif  // defined(USE_ESP32) && defined(USE_WEBSERVER_OTA)
+#endif  // defined(USE_WEBSERVER_OTA) && (defined(USE_ESP32) || defined(USE_HOST))
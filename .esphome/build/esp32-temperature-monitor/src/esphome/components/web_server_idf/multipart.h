@@ -1,18 +1,22 @@
 #pragma once
 #include "esphome/core/defines.h"
-#if defined(USE_ESP32) && defined(USE_WEBSERVER_OTA)
+#if defined(USE_WEBSERVER_OTA) && (defined(USE_ESP32) || defined(USE_HOST))
 
 #include <cctype>
 #include <cstring>
-#include <esp_http_server.h>
 #include <functional>
-#include <multipart_parser.h>
 #include <string>
 #include <utility>
 
 namespace esphome::web_server_idf {
 
-// Wrapper around zorxx/multipart-parser for ESP-IDF OTA uploads
+/// Streaming multipart/form-data reader for ESP-IDF OTA uploads.
+///
+/// The receive buffer is scanned in place for the boundary delimiter. Body bytes are passed to the data callback as
+/// spans pointing into the caller's buffer, so they reach the OTA backend without an intermediate copy. If a chunk
+/// ends inside a possible delimiter, those bytes are held back. They are always a prefix of the delimiter itself, so
+/// if the match fails they are re-emitted from the stored delimiter instead of from a saved copy. Nothing is
+/// allocated per chunk. Only part headers, which are small, are accumulated into a fixed line buffer.
 class MultipartReader {
  public:
   struct Part {
@@ -21,22 +25,27 @@ class MultipartReader {
     std::string content_type;
   };
 
+  /// RFC 2046 limits the boundary to 70 characters.
+  static constexpr size_t MAX_BOUNDARY_LEN = 70;
+  /// Longer header lines are truncated; only Content-Disposition and Content-Type are interpreted.
+  static constexpr size_t MAX_HEADER_LINE_LEN = 256;
+
   // IMPORTANT: The data pointer in DataCallback is only valid during the callback!
-  // The multipart parser passes pointers to its internal buffer which will be
-  // overwritten after the callback returns. Callbacks MUST process or copy the
-  // data immediately - storing the pointer for deferred processing will result
-  // in use-after-free bugs.
+  // It points into the buffer passed to parse() (or into the reader's delimiter copy for held-back bytes).
+  // Callbacks MUST process or copy the data immediately - storing the pointer for deferred processing will
+  // result in use-after-free bugs.
   using DataCallback = std::function<void(const uint8_t *data, size_t len)>;
   using PartCompleteCallback = std::function<void()>;
 
-  explicit MultipartReader(const std::string &boundary);
-  ~MultipartReader();
+  /// @param boundary The boundary parameter from the Content-Type header, without the leading "--".
+  MultipartReader(const char *boundary, size_t boundary_len);
 
   // Set callbacks for handling data
   void set_data_callback(DataCallback callback) { data_callback_ = std::move(callback); }
   void set_part_complete_callback(PartCompleteCallback callback) { part_complete_callback_ = std::move(callback); }
 
-  // Parse incoming data
+  /// Parse the next chunk of the request body. Returns the number of bytes consumed, which is less than len on a
+  /// malformed body or an unusable boundary.
   size_t parse(const char *data, size_t len);
 
   // Get current part info
@@ -45,22 +54,42 @@ class MultipartReader {
   // Check if we found a file upload
   bool has_file() const { return !current_part_.filename.empty(); }
 
+  /// True once the closing delimiter has been seen.
+  bool is_done() const { return state_ == State::DONE; }
+
  private:
-  static int on_header_field(multipart_parser *parser, const char *at, size_t length);
-  static int on_header_value(multipart_parser *parser, const char *at, size_t length);
-  static int on_part_data(multipart_parser *parser, const char *at, size_t length);
-  static int on_part_data_end(multipart_parser *parser);
+  enum class State : uint8_t {
+    PREAMBLE,         // Before the first delimiter, content is ignored
+    AFTER_DELIMITER,  // Expecting "--" (close) or transport padding followed by CRLF
+    HEADERS,          // Part header lines up to the empty line
+    BODY,             // Part content up to the next delimiter
+    DONE,             // Closing delimiter seen, epilogue is ignored
+    ERROR,
+  };
 
-  multipart_parser *parser_{nullptr};
-  multipart_parser_settings settings_{};
+  size_t scan_delimiter_(const char *data, size_t len, bool emit, bool &found);
+  size_t parse_after_delimiter_(const char *data, size_t len);
+  size_t parse_headers_(const char *data, size_t len);
+  void emit_(const char *data, size_t len);
+  void process_header_line_();
+
+  // "\r\n--" + boundary
+  char delimiter_[4 + MAX_BOUNDARY_LEN];
+  uint8_t delimiter_len_{0};
+  /// Number of delimiter bytes matched at the end of the previous chunk.
+  uint8_t match_{0};
+  /// Dashes seen in AFTER_DELIMITER; a CR seen in AFTER_DELIMITER/HEADERS is tracked by saw_cr_.
+  uint8_t dashes_{0};
+  bool saw_cr_{false};
+  State state_{State::PREAMBLE};
+
+  char header_line_[MAX_HEADER_LINE_LEN];
+  uint16_t header_line_len_{0};
 
   Part current_part_;
-  std::string current_header_field_;
 
   DataCallback data_callback_;
   PartCompleteCallback part_complete_callback_;
-
-  void process_header_(const char *value, size_t length);
 };
 
 // ========== Utility Functions ==========
@@ -82,4 +111,4 @@ bool parse_multipart_boundary(const char *content_type, const char **boundary_st
 void str_trim(const char *str, size_t len, std::string &out);
 
 }  // namespace esphome::web_server_idf
-#endif  // defined(USE_ESP32) && defined(USE_WEBSERVER_OTA)
+#endif  // defined(USE_WEBSERVER_OTA) && (defined(USE_ESP32) || defined(USE_HOST))
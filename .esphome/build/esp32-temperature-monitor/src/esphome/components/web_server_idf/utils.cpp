@@ -1,10 +1,13 @@
-#ifdef USE_ESP32
+#include "esphome/core/defines.h"
+#if defined(USE_ESP32) || defined(USE_HOST)
 #include <memory>
 #include <cstring>
 #include <cctype>
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#ifdef USE_ESP32
 #include "http_parser.h"
+#endif
 
 #include "utils.h"
 
@@ -35,6 +38,7 @@ size_t url_decode(char *str) {
   return ptr - start;
 }
 
+#ifdef USE_ESP32
 bool request_has_header(httpd_req_t *req, const char *name) { return httpd_req_get_hdr_value_len(req, name); }
 
 optional<std::string> request_get_header(httpd_req_t *req, const char *name) {
@@ -87,6 +91,7 @@ optional<std::string> query_key_value(const char *query_url, size_t query_len, c
   url_decode(val.get());
   return {val.get()};
 }
+#endif  // USE_ESP32
 
 // Helper function for case-insensitive string region comparison
 bool str_ncmp_ci(const char *s1, const char *s2, size_t n) {
@@ -124,4 +129,4 @@ const char *strcasestr_n(const char *haystack, size_t haystack_len, const char *
 }
 
 }  // namespace esphome::web_server_idf
-#endif  // USE_ESP32
+#endif  // defined(USE_ESP32) || defined(USE_HOST)
@@ -1,9 +1,12 @@
 #pragma once
-#ifdef USE_ESP32
+// The request helpers need the ESP-IDF httpd; the string helpers are also built on the host for the multipart test
+#if defined(USE_ESP32) || defined(USE_HOST)
 
-#include <esp_http_server.h>
 #include <string>
 #include "esphome/core/helpers.h"
+#ifdef USE_ESP32
+#include <esp_http_server.h>
+#endif
 
 namespace esphome::web_server_idf {
 
@@ -11,6 +14,7 @@ namespace esphome::web_server_idf {
 /// Returns the new length of the decoded string
 size_t url_decode(char *str);
 
+#ifdef USE_ESP32
 bool request_has_header(httpd_req_t *req, const char *name);
 optional<std::string> request_get_header(httpd_req_t *req, const char *name);
 optional<std::string> request_get_url_query(httpd_req_t *req);
@@ -18,6 +22,7 @@ optional<std::string> query_key_value(const char *query_url, size_t query_len, c
 inline optional<std::string> query_key_value(const std::string &query_url, const std::string &key) {
   return query_key_value(query_url.c_str(), query_url.size(), key.c_str());
 }
+#endif  // USE_ESP32
 
 // Helper function for case-insensitive character comparison
 inline bool char_equals_ci(char a, char b) { return ::tolower(a) == ::tolower(b); }
@@ -29,4 +34,4 @@ bool str_ncmp_ci(const char *s1, const char *s2, size_t n);
 const char *strcasestr_n(const char *haystack, size_t haystack_len, const char *needle);
 
 }  // namespace esphome::web_server_idf
-#endif  // USE_ESP32
+#endif  // defined(USE_ESP32) || defined(USE_HOST)
@@ -17,7 +17,6 @@
 #include "web_server_idf.h"
 
 #ifdef USE_WEBSERVER_OTA
-#include <multipart_parser.h>
 #include "multipart.h"  // For parse_multipart_boundary and other utils
 #endif
 
@@ -826,7 +825,9 @@ void AsyncEventSourceResponse::deferrable_send_state(void *source, const char *e
 
 #ifdef USE_WEBSERVER_OTA
 esp_err_t AsyncWebServer::handle_multipart_upload_(httpd_req_t *r, const char *content_type) {
-  static constexpr size_t MULTIPART_CHUNK_SIZE = 1460;       // Match Arduino AsyncWebServer buffer size
+  // Receive window; body spans are handed to the upload handler in place, so larger chunks mean fewer
+  // recv calls and larger OTA backend writes
+  static constexpr size_t MULTIPART_CHUNK_SIZE = 4096;
   static constexpr size_t YIELD_INTERVAL_BYTES = 16 * 1024;  // Yield every 16KB to prevent watchdog
 
   // Parse boundary and create reader
@@ -857,7 +858,7 @@ esp_err_t AsyncWebServer::handle_multipart_upload_(httpd_req_t *r, const char *c
   std::string filename;
   size_t index = 0;
   // Create reader on heap to reduce stack usage
-  auto reader = std::make_unique<MultipartReader>("--" + std::string(boundary_start, boundary_len));
+  auto reader = std::make_unique<MultipartReader>(boundary_start, boundary_len);
 
   // Configure callbacks
   reader->set_data_callback([&](const uint8_t *data, size_t len) {
@@ -882,7 +883,7 @@ esp_err_t AsyncWebServer::handle_multipart_upload_(httpd_req_t *r, const char *c
     }
   });
 
-  // Use heap buffer - 1460 bytes is too large for the httpd task stack
+  // Use heap buffer - too large for the httpd task stack; allocated once for the whole upload
   auto buffer = std::make_unique<char[]>(MULTIPART_CHUNK_SIZE);
   size_t bytes_since_yield = 0;
 
@@ -2,6 +2,7 @@
 #include "esphome/core/build_info_data.h"
 #include "esphome/core/log.h"
 #include "esphome/core/progmem.h"
+#include "esphome/core/trace.h"
 #include <cstring>
 
 #ifdef USE_ESP8266
@@ -17,6 +18,9 @@
 #ifdef USE_RUNTIME_STATS
 #include "esphome/components/runtime_stats/runtime_stats.h"
 #endif
+#ifdef USE_CONTROLLER_REGISTRY
+#include "esphome/core/controller_registry.h"
+#endif
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
@@ -98,47 +102,45 @@ void Application::setup() {
   // Initialize looping_components_ early so enable_pending_loops_() works during setup
   this->calculate_looping_components_();
 
-  for (uint32_t i = 0; i < this->components_.size(); i++) {
-    Component *component = this->components_[i];
-
-    // Update loop_component_start_time_ before calling each component during setup
-    this->loop_component_start_time_ = millis();
-    component->call();
-    this->scheduler.process_to_add();
-    this->feed_wdt();
-    if (component->can_proceed())
-      continue;
-
-    // Sort components 0 through i by loop priority
-    insertion_sort_by_priority<decltype(this->components_.begin()), &Component::get_loop_priority>(
-        this->components_.begin(), this->components_.begin() + i + 1);
+  this->setup_start_time_ = millis();
+  this->setup_profile_.init(this->components_.size());
+  for (auto *component : this->components_) {
+    this->setup_profile_.push_back(
+        SetupProfileEntry{component, SetupProfileEntry::PENDING, 0, SetupProfileEntry::PENDING});
+  }
 
-    do {
-      uint8_t new_app_state = STATUS_LED_WARNING;
-      uint32_t now = millis();
+  // Components whose setup() has run, sorted by loop priority for the loop passes below
+  StaticVector<Component *, ESPHOME_COMPONENT_COUNT> started;
+  while (!this->setup_pass_(started)) {
+    uint8_t new_app_state = STATUS_LED_WARNING;
+    uint32_t now = millis();
 
-      // Process pending loop enables to handle GPIO interrupts during setup
-      this->before_loop_tasks_(now);
+    // Process pending loop enables to handle GPIO interrupts during setup
+    this->before_loop_tasks_(now);
 
-      for (uint32_t j = 0; j <= i; j++) {
-        // Update loop_component_start_time_ right before calling each component
-        this->loop_component_start_time_ = millis();
-        this->components_[j]->call();
-        new_app_state |= this->components_[j]->get_component_state();
-        this->app_state_ |= new_app_state;
-        this->feed_wdt();
-      }
+    for (auto *component : started) {
+      // Update loop_component_start_time_ right before calling each component
+      this->loop_component_start_time_ = millis();
+      Component *previous = this->get_current_component();
+      this->set_current_component(component);
+      component->call();
+      this->set_current_component(previous);
+      new_app_state |= component->get_component_state();
+      this->app_state_ |= new_app_state;
+      this->feed_wdt();
+    }
 
-      this->after_loop_tasks_();
-      this->app_state_ = new_app_state;
-      yield();
-    } while (!component->can_proceed() && !component->is_failed());
+    this->after_loop_tasks_();
+    this->app_state_ = new_app_state;
+    yield();
   }
 
   ESP_LOGI(TAG, "setup() finished successfully!");
+  this->log_setup_profile_();
 
-  // Clear setup priority overrides to free memory
+  // Clear setup priority overrides and dependencies to free memory
   clear_setup_priority_overrides();
+  clear_setup_dependencies();
 
 #if defined(USE_SOCKET_SELECT_SUPPORT) && defined(USE_WAKE_LOOP_THREADSAFE)
   // Set up wake socket for waking main loop from tasks
@@ -147,11 +149,110 @@ void Application::setup() {
 
   this->schedule_dump_config();
 }
+// One pass over the components in setup priority order, starting every component that may run now.
+//
+// Components without declared dependencies keep the classic ordering: each waits until all earlier ones of them have
+// been set up and can_proceed(). Components with dependencies (Component::add_setup_dependency()) start as soon as
+// those have finished, so an I2C sensor can still be calibrating through an async setup while WiFi associates.
+// Returns true once every component has been set up and none of the ordered ones is holding the rest back.
+bool Application::setup_pass_(StaticVector<Component *, ESPHOME_COMPONENT_COUNT> &started) {
+  bool ordered_blocked = false;
+  bool all_started = true;
+  bool busy = false;  // something was started or is still setting up, so waiting components may get unblocked
+  for (uint32_t i = 0; i < this->components_.size(); i++) {
+    Component *component = this->components_[i];
+    SetupProfileEntry &entry = this->setup_profile_[i];
+    bool ordered = !component->has_setup_dependencies();
+    if (entry.start_ms == SetupProfileEntry::PENDING) {
+      if (ordered ? ordered_blocked : !component->are_setup_dependencies_finished()) {
+        all_started = false;
+        ordered_blocked |= ordered;
+        continue;
+      }
+      this->start_component_setup_(i, started);
+    }
+    if (entry.finished_ms == SetupProfileEntry::PENDING) {
+      busy = true;
+      if (component->is_setup_finished()) {
+        entry.finished_ms = millis() - this->setup_start_time_;
+      } else if (ordered && !component->can_proceed() && !component->is_failed()) {
+        ordered_blocked = true;
+      }
+    }
+  }
+
+  if (!all_started && !busy) {
+    // Nothing is running and nothing can start: a dependency cycle or a dependency that was never registered.
+    // Start the first waiting component anyway rather than hang.
+    for (uint32_t i = 0; i < this->components_.size(); i++) {
+      if (this->setup_profile_[i].start_ms == SetupProfileEntry::PENDING) {
+        ESP_LOGW(TAG, "Setup dependencies of %s can't be met, starting it anyway",
+                 LOG_STR_ARG(this->components_[i]->get_component_log_str()));
+        this->start_component_setup_(i, started);
+        break;
+      }
+    }
+    return false;
+  }
+  return all_started && !ordered_blocked;
+}
+
+void Application::start_component_setup_(uint32_t index, StaticVector<Component *, ESPHOME_COMPONENT_COUNT> &started) {
+  Component *component = this->components_[index];
+  SetupProfileEntry &entry = this->setup_profile_[index];
+
+  // Update loop_component_start_time_ before calling each component during setup
+  this->loop_component_start_time_ = millis();
+  entry.start_ms = this->loop_component_start_time_ - this->setup_start_time_;
+#ifdef USE_TRACE_RECORDER
+  const uint32_t trace_start = ESPHOME_TRACE_NOW();
+#endif
+  Component *previous = this->get_current_component();
+  this->set_current_component(component);
+  component->call();
+  this->set_current_component(previous);
+  ESPHOME_TRACE(COMPONENT_SETUP, component, LOG_STR_ARG(component->get_component_log_str()), trace_start, 0,
+                ESPHOME_TRACE_NOW() - trace_start);
+  entry.setup_ms = millis() - this->loop_component_start_time_;
+  this->scheduler.process_to_add();
+  this->feed_wdt();
+
+  started.push_back(component);
+  insertion_sort_by_priority<decltype(started.begin()), &Component::get_loop_priority>(started.begin(), started.end());
+}
+
+void Application::record_setup_finished_(Component *component) {
+  for (auto &entry : this->setup_profile_) {
+    if (entry.component == component) {
+      if (entry.finished_ms == SetupProfileEntry::PENDING && component->is_setup_finished())
+        entry.finished_ms = millis() - this->setup_start_time_;
+      return;
+    }
+  }
+}
+
+void Application::log_setup_profile_() {
+  ESP_LOGD(TAG, "Setup profile (ms since setup start):");
+  for (const auto &entry : this->setup_profile_) {
+    if (entry.finished_ms == SetupProfileEntry::PENDING) {
+      ESP_LOGD(TAG, "  %-16s start %5" PRIu32 ", setup() %4" PRIu32 ", still setting up",
+               LOG_STR_ARG(entry.component->get_component_log_str()), entry.start_ms, entry.setup_ms);
+    } else {
+      ESP_LOGD(TAG, "  %-16s start %5" PRIu32 ", setup() %4" PRIu32 ", finished %5" PRIu32,
+               LOG_STR_ARG(entry.component->get_component_log_str()), entry.start_ms, entry.setup_ms,
+               entry.finished_ms);
+    }
+  }
+}
+
 void Application::loop() {
   uint8_t new_app_state = 0;
 
   // Get the initial loop time at the start
   uint32_t last_op_end_time = millis();
+#ifdef USE_TRACE_RECORDER
+  const uint32_t trace_loop_start = ESPHOME_TRACE_NOW();
+#endif
 
   this->before_loop_tasks_(last_op_end_time);
 
@@ -163,9 +264,17 @@ void Application::loop() {
     this->loop_component_start_time_ = last_op_end_time;
 
     {
+      // Restored afterwards so work between components (scheduler, API, logger) isn't charged to the last one
+      Component *previous = this->get_current_component();
       this->set_current_component(component);
       WarnIfComponentBlockingGuard guard{component, last_op_end_time};
+#ifdef USE_TRACE_RECORDER
+      const uint32_t trace_start = ESPHOME_TRACE_NOW();
+#endif
       component->call();
+      this->set_current_component(previous);
+      ESPHOME_TRACE(COMPONENT_LOOP, component, LOG_STR_ARG(component->get_component_log_str()), trace_start, 0,
+                    ESPHOME_TRACE_NOW() - trace_start);
       // Use the finish method to get the current time as the end time
       last_op_end_time = guard.finish();
     }
@@ -176,6 +285,8 @@ void Application::loop() {
 
   this->after_loop_tasks_();
   this->app_state_ = new_app_state;
+  ESPHOME_TRACE_NO_SOURCE(APP_LOOP, trace_loop_start, this->looping_components_active_end_,
+                          ESPHOME_TRACE_NOW() - trace_loop_start);
 
 #ifdef USE_RUNTIME_STATS
   // Process any pending runtime stats printing after all components have run
@@ -551,6 +662,10 @@ void Application::before_loop_tasks_(uint32_t loop_start_time) {
 void Application::after_loop_tasks_() {
   // Clear the in_loop_ flag to indicate we're done processing components
   this->in_loop_ = false;
+#ifdef USE_CONTROLLER_REGISTRY
+  // Hand each controller the latest state of every entity that changed this iteration
+  ControllerRegistry::flush();
+#endif
 }
 
 #ifdef USE_SOCKET_SELECT_SUPPORT
@@ -254,6 +254,18 @@ class Application {
   /// Set up all the registered components. Call this at the end of your setup() function.
   void setup();
 
+  /// Boot timing of one component, recorded by setup(). Times are ms since setup() started.
+  struct SetupProfileEntry {
+    static constexpr uint32_t PENDING = UINT32_MAX;
+    Component *component;
+    uint32_t start_ms;     ///< setup() called, PENDING if it was never called
+    uint32_t setup_ms;     ///< Time spent inside setup()
+    uint32_t finished_ms;  ///< is_setup_finished() first seen true, PENDING while it is still setting up
+  };
+
+  /// Per-component boot profile in setup priority order. Empty before setup().
+  const FixedVector<SetupProfileEntry> &get_setup_profile() const { return this->setup_profile_; }
+
   /// Make a loop iteration. Call this in your loop() function.
   void loop();
 
@@ -520,6 +532,13 @@ class Application {
 
   void register_component_(Component *comp);
 
+  // Setup scheduling helpers, see setup()
+  bool setup_pass_(StaticVector<Component *, ESPHOME_COMPONENT_COUNT> &started);
+  void start_component_setup_(uint32_t index, StaticVector<Component *, ESPHOME_COMPONENT_COUNT> &started);
+  /// Called by Component::finish_async_setup_() to complete the component's profile entry.
+  void record_setup_finished_(Component *component);
+  void log_setup_profile_();
+
   void calculate_looping_components_();
   void add_looping_components_by_state_(bool match_loop_done);
 
@@ -571,6 +590,7 @@ class Application {
   //   and active_end_ is incremented
   // - This eliminates branch mispredictions from flag checking in the hot loop
   FixedVector<Component *> looping_components_{};
+  FixedVector<SetupProfileEntry> setup_profile_{};
 #ifdef USE_SOCKET_SELECT_SUPPORT
   std::vector<int> socket_fds_;  // Vector of all monitored socket file descriptors
 #ifdef USE_WAKE_LOOP_THREADSAFE
@@ -588,6 +608,7 @@ class Application {
   // 4-byte members
   uint32_t last_loop_{0};
   uint32_t loop_component_start_time_{0};
+  uint32_t setup_start_time_{0};
 
 #ifdef USE_SOCKET_SELECT_SUPPORT
   int max_fd_{-1};  // Highest file descriptor number for select()
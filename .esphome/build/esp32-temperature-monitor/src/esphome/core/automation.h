@@ -7,6 +7,7 @@
 #include "esphome/core/string_ref.h"
 #include <concepts>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -47,6 +48,12 @@ template<typename T, typename... X> class TemplatableValue {
   // For other types, store value inline.
   static constexpr bool USE_HEAP_STORAGE = std::same_as<T, std::string>;
 
+  // Closures up to one pointer in size (`[this]`, `[ptr]`, `[id]`) are stored inline.
+  // They must be trivially copyable/destructible so copy, move and destroy stay no-ops.
+  template<typename F>
+  static constexpr bool FITS_INLINE = sizeof(F) <= sizeof(void *) && alignof(F) <= alignof(void *) &&
+                                      std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>;
+
  public:
   TemplatableValue() : type_(NONE) {}
 
@@ -71,9 +78,19 @@ template<typename T, typename... X> class TemplatableValue {
     this->stateless_f_ = f;  // Implicit conversion to function pointer
   }
 
-  // For stateful lambdas (not convertible to function pointer): use std::function
+  // For small stateful lambdas (e.g. capturing `this`): store the closure inline and call it through
+  // a per-type trampoline, so no std::function is allocated and value() is a single direct call
+  template<typename F>
+  TemplatableValue(F f) requires std::invocable<F, X...> &&(!std::convertible_to<F, T (*)(X...)>) &&
+      FITS_INLINE<F> : type_(INLINE_LAMBDA) {
+    new (this->inline_f_.storage) F(std::move(f));
+    this->inline_f_.invoke = &invoke_inline_<F>;
+  }
+
+  // For other stateful lambdas (not convertible to function pointer): use std::function
   template<typename F>
-  TemplatableValue(F f) requires std::invocable<F, X...> &&(!std::convertible_to<F, T (*)(X...)>) : type_(LAMBDA) {
+  TemplatableValue(F f) requires std::invocable<F, X...> &&(!std::convertible_to<F, T (*)(X...)>) &&
+      (!FITS_INLINE<F>) : type_(LAMBDA) {
     this->f_ = new std::function<T(X...)>(std::move(f));
   }
 
@@ -89,6 +106,8 @@ template<typename T, typename... X> class TemplatableValue {
       this->f_ = new std::function<T(X...)>(*other.f_);
     } else if (this->type_ == STATELESS_LAMBDA) {
       this->stateless_f_ = other.stateless_f_;
+    } else if (this->type_ == INLINE_LAMBDA) {
+      this->inline_f_ = other.inline_f_;  // Trivially copyable closure, plain copy
     } else if (this->type_ == STATIC_STRING) {
       this->static_str_ = other.static_str_;
     }
@@ -108,6 +127,8 @@ template<typename T, typename... X> class TemplatableValue {
       other.f_ = nullptr;
     } else if (this->type_ == STATELESS_LAMBDA) {
       this->stateless_f_ = other.stateless_f_;
+    } else if (this->type_ == INLINE_LAMBDA) {
+      this->inline_f_ = other.inline_f_;
     } else if (this->type_ == STATIC_STRING) {
       this->static_str_ = other.static_str_;
     }
@@ -141,7 +162,7 @@ template<typename T, typename... X> class TemplatableValue {
     } else if (this->type_ == LAMBDA) {
       delete this->f_;
     }
-    // STATELESS_LAMBDA/STATIC_STRING/NONE: no cleanup needed (pointers, not heap-allocated)
+    // STATELESS_LAMBDA/INLINE_LAMBDA/STATIC_STRING/NONE: no cleanup needed (trivially destructible, not heap-allocated)
   }
 
   bool has_value() const { return this->type_ != NONE; }
@@ -150,6 +171,8 @@ template<typename T, typename... X> class TemplatableValue {
     switch (this->type_) {
       case STATELESS_LAMBDA:
         return this->stateless_f_(x...);  // Direct function pointer call
+      case INLINE_LAMBDA:
+        return this->inline_f_.invoke(this->inline_f_.storage, x...);  // Trampoline into the inline closure
       case LAMBDA:
         return (*this->f_)(x...);  // std::function call
       case VALUE:
@@ -193,7 +216,7 @@ template<typename T, typename... X> class TemplatableValue {
 
   /// Check if the string value is empty without allocating (for std::string specialization).
   /// For NONE, returns true. For STATIC_STRING/VALUE, checks without allocation.
-  /// For LAMBDA/STATELESS_LAMBDA, must call value() which may allocate.
+  /// For LAMBDA/INLINE_LAMBDA/STATELESS_LAMBDA, must call value() which may allocate.
   bool is_empty() const requires std::same_as<T, std::string> {
     switch (this->type_) {
       case NONE:
@@ -202,14 +225,14 @@ template<typename T, typename... X> class TemplatableValue {
         return this->static_str_ == nullptr || this->static_str_[0] == '\0';
       case VALUE:
         return this->value_->empty();
-      default:  // LAMBDA/STATELESS_LAMBDA - must call value()
+      default:  // LAMBDA/INLINE_LAMBDA/STATELESS_LAMBDA - must call value()
         return this->value().empty();
     }
   }
 
   /// Get a StringRef to the string value without heap allocation when possible.
   /// For STATIC_STRING/VALUE, returns reference to existing data (no allocation).
-  /// For LAMBDA/STATELESS_LAMBDA, calls value(), copies to provided buffer, returns ref to buffer.
+  /// For LAMBDA/INLINE_LAMBDA/STATELESS_LAMBDA, calls value(), copies to provided buffer, returns ref to buffer.
   /// @param lambda_buf Buffer used only for lambda case (must remain valid while StringRef is used).
   /// @param lambda_buf_size Size of the buffer.
   /// @return StringRef pointing to the string data.
@@ -223,7 +246,7 @@ template<typename T, typename... X> class TemplatableValue {
         return StringRef(this->static_str_, strlen(this->static_str_));
       case VALUE:
         return StringRef(this->value_->data(), this->value_->size());
-      default: {  // LAMBDA/STATELESS_LAMBDA - must call value() and copy
+      default: {  // LAMBDA/INLINE_LAMBDA/STATELESS_LAMBDA - must call value() and copy
         std::string result = this->value();
         size_t copy_len = std::min(result.size(), lambda_buf_size - 1);
         memcpy(lambda_buf, result.data(), copy_len);
@@ -233,13 +256,25 @@ template<typename T, typename... X> class TemplatableValue {
     }
   }
 
- protected : enum : uint8_t {
-   NONE,
-   VALUE,
-   LAMBDA,
-   STATELESS_LAMBDA,
-   STATIC_STRING,  // For const char* when T is std::string - avoids heap allocation
- } type_;
+ protected:
+  template<typename F> static T invoke_inline_(const void *storage, X... x) {
+    // The closure may be `mutable`; std::function permits the same through its const operator()
+    return (*const_cast<F *>(static_cast<const F *>(storage)))(x...);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+
+  struct InlineLambda {
+    alignas(void *) unsigned char storage[sizeof(void *)];
+    T (*invoke)(const void *, X...);
+  };
+
+  enum : uint8_t {
+    NONE,
+    VALUE,
+    LAMBDA,
+    STATELESS_LAMBDA,
+    INLINE_LAMBDA,  // For small trivially copyable closures - stored in inline_f_, no heap allocation
+    STATIC_STRING,  // For const char* when T is std::string - avoids heap allocation
+  } type_;
   // For std::string, use heap pointer to minimize union size (4 bytes vs 12+).
   // For other types, store value inline as before.
   using ValueStorage = std::conditional_t<USE_HEAP_STORAGE, T *, T>;
@@ -247,6 +282,7 @@ template<typename T, typename... X> class TemplatableValue {
     ValueStorage value_;  // T for inline storage, T* for heap storage
     std::function<T(X...)> *f_;
     T (*stateless_f_)(X...);
+    InlineLambda inline_f_;   // For INLINE_LAMBDA type
     const char *static_str_;  // For STATIC_STRING type
   };
 };
@@ -300,6 +336,94 @@ template<typename... Ts> class Trigger {
   Automation<Ts...> *automation_parent_{nullptr};
 };
 
+#ifndef ESPHOME_AUTOMATION_MAX_RUNS
+// Run slots reserved per pooled action when the automation does not set max_runs
+#define ESPHOME_AUTOMATION_MAX_RUNS 4
+#endif
+
+/** Fixed-size slot pool for per-run state of actions that outlive play_complex().
+ *
+ * Slots are addressed by index so a pending continuation can hold one across a resize.
+ * The pool is sized once from max_runs; acquire() only grows it (doubling) when more
+ * runs are in flight than were reserved, so steady-state runs never touch the heap.
+ *
+ * @tparam T The per-run state stored inline in each slot.
+ */
+template<typename T> class RunStatePool {
+ public:
+  static constexpr uint16_t NONE = 0xFFFF;
+
+  /// Reserve room for `capacity` concurrent runs. Only valid while no slot is in use.
+  void init(uint16_t capacity) {
+    if (this->in_use_ != 0 || capacity == this->capacity_)
+      return;
+    this->slots_.reset();
+    this->capacity_ = 0;
+    this->free_head_ = NONE;
+    this->resize_(capacity);
+  }
+
+  /// Claim a free slot and return its index. Grows the pool if every slot is taken.
+  uint16_t acquire() {
+    if (this->free_head_ == NONE)
+      this->resize_(this->capacity_ == 0 ? ESPHOME_AUTOMATION_MAX_RUNS : this->capacity_ * 2);
+    uint16_t index = this->free_head_;
+    Slot &slot = this->slots_[index];
+    this->free_head_ = slot.next_free;
+    slot.used = true;
+    this->in_use_++;
+    return index;
+  }
+
+  /// Return a slot to the free list.
+  void release(uint16_t index) {
+    Slot &slot = this->slots_[index];
+    if (!slot.used)
+      return;
+    slot.used = false;
+    slot.next_free = this->free_head_;
+    this->free_head_ = index;
+    this->in_use_--;
+  }
+
+  /// Release every slot.
+  void clear() {
+    for (uint16_t i = 0; i < this->capacity_; i++)
+      this->release(i);
+  }
+
+  T &operator[](uint16_t index) { return this->slots_[index].value; }
+  bool is_used(uint16_t index) const { return this->slots_[index].used; }
+  uint16_t capacity() const { return this->capacity_; }
+  uint16_t size() const { return this->in_use_; }
+  bool empty() const { return this->in_use_ == 0; }
+
+ protected:
+  struct Slot {
+    T value{};
+    uint16_t next_free{NONE};
+    bool used{false};
+  };
+
+  void resize_(uint16_t capacity) {
+    std::unique_ptr<Slot[]> slots(new Slot[capacity]);  // NOLINT(cppcoreguidelines-owning-memory)
+    for (uint16_t i = 0; i < this->capacity_; i++)
+      slots[i] = std::move(this->slots_[i]);
+    // Chain the new slots in index order so the lowest free index is handed out first
+    for (uint16_t i = capacity; i-- > this->capacity_;) {
+      slots[i].next_free = this->free_head_;
+      this->free_head_ = i;
+    }
+    this->slots_ = std::move(slots);
+    this->capacity_ = capacity;
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  uint16_t capacity_{0};
+  uint16_t in_use_{0};
+  uint16_t free_head_{NONE};
+};
+
 template<typename... Ts> class ActionList;
 
 template<typename... Ts> class Action {
@@ -328,6 +452,10 @@ template<typename... Ts> class Action {
     return total;
   }
 
+  /// Size per-run state for up to `max_runs` concurrent runs. Actions that keep state across
+  /// a delay override this; containers forward it to their nested action lists.
+  virtual void reserve_runs(uint16_t max_runs) {}
+
  protected:
   friend ActionList<Ts...>;
   template<typename... Us> friend class ContinuationAction;
@@ -395,6 +523,11 @@ template<typename... Ts> class ActionList {
       this->actions_begin_->stop_complex();
   }
   bool empty() const { return this->actions_begin_ == nullptr; }
+  /// Forward max_runs to every action in this list.
+  void reserve_runs(uint16_t max_runs) {
+    for (auto *action = this->actions_begin_; action != nullptr; action = action->next_)
+      action->reserve_runs(max_runs);
+  }
 
   /// Check if any action in this action list is currently running.
   bool is_running() {
@@ -427,6 +560,9 @@ template<typename... Ts> class Automation {
 
   void stop() { this->actions_.stop(); }
 
+  /// Reserve per-run state in every pooled action for up to `max_runs` concurrent runs.
+  void set_max_runs(uint16_t max_runs) { this->actions_.reserve_runs(max_runs); }
+
   void trigger(const Ts &...x) { this->actions_.play(x...); }
 
   bool is_running() { return this->actions_.is_running(); }
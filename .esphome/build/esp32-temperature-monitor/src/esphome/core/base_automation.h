@@ -9,7 +9,6 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 
-#include <list>
 #include <vector>
 
 namespace esphome {
@@ -196,13 +195,17 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
           [this]() { this->play_next_(); },
           /* is_retry= */ false, /* skip_cancel= */ this->num_running_ > 1);
     } else {
-      // For delays with arguments, use std::bind to preserve argument values
-      // Arguments must be copied because original references may be invalid after delay
-      auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
-      App.scheduler.set_timer_common_(this, Scheduler::SchedulerItem::TIMEOUT, Scheduler::NameType::NUMERIC_ID_INTERNAL,
-                                      nullptr, static_cast<uint32_t>(InternalSchedulerID::DELAY_ACTION),
-                                      this->delay_.value(x...), std::move(f),
-                                      /* is_retry= */ false, /* skip_cancel= */ this->num_running_ > 1);
+      // For delays with arguments, park a copy of them in a pooled run slot. Arguments must be
+      // copied because original references may be invalid after delay. The callback only
+      // captures this + slot index, which fits std::function's inline buffer, so no heap
+      // allocation is made per run once the pool is sized.
+      uint16_t slot = this->runs_.acquire();
+      this->runs_[slot] = std::tuple<Ts...>(x...);
+      App.scheduler.set_timer_common_(
+          this, Scheduler::SchedulerItem::TIMEOUT, Scheduler::NameType::NUMERIC_ID_INTERNAL, nullptr,
+          static_cast<uint32_t>(InternalSchedulerID::DELAY_ACTION), this->delay_.value(x...),
+          [this, slot]() { this->resume_(slot); },
+          /* is_retry= */ false, /* skip_cancel= */ this->num_running_ > 1);
     }
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
@@ -210,7 +213,28 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   void play(const Ts &...x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(InternalSchedulerID::DELAY_ACTION); }
+  void stop() override {
+    this->cancel_timeout(InternalSchedulerID::DELAY_ACTION);
+    if constexpr (sizeof...(Ts) != 0) {
+      this->runs_.clear();
+    }
+  }
+
+  void reserve_runs(uint16_t max_runs) override {
+    if constexpr (sizeof...(Ts) != 0) {
+      this->runs_.init(max_runs);
+    }
+  }
+
+ protected:
+  void resume_(uint16_t slot) {
+    // Move the arguments out and free the slot first so a re-entrant run can reuse it
+    std::tuple<Ts...> args = std::move(this->runs_[slot]);
+    this->runs_.release(slot);
+    this->play_next_tuple_(args);
+  }
+
+  RunStatePool<std::tuple<Ts...>> runs_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -304,6 +328,11 @@ template<typename... Ts> class IfAction : public Action<Ts...> {
     this->else_.stop();
   }
 
+  void reserve_runs(uint16_t max_runs) override {
+    this->then_.reserve_runs(max_runs);
+    this->else_.reserve_runs(max_runs);
+  }
+
  protected:
   Condition<Ts...> *condition_;
   ActionList<Ts...> then_;
@@ -341,6 +370,8 @@ template<typename... Ts> class WhileAction : public Action<Ts...> {
 
   void stop() override { this->then_.stop(); }
 
+  void reserve_runs(uint16_t max_runs) override { this->then_.reserve_runs(max_runs); }
+
  protected:
   Condition<Ts...> *condition_;
   ActionList<Ts...> then_;
@@ -397,6 +428,8 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
 
   void stop() override { this->then_.stop(); }
 
+  void reserve_runs(uint16_t max_runs) override { this->then_.reserve_runs(max_runs); }
+
  protected:
   ActionList<uint32_t, Ts...> then_;
 };
@@ -413,10 +446,10 @@ template<typename... Ts> void RepeatLoopContinuation<Ts...>::play(const uint32_t
 
 /** Wait until a condition is true to continue execution.
  *
- * Uses queue-based storage to safely handle concurrent executions.
+ * Uses pooled per-run slots to safely handle concurrent executions.
  * While concurrent execution from the same trigger is uncommon, it's possible
- * (e.g., rapid button presses, high-frequency sensor updates), so we use
- * queue-based storage for correctness.
+ * (e.g., rapid button presses, high-frequency sensor updates), so each waiting
+ * run keeps its own start time, timeout and arguments in a RunStatePool slot.
  */
 template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Component {
  public:
@@ -446,8 +479,11 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
     // Store for later processing
     auto now = millis();
-    auto timeout = this->timeout_value_.optional_value(x...);
-    this->var_queue_.emplace_back(now, timeout, std::make_tuple(x...));
+    uint16_t slot = this->runs_.acquire();
+    auto &run = this->runs_[slot];
+    run.start = now;
+    run.timeout = this->timeout_value_.optional_value(x...);
+    run.args = std::tuple<Ts...>(x...);
 
     // Do immediate check with fresh timestamp - don't call loop() synchronously!
     // Let the event loop call it to avoid reentrancy issues
@@ -466,43 +502,52 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
   }
 
   void stop() override {
-    this->var_queue_.clear();
+    this->runs_.clear();
     this->disable_loop();
   }
 
+  void reserve_runs(uint16_t max_runs) override { this->runs_.init(max_runs); }
+
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void play(const Ts &...x) override { /* ignore - see play_complex */
   }
 
  protected:
-  // Helper: Process queue, triggering completed items and removing them
-  // Returns true if queue still has pending items
+  struct PendingRun {
+    uint32_t start;
+    optional<uint32_t> timeout;
+    std::tuple<Ts...> args;
+  };
+
+  // Helper: Process pending runs, triggering completed ones and releasing their slots
+  // Returns true if any run is still waiting
   bool process_queue_(uint32_t now) {
-    // Process each queued wait_until and remove completed ones
-    this->var_queue_.remove_if([&](auto &queued) {
-      auto start = std::get<uint32_t>(queued);
-      auto timeout = std::get<optional<uint32_t>>(queued);
-      auto &var = std::get<std::tuple<Ts...>>(queued);
+    // Re-read capacity each pass: a re-entrant play_complex() may grow the pool
+    for (uint16_t i = 0; i < this->runs_.capacity() && !this->runs_.empty(); i++) {
+      if (!this->runs_.is_used(i))
+        continue;
+      auto &run = this->runs_[i];
 
       // Check if timeout has expired
-      auto expired = timeout && (now - start) >= *timeout;
+      auto expired = run.timeout && (now - run.start) >= *run.timeout;
 
       // Keep waiting if not expired and condition not met
-      if (!expired && !this->condition_->check_tuple(var)) {
-        return false;
+      if (!expired && !this->condition_->check_tuple(run.args)) {
+        continue;
       }
 
-      // Condition met or timed out - trigger next action
-      this->play_next_tuple_(var);
-      return true;
-    });
+      // Condition met or timed out - free the slot before continuing so the chain can reuse it
+      std::tuple<Ts...> args = std::move(run.args);
+      this->runs_.release(i);
+      this->play_next_tuple_(args);
+    }
 
-    return !this->var_queue_.empty();
+    return !this->runs_.empty();
   }
 
   Condition<Ts...> *condition_;
-  std::list<std::tuple<uint32_t, optional<uint32_t>, std::tuple<Ts...>>> var_queue_{};
+  RunStatePool<PendingRun> runs_;
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "defines.h"
+#include "esphome/core/defines.h"
 #include "component.h"
 #include "helpers.h"
 
@@ -46,6 +46,11 @@ struct ComponentPriorityOverride {
   float priority;
 };
 
+struct ComponentSetupDependency {
+  const Component *component;
+  Component *dependency;
+};
+
 // Error messages for failed components
 // Using raw pointer instead of unique_ptr to avoid global constructor/destructor overhead
 // This is never freed as error messages persist for the lifetime of the device
@@ -55,6 +60,9 @@ std::vector<ComponentErrorMessage> *component_error_messages = nullptr;
 // Using raw pointer instead of unique_ptr to avoid global constructor/destructor overhead
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 std::vector<ComponentPriorityOverride> *setup_priority_overrides = nullptr;
+// Setup dependencies - freed after setup completes
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::vector<ComponentSetupDependency> *setup_dependencies = nullptr;
 
 // Helper to store error messages - reduces duplication between deprecated and new API
 // Remove before 2026.6.0 when deprecated const char* API is removed
@@ -106,6 +114,8 @@ const uint8_t STATUS_LED_MASK = 0x18;
 const uint8_t STATUS_LED_OK = 0x00;
 const uint8_t STATUS_LED_WARNING = 0x08;  // Bit 3
 const uint8_t STATUS_LED_ERROR = 0x10;    // Bit 4
+// Async setup uses bit 5
+const uint8_t COMPONENT_SETUP_PENDING = 0x20;
 
 const uint16_t WARN_IF_BLOCKING_OVER_MS = 50U;       ///< Initial blocking time allowed without warning
 const uint16_t WARN_IF_BLOCKING_INCREMENT_MS = 10U;  ///< How long the blocking time must be larger to warn again
@@ -319,6 +329,8 @@ void Component::mark_failed() {
   ESP_LOGE(TAG, "%s was marked as failed", LOG_STR_ARG(this->get_component_log_str()));
   this->set_component_state_(COMPONENT_STATE_FAILED);
   this->status_set_error();
+  // A failed async setup is over too
+  this->finish_async_setup_();
   // Also remove from loop since failed components shouldn't loop
   App.disable_component_loop_(this);
 }
@@ -410,6 +422,21 @@ bool Component::is_ready() const {
 }
 bool Component::is_idle() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE; }
 bool Component::can_proceed() { return true; }
+bool Component::is_setup_finished() {
+  uint8_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  if (state == COMPONENT_STATE_CONSTRUCTION)
+    return false;
+  if (state == COMPONENT_STATE_FAILED)
+    return true;
+  return (this->component_state_ & COMPONENT_SETUP_PENDING) == 0 && this->can_proceed();
+}
+void Component::begin_async_setup_() { this->component_state_ |= COMPONENT_SETUP_PENDING; }
+void Component::finish_async_setup_() {
+  if ((this->component_state_ & COMPONENT_SETUP_PENDING) == 0)
+    return;
+  this->component_state_ &= ~COMPONENT_SETUP_PENDING;
+  App.record_setup_finished_(this);
+}
 bool Component::status_has_warning() const { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() const { return this->component_state_ & STATUS_LED_ERROR; }
 
@@ -520,6 +547,37 @@ void Component::set_setup_priority(float priority) {
   setup_priority_overrides->emplace_back(ComponentPriorityOverride{this, priority});
 }
 
+void Component::add_setup_dependency(Component *dependency) {
+  if (dependency == nullptr || dependency == this)
+    return;
+  if (!setup_dependencies) {
+    setup_dependencies = new std::vector<ComponentSetupDependency>();
+  }
+  for (const auto &entry : *setup_dependencies) {
+    if (entry.component == this && entry.dependency == dependency)
+      return;
+  }
+  setup_dependencies->emplace_back(ComponentSetupDependency{this, dependency});
+}
+bool Component::has_setup_dependencies() const {
+  if (setup_dependencies) {
+    for (const auto &entry : *setup_dependencies) {
+      if (entry.component == this)
+        return true;
+    }
+  }
+  return false;
+}
+bool Component::are_setup_dependencies_finished() const {
+  if (setup_dependencies) {
+    for (const auto &entry : *setup_dependencies) {
+      if (entry.component == this && !entry.dependency->is_setup_finished())
+        return false;
+    }
+  }
+  return true;
+}
+
 bool Component::has_overridden_loop() const {
 #if defined(USE_HOST) || defined(CLANG_TIDY)
   bool loop_overridden = true;
@@ -593,4 +651,9 @@ void clear_setup_priority_overrides() {
   setup_priority_overrides = nullptr;
 }
 
+void clear_setup_dependencies() {
+  delete setup_dependencies;
+  setup_dependencies = nullptr;
+}
+
 }  // namespace esphome
@@ -53,8 +53,9 @@ static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
 /// Uses a separate NameType (NUMERIC_ID_INTERNAL) so IDs can never collide
 /// with component-level NUMERIC_ID values, even if the uint32_t values overlap.
 enum class InternalSchedulerID : uint32_t {
-  POLLING_UPDATE = 0,  // PollingComponent interval
-  DELAY_ACTION = 1,    // DelayAction timeout
+  POLLING_UPDATE = 0,              // PollingComponent interval
+  DELAY_ACTION = 1,                // DelayAction timeout
+  BINARY_SENSOR_FILTER_TIMER = 2,  // Shared binary_sensor::FilterTimer timeout
 };
 
 // Forward declaration
@@ -75,6 +76,7 @@ extern const uint8_t STATUS_LED_MASK;
 extern const uint8_t STATUS_LED_OK;
 extern const uint8_t STATUS_LED_WARNING;
 extern const uint8_t STATUS_LED_ERROR;
+extern const uint8_t COMPONENT_SETUP_PENDING;
 
 // Remove before 2026.8.0
 enum class RetryResult { DONE, RETRY };
@@ -111,6 +113,20 @@ class Component {
 
   void set_setup_priority(float priority);
 
+  /** Declare that setup() of this component must not run before @p dependency has finished setting up.
+   *
+   * A component that declares dependencies is set up as soon as all of them have finished (see
+   * is_setup_finished()), instead of after every component with a higher setup priority. No other
+   * component waits for it implicitly. Must be called before App.setup(); the table is freed afterwards.
+   */
+  void add_setup_dependency(Component *dependency);
+
+  /// Whether add_setup_dependency() was called on this component. Only valid until App.setup() returns.
+  bool has_setup_dependencies() const;
+
+  /// Whether every dependency declared with add_setup_dependency() has finished setting up.
+  bool are_setup_dependencies_finished() const;
+
   /** priority of loop(). higher -> executed earlier
    *
    * Defaults to 0.
@@ -231,6 +247,13 @@ class Component {
 
   virtual bool can_proceed();
 
+  /** Check if this component has finished setting up.
+   *
+   * True once setup() has returned, an async setup started with begin_async_setup_() has completed,
+   * and can_proceed() returns true. A failed component counts as finished.
+   */
+  bool is_setup_finished();
+
   bool status_has_warning() const;
 
   bool status_has_error() const;
@@ -293,6 +316,16 @@ class Component {
   /// Helper to set component state (clears state bits and sets new state)
   void set_component_state_(uint8_t state);
 
+  /** Continue setting up asynchronously after setup() returns.
+   *
+   * Call from setup() before handing the remaining work (waiting on a peripheral, polling a status
+   * register, ...) to set_timeout() or loop(), then call finish_async_setup_() or mark_failed() when it
+   * is done. Components that declared a dependency on this one wait for it; the rest of the setup
+   * carries on in the meantime.
+   */
+  void begin_async_setup_();
+  void finish_async_setup_();
+
   /** Set an interval function with a unique name. Empty name means no cancelling possible.
    *
    * This will call f every interval ms. Can be cancelled via CancelInterval().
@@ -498,7 +531,8 @@ class Component {
   /// Bits 0-2: Component state (0x00=CONSTRUCTION, 0x01=SETUP, 0x02=LOOP, 0x03=FAILED, 0x04=LOOP_DONE)
   /// Bit 3: STATUS_LED_WARNING
   /// Bit 4: STATUS_LED_ERROR
-  /// Bits 5-7: Unused - reserved for future expansion
+  /// Bit 5: Async setup pending (begin_async_setup_() called, finish_async_setup_() not yet)
+  /// Bits 6-7: Unused - reserved for future expansion
   uint8_t component_state_{0x00};
   volatile bool pending_enable_loop_{false};  ///< ISR-safe flag for enable_loop_soon_any_context
 };
@@ -565,4 +599,7 @@ class WarnIfComponentBlockingGuard {
 // Function to clear setup priority overrides after all components are set up
 void clear_setup_priority_overrides();
 
+// Function to clear setup dependencies after all components are set up
+void clear_setup_dependencies();
+
 }  // namespace esphome
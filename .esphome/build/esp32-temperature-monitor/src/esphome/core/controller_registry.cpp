@@ -3,11 +3,25 @@
 #ifdef USE_CONTROLLER_REGISTRY
 
 #include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
 
 namespace esphome {
 
 StaticVector<Controller *, CONTROLLER_REGISTRY_MAX> ControllerRegistry::controllers;
 
+#ifdef USE_SENSOR
+StaticVector<sensor::Sensor *, ESPHOME_ENTITY_SENSOR_COUNT> ControllerRegistry::pending_sensors;
+#endif
+#ifdef USE_TEXT_SENSOR
+StaticVector<text_sensor::TextSensor *, ESPHOME_ENTITY_TEXT_SENSOR_COUNT> ControllerRegistry::pending_text_sensors;
+#endif
+
 void ControllerRegistry::register_controller(Controller *controller) { controllers.push_back(controller); }
 
 // Macro for standard registry notification dispatch - calls on_<entity_name>_update()
@@ -18,6 +32,22 @@ void ControllerRegistry::register_controller(Controller *controller) { controlle
     } \
   }
 
+// Macro for coalesced notification - queues the entity once until the next flush()
+// The pending list holds every registered entity; an unregistered one overflowing it is dispatched directly
+#define CONTROLLER_REGISTRY_NOTIFY_COALESCED(entity_type, entity_name, capacity) \
+  void ControllerRegistry::notify_##entity_name##_update(entity_type *obj) { /* NOLINT(bugprone-macro-parentheses) */ \
+    if (controllers.empty() || !obj->mark_controller_pending()) \
+      return; \
+    if (pending_##entity_name##s.size() < (capacity)) { \
+      pending_##entity_name##s.push_back(obj); \
+      return; \
+    } \
+    obj->clear_controller_pending(); \
+    for (auto *controller : controllers) { \
+      controller->on_##entity_name##_update(obj); \
+    } \
+  }
+
 // Macro for entities where controller method has no "_update" suffix (Event, Update)
 #define CONTROLLER_REGISTRY_NOTIFY_NO_UPDATE_SUFFIX(entity_type, entity_name) \
   void ControllerRegistry::notify_##entity_name(entity_type *obj) { /* NOLINT(bugprone-macro-parentheses) */ \
@@ -39,7 +69,7 @@ CONTROLLER_REGISTRY_NOTIFY(light::LightState, light)
 #endif
 
 #ifdef USE_SENSOR
-CONTROLLER_REGISTRY_NOTIFY(sensor::Sensor, sensor)
+CONTROLLER_REGISTRY_NOTIFY_COALESCED(sensor::Sensor, sensor, ESPHOME_ENTITY_SENSOR_COUNT)
 #endif
 
 #ifdef USE_SWITCH
@@ -51,7 +81,7 @@ CONTROLLER_REGISTRY_NOTIFY(cover::Cover, cover)
 #endif
 
 #ifdef USE_TEXT_SENSOR
-CONTROLLER_REGISTRY_NOTIFY(text_sensor::TextSensor, text_sensor)
+CONTROLLER_REGISTRY_NOTIFY_COALESCED(text_sensor::TextSensor, text_sensor, ESPHOME_ENTITY_TEXT_SENSOR_COUNT)
 #endif
 
 #ifdef USE_CLIMATE
@@ -110,8 +140,32 @@ CONTROLLER_REGISTRY_NOTIFY_NO_UPDATE_SUFFIX(event::Event, event)
 CONTROLLER_REGISTRY_NOTIFY_NO_UPDATE_SUFFIX(update::UpdateEntity, update)
 #endif
 
+// Controllers read the state at dispatch time, so each pending entity is delivered once with its latest value.
+// A controller may publish another entity, or re-publish one already delivered, from its callback: the flag is
+// cleared before dispatch and the list is drained by index, so both are appended and delivered in this same flush.
+#define CONTROLLER_REGISTRY_FLUSH(entity_name) \
+  for (size_t i = 0; i < pending_##entity_name##s.size(); i++) { \
+    auto *obj = pending_##entity_name##s[i]; \
+    obj->clear_controller_pending(); \
+    for (auto *controller : controllers) { \
+      controller->on_##entity_name##_update(obj); \
+    } \
+  } \
+  pending_##entity_name##s.clear();
+
+void ControllerRegistry::flush() {
+#ifdef USE_SENSOR
+  CONTROLLER_REGISTRY_FLUSH(sensor)
+#endif
+#ifdef USE_TEXT_SENSOR
+  CONTROLLER_REGISTRY_FLUSH(text_sensor)
+#endif
+}
+
 #undef CONTROLLER_REGISTRY_NOTIFY
+#undef CONTROLLER_REGISTRY_NOTIFY_COALESCED
 #undef CONTROLLER_REGISTRY_NOTIFY_NO_UPDATE_SUFFIX
+#undef CONTROLLER_REGISTRY_FLUSH
 
 }  // namespace esphome
 
@@ -152,6 +152,11 @@ class UpdateEntity;
  * Memory savings: 32 bytes per entity (2 controllers × 16 bytes std::function overhead)
  * Typical config (25 entities): ~780 bytes saved
  * Large config (80 entities): ~2,540 bytes saved
+ *
+ * Sensor and text sensor updates are coalesced: notify_*_update() only marks the entity pending
+ * (one bit in its EntityBase flags) and queues it once, and flush() delivers the latest state of
+ * each pending entity at the end of the main-loop iteration. Entities whose individual transitions
+ * matter (binary sensors, switches, events) are still dispatched synchronously.
  */
 class ControllerRegistry {
  public:
@@ -175,6 +180,7 @@ class ControllerRegistry {
 #endif
 
 #ifdef USE_SENSOR
+  /// Coalesced: controllers see the latest state once per loop iteration
   static void notify_sensor_update(sensor::Sensor *obj);
 #endif
 
@@ -187,6 +193,7 @@ class ControllerRegistry {
 #endif
 
 #ifdef USE_TEXT_SENSOR
+  /// Coalesced: controllers see the latest state once per loop iteration
   static void notify_text_sensor_update(text_sensor::TextSensor *obj);
 #endif
 
@@ -246,8 +253,17 @@ class ControllerRegistry {
   static void notify_update(update::UpdateEntity *obj);
 #endif
 
+  /// Deliver coalesced notifications. Called by Application once per main-loop iteration.
+  static void flush();
+
  protected:
   static StaticVector<Controller *, CONTROLLER_REGISTRY_MAX> controllers;
+#ifdef USE_SENSOR
+  static StaticVector<sensor::Sensor *, ESPHOME_ENTITY_SENSOR_COUNT> pending_sensors;
+#endif
+#ifdef USE_TEXT_SENSOR
+  static StaticVector<text_sensor::TextSensor *, ESPHOME_ENTITY_TEXT_SENSOR_COUNT> pending_text_sensors;
+#endif
 };
 
 }  // namespace esphome
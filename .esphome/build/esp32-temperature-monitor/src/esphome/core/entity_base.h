@@ -123,6 +123,17 @@ class EntityBase {
   // Set has_state - for components that need to manually set this
   void set_has_state(bool state) { this->flags_.has_state = state; }
 
+  /// Mark a coalesced controller notification as pending; returns false if one already was
+  bool mark_controller_pending() {
+    if (this->flags_.controller_pending)
+      return false;
+    this->flags_.controller_pending = true;
+    return true;
+  }
+  void clear_controller_pending() { this->flags_.controller_pending = false; }
+  /// True from a coalesced publish until the flush that delivers it to the controllers
+  bool is_controller_pending() const { return this->flags_.controller_pending; }
+
   /**
    * @brief Get a unique hash for storing preferences/settings for this entity.
    *
@@ -187,8 +198,9 @@ class EntityBase {
     uint8_t internal : 1;
     uint8_t disabled_by_default : 1;
     uint8_t has_state : 1;
-    uint8_t entity_category : 2;  // Supports up to 4 categories
-    uint8_t reserved : 2;         // Reserved for future use
+    uint8_t entity_category : 2;     // Supports up to 4 categories
+    uint8_t controller_pending : 1;  // Queued in ControllerRegistry for the end-of-loop flush
+    uint8_t reserved : 1;            // Reserved for future use
   } flags_{};
 };
 
@@ -3,10 +3,17 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <initializer_list>
 #include "esphome/core/helpers.h"
 
 namespace esphome {
 
+/// One input span of a scatter-gather hash update.
+struct HashSegment {
+  const uint8_t *data;
+  size_t len;
+};
+
 /// Base class for hash algorithms
 class HashBase {
  public:
@@ -19,6 +26,16 @@ class HashBase {
   virtual void add(const uint8_t *data, size_t len) = 0;
   void add(const char *data, size_t len) { this->add((const uint8_t *) data, len); }
 
+  /// Add several non-contiguous spans in order, as if they were one buffer. Each span is passed straight to the
+  /// platform update (hardware SHA / mbedTLS / BearSSL / OpenSSL) without being copied into a staging buffer.
+  void add(const HashSegment *segments, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      if (segments[i].len != 0)
+        this->add(segments[i].data, segments[i].len);
+    }
+  }
+  void add(std::initializer_list<HashSegment> segments) { this->add(segments.begin(), segments.size()); }
+
   /// Compute the hash based on provided data
   virtual void calculate() = 0;
 
@@ -474,6 +474,77 @@ static inline void normalize_accuracy_decimals(float &value, int8_t &accuracy_de
   }
 }
 
+static const uint16_t FORMAT_FLOAT_POW10[FORMAT_FLOAT_FIXED_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000};
+
+size_t format_float_fixed_to(char *buffer, size_t buffer_size, float value, uint8_t decimals) {
+  if (buffer_size == 0)
+    return 0;
+
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const bool negative = (bits >> 31) != 0;
+  int exponent = (bits >> 23) & 0xFF;
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  // value == mantissa * 2^-shift, and value * 10^decimals == scaled * 2^-shift exactly
+  uint64_t scaled = 0;
+  int shift = 0;
+  bool fast = exponent != 0xFF && decimals <= FORMAT_FLOAT_FIXED_MAX_DECIMALS;
+  if (fast) {
+    if (exponent == 0) {
+      exponent = 1;  // subnormal
+    } else {
+      mantissa |= 0x800000;
+    }
+    shift = 150 - exponent;
+    scaled = uint64_t(mantissa) * FORMAT_FLOAT_POW10[decimals];  // < 2^38
+    // Left shifts must keep the result below 2^63
+    fast = shift >= -25;
+  }
+  if (!fast) {
+    // snprintf returns chars that would be written (excluding null), or negative on error
+    int len = snprintf(buffer, buffer_size, "%.*f", decimals, value);
+    if (len < 0)
+      return 0;  // encoding error
+    return static_cast<size_t>(len) >= buffer_size ? buffer_size - 1 : static_cast<size_t>(len);
+  }
+
+  // Round to an integer the same way printf does: to nearest, ties to even
+  uint64_t rounded;
+  if (shift <= 0) {
+    rounded = scaled << -shift;
+  } else if (shift >= 64) {
+    rounded = 0;  // scaled < 2^38 is always below one half
+  } else {
+    rounded = scaled >> shift;
+    const uint64_t remainder = scaled & ((uint64_t(1) << shift) - 1);
+    const uint64_t half = uint64_t(1) << (shift - 1);
+    if (remainder > half || (remainder == half && (rounded & 1)))
+      rounded++;
+  }
+
+  // Render backwards: fraction digits, dot, integer digits, sign. Max "-" + 20 digits + "." + 4 digits.
+  char tmp[27];
+  char *p = tmp + sizeof(tmp);
+  for (uint8_t i = 0; i < decimals; i++) {
+    *--p = char('0' + rounded % 10);
+    rounded /= 10;
+  }
+  if (decimals > 0)
+    *--p = '.';
+  do {
+    *--p = char('0' + rounded % 10);
+    rounded /= 10;
+  } while (rounded != 0);
+  if (negative)
+    *--p = '-';
+
+  size_t len = std::min<size_t>(tmp + sizeof(tmp) - p, buffer_size - 1);
+  memcpy(buffer, p, len);
+  buffer[len] = '\0';
+  return len;
+}
+
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
   char buf[VALUE_ACCURACY_MAX_LEN];
   value_accuracy_to_buf(buf, value, accuracy_decimals);
@@ -482,12 +553,7 @@ std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
 
 size_t value_accuracy_to_buf(std::span<char, VALUE_ACCURACY_MAX_LEN> buf, float value, int8_t accuracy_decimals) {
   normalize_accuracy_decimals(value, accuracy_decimals);
-  // snprintf returns chars that would be written (excluding null), or negative on error
-  int len = snprintf(buf.data(), buf.size(), "%.*f", accuracy_decimals, value);
-  if (len < 0)
-    return 0;  // encoding error
-  // On truncation, snprintf returns would-be length; actual written is buf.size() - 1
-  return static_cast<size_t>(len) >= buf.size() ? buf.size() - 1 : static_cast<size_t>(len);
+  return format_float_fixed_to(buf.data(), buf.size(), value, accuracy_decimals);
 }
 
 size_t value_accuracy_with_uom_to_buf(std::span<char, VALUE_ACCURACY_MAX_LEN> buf, float value,
@@ -496,12 +562,16 @@ size_t value_accuracy_with_uom_to_buf(std::span<char, VALUE_ACCURACY_MAX_LEN> bu
     return value_accuracy_to_buf(buf, value, accuracy_decimals);
   }
   normalize_accuracy_decimals(value, accuracy_decimals);
-  // snprintf returns chars that would be written (excluding null), or negative on error
-  int len = snprintf(buf.data(), buf.size(), "%.*f %s", accuracy_decimals, value, unit_of_measurement.c_str());
-  if (len < 0)
-    return 0;  // encoding error
-  // On truncation, snprintf returns would-be length; actual written is buf.size() - 1
-  return static_cast<size_t>(len) >= buf.size() ? buf.size() - 1 : static_cast<size_t>(len);
+  size_t len = format_float_fixed_to(buf.data(), buf.size(), value, accuracy_decimals);
+  // Append " <uom>", truncating like snprintf would
+  size_t uom_len = std::min(unit_of_measurement.size() + 1, buf.size() - 1 - len);
+  if (uom_len > 0) {
+    buf[len] = ' ';
+    memcpy(buf.data() + len + 1, unit_of_measurement.c_str(), uom_len - 1);
+    len += uom_len;
+  }
+  buf[len] = '\0';
+  return len;
 }
 
 int8_t step_to_accuracy_decimals(float step) {
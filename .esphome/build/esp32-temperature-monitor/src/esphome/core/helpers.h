@@ -1304,6 +1304,17 @@ std::string value_accuracy_to_string(float value, int8_t accuracy_decimals);
 /// Maximum buffer size for value_accuracy formatting (float ~15 chars + space + UOM ~40 chars + null)
 static constexpr size_t VALUE_ACCURACY_MAX_LEN = 64;
 
+/// Highest number of decimals handled by the integer fast path of format_float_fixed_to().
+static constexpr uint8_t FORMAT_FLOAT_FIXED_MAX_DECIMALS = 4;
+
+/// Format a float with a fixed number of decimals to buffer, returns chars written (excluding null).
+///
+/// Produces exactly the same output as `snprintf(buf, size, "%.*f", decimals, value)`, including round-half-even
+/// on exact ties and the sign of values that round to zero. Finite values up to ~5e14 with at most
+/// FORMAT_FLOAT_FIXED_MAX_DECIMALS decimals are formatted with integer arithmetic only; anything else (NaN, inf,
+/// huge values, more decimals) falls back to snprintf. Truncates output if it exceeds buffer capacity.
+size_t format_float_fixed_to(char *buffer, size_t buffer_size, float value, uint8_t decimals);
+
 /// Format value with accuracy to buffer, returns chars written (excluding null)
 size_t value_accuracy_to_buf(std::span<char, VALUE_ACCURACY_MAX_LEN> buf, float value, int8_t accuracy_decimals);
 /// Format value with accuracy and UOM to buffer, returns chars written (excluding null)
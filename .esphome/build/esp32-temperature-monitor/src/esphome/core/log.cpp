@@ -8,6 +8,8 @@
 
 namespace esphome {
 
+uint8_t esp_log_active_level = ESPHOME_LOG_LEVEL_VERY_VERBOSE;  // NOLINT
+
 void HOT esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
   va_list arg;
   va_start(arg, format);
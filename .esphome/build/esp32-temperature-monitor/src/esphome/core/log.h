@@ -67,15 +67,25 @@ void esp_log_vprintf_(int level, const char *tag, int line, const __FlashStringH
 int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
+/// Most verbose level any tag may currently log at; kept up to date by the logger component.
+/// The log macros test it inline, so a suppressed call costs one load and compare and never reaches the logger.
+extern uint8_t esp_log_active_level;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+#define ESPHOME_LOG_ACTIVE(level) ((level) <= ::esphome::esp_log_active_level)
+
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 #define ESPHOME_LOG_FORMAT(format) F(format)
 #else
 #define ESPHOME_LOG_FORMAT(format) format
 #endif
 
+#define esph_log_at_(level, tag, format, ...) \
+  (ESPHOME_LOG_ACTIVE(level) \
+       ? ::esphome::esp_log_printf_(level, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__) \
+       : (void) 0)
+
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
-#define esph_log_vv(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_vv(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_VERY_VERBOSE
 #else
@@ -83,8 +93,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
-#define esph_log_v(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_v(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_VERBOSE, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_VERBOSE
 #else
@@ -92,10 +101,8 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
-#define esph_log_d(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
-#define esph_log_config(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_d(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
+#define esph_log_config(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_CONFIG, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_DEBUG
 #define ESPHOME_LOG_HAS_CONFIG
@@ -105,8 +112,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
-#define esph_log_i(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_i(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_INFO
 #else
@@ -114,8 +120,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
-#define esph_log_w(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_w(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_WARN
 #else
@@ -123,8 +128,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
-#define esph_log_e(tag, format, ...) \
-  ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_e(tag, format, ...) esph_log_at_(ESPHOME_LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_ERROR
 #else
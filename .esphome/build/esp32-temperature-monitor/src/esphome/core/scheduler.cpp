@@ -6,6 +6,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/progmem.h"
+#include "esphome/core/trace.h"
 #include <algorithm>
 #include <cinttypes>
 #include <cstring>
@@ -624,9 +625,17 @@ std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_locked_() {
 
 // Helper to execute a scheduler item
 uint32_t HOT Scheduler::execute_item_(SchedulerItem *item, uint32_t now) {
+  Component *previous = App.get_current_component();
   App.set_current_component(item->component);
   WarnIfComponentBlockingGuard guard{item->component, now};
+#ifdef USE_TRACE_RECORDER
+  const uint32_t trace_start = ESPHOME_TRACE_NOW();
+#endif
   item->callback();
+  App.set_current_component(previous);
+  ESPHOME_TRACE(SCHEDULER_CALL, item->component,
+                item->component != nullptr ? LOG_STR_ARG(item->component->get_component_log_str()) : "",
+                trace_start, 0, ESPHOME_TRACE_NOW() - trace_start);
   return guard.finish();
 }
 
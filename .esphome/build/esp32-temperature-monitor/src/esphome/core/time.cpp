@@ -231,4 +231,151 @@ template<typename T> bool increment_time_value(T &current, uint16_t begin, uint1
   return false;
 }
 
+// Output width of a strftime conversion for `time`, or -1 if it's locale dependent or variable.
+static int strftime_field_width(char conversion, const ESPTime &time) {
+  switch (conversion) {
+    case 'Y':
+      return (time.year >= 1000 && time.year <= 9999) ? 4 : -1;
+    case 'y':
+    case 'm':
+    case 'd':
+    case 'e':
+    case 'H':
+    case 'I':
+    case 'M':
+    case 'S':
+      return 2;
+    case 'j':
+      return 3;
+    case '%':
+    case 'n':
+    case 't':
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+// Whether any conversion in `format` renders the seconds, directly or as part of a composite like %T or %c.
+static bool strftime_uses_seconds(const char *format) {
+  for (const char *f = format; *f != '\0'; f++) {
+    if (*f != '%')
+      continue;
+    f++;
+    if (*f == 'E' || *f == 'O')
+      f++;
+    switch (*f) {
+      case '\0':
+        return false;
+      case 'S':
+      case 's':
+      case 'T':
+      case 'X':
+      case 'c':
+      case 'r':
+      case '+':
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+ESPTimeFormatter::ESPTimeFormatter(const char *format)
+    : format_(format), renders_seconds_(strftime_uses_seconds(format)) {}
+
+bool ESPTimeFormatter::update(const ESPTime &time) {
+  if (this->has_time_ && time.timestamp == this->time_.timestamp && time.second == this->time_.second) {
+    this->changed_begin_ = this->changed_end_ = this->len_;
+    return false;
+  }
+
+  const bool same_minute = this->has_time_ && time.minute == this->time_.minute && time.hour == this->time_.hour &&
+                           time.day_of_month == this->time_.day_of_month && time.month == this->time_.month &&
+                           time.year == this->time_.year && time.is_dst == this->time_.is_dst;
+  if (same_minute && !this->renders_seconds_) {
+    // Nothing the format renders changes within a minute (%H:%M, %Y-%m-%d, ...)
+    this->time_ = time;
+    this->changed_begin_ = this->changed_end_ = this->len_;
+    return false;
+  }
+  if (same_minute && this->second_pos_ >= 0) {
+    // Fast path: only the %S digits can differ
+    char *digits = this->buffer_ + this->second_pos_;
+    const char tens = char('0' + time.second / 10);
+    const char ones = char('0' + time.second % 10);
+    this->changed_begin_ = (digits[0] != tens) ? this->second_pos_ : this->second_pos_ + 1;
+    this->changed_end_ = this->second_pos_ + 2;
+    digits[0] = tens;
+    digits[1] = ones;
+    this->time_ = time;
+    return true;
+  }
+
+  char old_text[ESPTime::STRFTIME_BUFFER_SIZE];
+  const size_t old_len = this->len_;
+  memcpy(old_text, this->buffer_, old_len);
+  this->render_full_(time);
+  this->diff_against_(old_text, old_len);
+  return this->changed_begin_ != this->changed_end_;
+}
+
+bool ESPTimeFormatter::increment_second() {
+  ESPTime next = this->time_;
+  next.increment_second();
+  return this->update(next);
+}
+
+void ESPTimeFormatter::render_full_(const ESPTime &time) {
+  this->time_ = time;
+  this->has_time_ = true;
+  this->len_ = this->time_.strftime_to(this->buffer_, this->format_);
+
+  // Locate the %S digits statically: only possible while every preceding conversion has a fixed width
+  this->second_pos_ = -1;
+  const char *after_seconds = nullptr;
+  int pos = 0;
+  for (const char *f = this->format_; *f != '\0'; f++) {
+    if (*f != '%') {
+      pos++;
+      continue;
+    }
+    const char conversion = *++f;
+    if (conversion == '\0')
+      break;
+    if (conversion == 'S') {
+      this->second_pos_ = pos;
+      after_seconds = f + 1;
+      break;
+    }
+    const int width = strftime_field_width(conversion, this->time_);
+    if (width < 0)
+      break;  // Anything after a variable-width field can't be located
+    pos += width;
+  }
+  // Another conversion rendering the seconds (%S, %T, %s, ...) would be left stale by patching only these digits
+  if (after_seconds != nullptr && strftime_uses_seconds(after_seconds))
+    this->second_pos_ = -1;
+  // Guard against strftime errors or truncation: the located digits must match what was rendered
+  if (this->second_pos_ >= 0 &&
+      (this->second_pos_ + 2 > this->len_ || this->buffer_[this->second_pos_] != '0' + time.second / 10 ||
+       this->buffer_[this->second_pos_ + 1] != '0' + time.second % 10))
+    this->second_pos_ = -1;
+}
+
+void ESPTimeFormatter::diff_against_(const char *old_text, size_t old_len) {
+  const size_t common = std::min<size_t>(old_len, this->len_);
+  size_t begin = 0;
+  while (begin < common && old_text[begin] == this->buffer_[begin])
+    begin++;
+  size_t end = this->len_;
+  if (old_len == this->len_) {
+    while (end > begin && old_text[end - 1] == this->buffer_[end - 1])
+      end--;
+  }
+  this->changed_begin_ = begin;
+  this->changed_end_ = end;
+}
+
 }  // namespace esphome
@@ -145,4 +145,51 @@ struct ESPTime {
   bool operator>=(const ESPTime &other) const;
   bool operator>(const ESPTime &other) const;
 };
+
+/** Caches the strftime() output for one format and updates it incrementally.
+ *
+ * Meant for clock displays that render the same format every second. When only the second
+ * changed since the last update(), formats without seconds (%H:%M, %Y-%m-%d) are left as they
+ * are and the two %S digits of the others are patched in place; a new minute, hour,
+ * day or DST state (or a format where the %S position can't be determined statically) falls
+ * back to a full strftime(). changed_begin()/changed_end() describe the char range that differs
+ * from the previous text, so displays can redraw just that region.
+ */
+class ESPTimeFormatter {
+ public:
+  /// @param format strftime format; must outlive this formatter (typically a string literal).
+  explicit ESPTimeFormatter(const char *format);
+
+  /// Render `time`. Returns true if the text changed.
+  bool update(const ESPTime &time);
+  /// Advance the cached time by one second and re-render; cheap unless a minute rolls over.
+  bool increment_second();
+
+  const char *c_str() const { return this->buffer_; }
+  size_t size() const { return this->len_; }
+  /// Time the current text was rendered from.
+  const ESPTime &get_time() const { return this->time_; }
+  /// First char index that changed in the last update() (equals changed_end() if nothing changed).
+  size_t changed_begin() const { return this->changed_begin_; }
+  /// One past the last char index that changed in the last update().
+  size_t changed_end() const { return this->changed_end_; }
+
+ protected:
+  void render_full_(const ESPTime &time);
+  /// Set the changed range to the chars that differ between `old_text` and the current buffer.
+  void diff_against_(const char *old_text, size_t old_len);
+
+  const char *format_;
+  ESPTime time_{};
+  char buffer_[ESPTime::STRFTIME_BUFFER_SIZE]{};
+  uint8_t len_{0};
+  uint8_t changed_begin_{0};
+  uint8_t changed_end_{0};
+  /// Offset of the %S digits in the output, -1 if unknown.
+  int8_t second_pos_{-1};
+  /// Whether any conversion renders the seconds; if not, ticks within the same minute leave the text as is.
+  bool renders_seconds_;
+  bool has_time_{false};
+};
+
 }  // namespace esphome
@@ -0,0 +1,222 @@
+#include "esphome/core/trace.h"
+
+#ifdef USE_TRACE_RECORDER
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+
+TraceRecorder global_trace_recorder;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+// Binary file layout (little endian):
+//   char magic[8] = "ESPTRACE", uint16 version, uint16 record_size, uint16 source_count, uint8 cores, uint8 reserved
+//   source_count x { uint16 id, uint8 name_len, char name[name_len] }
+//   cores x { uint32 record_count, TraceRecord records[record_count] }
+static constexpr char TRACE_MAGIC[8] = {'E', 'S', 'P', 'T', 'R', 'A', 'C', 'E'};
+static constexpr uint16_t TRACE_VERSION = 1;
+// Output is assembled in chunks this size before being handed to the writer
+static constexpr size_t TRACE_CHUNK_SIZE = 256;
+
+namespace {
+
+/// Small write-combining buffer in front of a TraceWriter
+class TraceOutput {
+ public:
+  TraceOutput(TraceWriter writer, void *ctx) : writer_(writer), ctx_(ctx) {}
+  ~TraceOutput() { this->flush(); }
+
+  void write(const void *data, size_t len) {
+    const char *src = static_cast<const char *>(data);
+    while (len > 0) {
+      size_t n = std::min(len, TRACE_CHUNK_SIZE - this->pos_);
+      memcpy(this->buf_ + this->pos_, src, n);
+      this->pos_ += n;
+      src += n;
+      len -= n;
+      if (this->pos_ == TRACE_CHUNK_SIZE)
+        this->flush();
+    }
+  }
+  void print(const char *str) { this->write(str, strlen(str)); }
+  void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char line[128];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (len > 0)
+      this->write(line, std::min(static_cast<size_t>(len), sizeof(line) - 1));
+  }
+  /// Print `str` as a JSON string body, dropping characters that would need escaping
+  void print_json_safe(const char *str) {
+    for (; *str != '\0'; str++) {
+      char c = *str;
+      if (c != '"' && c != '\\' && static_cast<uint8_t>(c) >= 0x20)
+        this->write(&c, 1);
+    }
+  }
+  void flush() {
+    if (this->pos_ > 0)
+      this->writer_(this->ctx_, this->buf_, this->pos_);
+    this->pos_ = 0;
+  }
+
+ protected:
+  TraceWriter writer_;
+  void *ctx_;
+  size_t pos_{0};
+  char buf_[TRACE_CHUNK_SIZE];
+};
+
+/// Disables recording for the lifetime of an export so the rings hold still
+class TracePause {
+ public:
+  explicit TracePause(TraceRecorder &recorder) : recorder_(recorder), was_enabled_(recorder.is_enabled()) {
+    recorder.set_enabled(false);
+  }
+  ~TracePause() { this->recorder_.set_enabled(this->was_enabled_); }
+
+ protected:
+  TraceRecorder &recorder_;
+  bool was_enabled_;
+};
+
+const char *const EVENT_NAMES[] = {"loop", "component", "scheduler", "sensor", "i2c", "api_send", "setup"};
+
+}  // namespace
+
+uint16_t TraceRecorder::intern_source_(const void *source, const char *name) {
+  size_t slot = source_hash_(source);
+  for (size_t probe = 0; probe < MAX_SOURCES; probe++) {
+    const void *expected = nullptr;
+    if (this->sources_[slot].compare_exchange_strong(expected, source, std::memory_order_acq_rel)) {
+      this->source_names_[slot] = name;
+      return static_cast<uint16_t>(slot);
+    }
+    // Lost the race to another writer interning the same source
+    if (expected == source)
+      return static_cast<uint16_t>(slot);
+    slot = (slot + 1) & (MAX_SOURCES - 1);
+  }
+  // Table full; record without a source rather than drop the event
+  return TRACE_NO_SOURCE;
+}
+
+void TraceRecorder::ring_window_(const Ring &ring, uint32_t &first, uint32_t &count) {
+  uint32_t head = ring.head.load(std::memory_order_acquire);
+  count = head < RING_SIZE ? head : RING_SIZE;
+  first = head - count;
+}
+
+size_t TraceRecorder::size() const {
+  size_t total = 0;
+  for (const auto &ring : this->rings_) {
+    uint32_t first, count;
+    ring_window_(ring, first, count);
+    total += count;
+  }
+  return total;
+}
+
+void TraceRecorder::export_binary(TraceWriter writer, void *ctx) {
+  TracePause pause(*this);
+  TraceOutput out(writer, ctx);
+
+  uint16_t source_count = 0;
+  for (const auto &source : this->sources_) {
+    if (source.load(std::memory_order_acquire) != nullptr)
+      source_count++;
+  }
+
+  out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  uint16_t header[3] = {TRACE_VERSION, sizeof(TraceRecord), source_count};
+  out.write(header, sizeof(header));
+  uint8_t cores[2] = {NUM_CORES, 0};
+  out.write(cores, sizeof(cores));
+
+  for (size_t i = 0; i < MAX_SOURCES; i++) {
+    if (this->sources_[i].load(std::memory_order_acquire) == nullptr)
+      continue;
+    const char *name = this->source_names_[i] != nullptr ? this->source_names_[i] : "";
+    uint16_t id = i;
+    uint8_t len = std::min<size_t>(strlen(name), UINT8_MAX);
+    out.write(&id, sizeof(id));
+    out.write(&len, sizeof(len));
+    out.write(name, len);
+  }
+
+  for (const auto &ring : this->rings_) {
+    uint32_t first, count;
+    ring_window_(ring, first, count);
+    out.write(&count, sizeof(count));
+    for (uint32_t i = 0; i < count; i++)
+      out.write(&ring.records[(first + i) & (RING_SIZE - 1)], sizeof(TraceRecord));
+  }
+}
+
+void TraceRecorder::export_chrome_json(TraceWriter writer, void *ctx) {
+  TracePause pause(*this);
+  TraceOutput out(writer, ctx);
+
+  out.print("{\"traceEvents\":[");
+  bool first_event = true;
+  for (const auto &ring : this->rings_) {
+    uint32_t first, count;
+    ring_window_(ring, first, count);
+    for (uint32_t i = 0; i < count; i++) {
+      const TraceRecord &rec = ring.records[(first + i) & (RING_SIZE - 1)];
+      if (rec.event >= sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]))
+        continue;
+      auto event = static_cast<TraceEvent>(rec.event);
+      const char *source = rec.source_id < MAX_SOURCES ? this->source_names_[rec.source_id] : nullptr;
+
+      out.print(first_event ? "\n{\"name\":\"" : ",\n{\"name\":\"");
+      first_event = false;
+      out.print_json_safe(source != nullptr ? source : EVENT_NAMES[rec.event]);
+      out.printf("\",\"cat\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%" PRIu32, EVENT_NAMES[rec.event], rec.core,
+                 rec.timestamp_us);
+
+      switch (event) {
+        case TraceEvent::APP_LOOP:
+          out.printf(",\"ph\":\"X\",\"dur\":%" PRIu32 ",\"args\":{\"components\":%" PRIu32 "}}", rec.arg1, rec.arg0);
+          break;
+        case TraceEvent::COMPONENT_LOOP:
+        case TraceEvent::SCHEDULER_CALL:
+        case TraceEvent::COMPONENT_SETUP:
+          out.printf(",\"ph\":\"X\",\"dur\":%" PRIu32 "}", rec.arg1);
+          break;
+        case TraceEvent::SENSOR_PUBLISH: {
+          float state;
+          memcpy(&state, &rec.arg0, sizeof(state));
+          // JSON has no NaN; unknown states are exported as null
+          if (std::isfinite(state)) {
+            out.printf(",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"state\":%g}}", state);
+          } else {
+            out.print(",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"state\":null}}");
+          }
+          break;
+        }
+        case TraceEvent::I2C_TRANSFER:
+          out.printf(",\"ph\":\"X\",\"dur\":%" PRIu32 ",\"args\":{\"address\":%" PRIu32 ",\"write\":%" PRIu32
+                     ",\"read\":%" PRIu32 ",\"error\":%" PRIu32 "}}",
+                     rec.arg1, rec.arg0 & 0xFF, (rec.arg0 >> 8) & 0xFF, (rec.arg0 >> 16) & 0xFF, rec.arg0 >> 24);
+          break;
+        case TraceEvent::API_SEND:
+          out.printf(",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"connection\":%" PRIu32 ",\"type\":%" PRIu32
+                     ",\"bytes\":%" PRIu32 "}}",
+                     rec.arg0 >> 8, rec.arg0 & 0xFF, rec.arg1);
+          break;
+      }
+    }
+  }
+  out.print("\n]}\n");
+}
+
+}  // namespace esphome
+
+#endif  // USE_TRACE_RECORDER
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_TRACE_RECORDER
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "esphome/core/hal.h"
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+
+#ifndef ESPHOME_TRACE_RING_SIZE
+// Records per core; power of two. 16 bytes each, so 8 KiB per core by default
+#define ESPHOME_TRACE_RING_SIZE 512
+#endif
+
+/// Event IDs stored in TraceRecord::event. Span events carry their duration in arg1.
+enum class TraceEvent : uint8_t {
+  APP_LOOP = 0,        ///< One Application::loop() pass. source: none, arg0: components run, arg1: duration us
+  COMPONENT_LOOP = 1,  ///< One Component::call() from the loop. source: component, arg1: duration us
+  SCHEDULER_CALL = 2,  ///< One scheduler callback. source: component, arg1: duration us
+  SENSOR_PUBLISH = 3,  ///< Sensor::publish_state(). source: sensor, arg0: raw state (float bits)
+  I2C_TRANSFER = 4,    ///< One I2C transaction. source: bus, arg0: addr | write << 8 | read << 16 | err << 24, arg1: us
+  API_SEND = 5,        ///< One API message written. source: server, arg0: type | connection << 8, arg1: bytes
+  COMPONENT_SETUP = 6,  ///< One Component::setup() from Application::setup(). source: component, arg1: duration us
+};
+
+/// One fixed-size trace record.
+struct TraceRecord {
+  uint32_t timestamp_us;  ///< micros() at the start of the event (wraps after ~71 minutes)
+  uint16_t source_id;     ///< Index into the recorder's source table, TRACE_NO_SOURCE for none
+  uint8_t event;          ///< TraceEvent
+  uint8_t core;
+  uint32_t arg0;
+  uint32_t arg1;
+};
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes");
+
+static constexpr uint16_t TRACE_NO_SOURCE = 0xFFFF;
+
+/// Sink for the exporters; called with consecutive chunks of the output file
+using TraceWriter = void (*)(void *ctx, const char *data, size_t len);
+
+/** Lightweight binary trace recorder.
+ *
+ * Each core writes into its own ring of fixed 16-byte records. Writers claim a slot with one relaxed
+ * fetch_add on the core's head, so tasks preempting each other on the same core never block. Sources
+ * (components, sensors, buses, connections) are interned on first sight into a lock-free table and
+ * recorded by index; their names are captured once, at intern time.
+ *
+ * Exporting pauses recording and renders either the raw records (replayable binary file) or a
+ * Chrome trace JSON that Perfetto and chrome://tracing open directly.
+ */
+class TraceRecorder {
+ public:
+  static constexpr size_t RING_SIZE = ESPHOME_TRACE_RING_SIZE;
+  static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "ESPHOME_TRACE_RING_SIZE must be a power of two");
+  static constexpr size_t MAX_SOURCES = 128;  // Power of two
+#ifdef USE_ESP32
+  static constexpr uint8_t NUM_CORES = portNUM_PROCESSORS;
+#else
+  static constexpr uint8_t NUM_CORES = 1;
+#endif
+
+  void set_enabled(bool enabled) { this->enabled_.store(enabled, std::memory_order_relaxed); }
+  bool is_enabled() const { return this->enabled_.load(std::memory_order_relaxed); }
+
+  /// Record an event. `name_fn` is only called the first time `source` is seen.
+  template<typename NameFn>
+  inline void record(TraceEvent event, const void *source, NameFn &&name_fn, uint32_t timestamp_us, uint32_t arg0,
+                     uint32_t arg1) {
+    if (!this->is_enabled())
+      return;
+    uint16_t source_id = TRACE_NO_SOURCE;
+    if (source != nullptr) {
+      source_id = this->find_source_(source);
+      if (source_id == TRACE_NO_SOURCE)
+        source_id = this->intern_source_(source, name_fn());
+    }
+    this->push_(event, source_id, timestamp_us, arg0, arg1);
+  }
+  /// Record an event without a source.
+  inline void record(TraceEvent event, uint32_t timestamp_us, uint32_t arg0, uint32_t arg1) {
+    if (this->is_enabled())
+      this->push_(event, TRACE_NO_SOURCE, timestamp_us, arg0, arg1);
+  }
+
+  /// Write the binary trace file: header, source table, then each core's records oldest first.
+  void export_binary(TraceWriter writer, void *ctx);
+  /// Write the recorded events as Chrome trace event JSON.
+  void export_chrome_json(TraceWriter writer, void *ctx);
+
+  /// Number of records currently held across all cores.
+  size_t size() const;
+
+ protected:
+  struct Ring {
+    std::atomic<uint32_t> head{0};
+    TraceRecord records[RING_SIZE];
+  };
+
+  static inline uint8_t core_id_() {
+#ifdef USE_ESP32
+    return static_cast<uint8_t>(xPortGetCoreID());
+#else
+    return 0;
+#endif
+  }
+  static inline size_t source_hash_(const void *source) {
+    // Objects are at least 4-byte aligned; Fibonacci hashing spreads the remaining bits
+    return (static_cast<uint32_t>(reinterpret_cast<uintptr_t>(source) >> 2) * 2654435761u) & (MAX_SOURCES - 1);
+  }
+
+  inline void push_(TraceEvent event, uint16_t source_id, uint32_t timestamp_us, uint32_t arg0, uint32_t arg1) {
+    uint8_t core = core_id_();
+    Ring &ring = this->rings_[core];
+    uint32_t index = ring.head.fetch_add(1, std::memory_order_relaxed);
+    TraceRecord &rec = ring.records[index & (RING_SIZE - 1)];
+    rec.timestamp_us = timestamp_us;
+    rec.source_id = source_id;
+    rec.event = static_cast<uint8_t>(event);
+    rec.core = core;
+    rec.arg0 = arg0;
+    rec.arg1 = arg1;
+  }
+
+  inline uint16_t find_source_(const void *source) const {
+    size_t slot = source_hash_(source);
+    for (size_t probe = 0; probe < MAX_SOURCES; probe++) {
+      const void *cur = this->sources_[slot].load(std::memory_order_acquire);
+      if (cur == source)
+        return static_cast<uint16_t>(slot);
+      if (cur == nullptr)
+        return TRACE_NO_SOURCE;
+      slot = (slot + 1) & (MAX_SOURCES - 1);
+    }
+    return TRACE_NO_SOURCE;
+  }
+  uint16_t intern_source_(const void *source, const char *name);
+
+  /// Index of the oldest record still held by `ring`, and how many follow it
+  static void ring_window_(const Ring &ring, uint32_t &first, uint32_t &count);
+
+  Ring rings_[NUM_CORES];
+  std::atomic<const void *> sources_[MAX_SOURCES]{};
+  const char *source_names_[MAX_SOURCES]{};
+  std::atomic<bool> enabled_{true};
+};
+
+extern TraceRecorder global_trace_recorder;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Current time for trace timestamps
+inline uint32_t trace_now() { return micros(); }
+
+}  // namespace esphome
+
+#define ESPHOME_TRACE_NOW() esphome::trace_now()
+#define ESPHOME_TRACE(event, source, name, start_us, arg0, arg1) \
+  esphome::global_trace_recorder.record(esphome::TraceEvent::event, source, [&]() -> const char * { return name; }, \
+                                        start_us, arg0, arg1)
+#define ESPHOME_TRACE_NO_SOURCE(event, start_us, arg0, arg1) \
+  esphome::global_trace_recorder.record(esphome::TraceEvent::event, start_us, arg0, arg1)
+
+#else  // USE_TRACE_RECORDER
+
+#define ESPHOME_TRACE_NOW() 0
+#define ESPHOME_TRACE(event, source, name, start_us, arg0, arg1)
+#define ESPHOME_TRACE_NO_SOURCE(event, start_us, arg0, arg1)
+
+#endif  // USE_TRACE_RECORDER
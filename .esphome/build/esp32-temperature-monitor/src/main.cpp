@@ -247,6 +247,7 @@ void setup() {
   api_apiserver_id = new api::APIServer();
   api_apiserver_id->set_component_source(LOG_STR("api"));
   App.register_component(api_apiserver_id);
+  api_apiserver_id->add_setup_dependency(wifi_wificomponent_id);
   api_apiserver_id->set_port(6053);
   api_apiserver_id->set_reboot_timeout(900000);
   api_apiserver_id->set_batch_delay(100);
@@ -391,6 +392,7 @@ void setup() {
   aht10_aht10component_id->set_component_source(LOG_STR("aht10.sensor"));
   App.register_component(aht10_aht10component_id);
   aht10_aht10component_id->set_i2c_bus(i2c_bus1);
+  aht10_aht10component_id->add_setup_dependency(i2c_bus1);
   aht10_aht10component_id->set_i2c_address(0x38);
   aht10_aht10component_id->set_variant(aht10::AHT10);
   temperature_sensor = new sensor::Sensor();
@@ -591,7 +593,12 @@ void setup() {
   oled_display->set_writer([](display::Display & it) -> void {
       #line 148 "d:\\ESP32\\ESP32_1306\\esp32-temperature-monitor.yaml"
        
-      if (my_time->now().timestamp - last_motion_time->value() > 60) {
+      static ESPTimeFormatter date_fmt("%Y-%m-%d");
+      static ESPTimeFormatter time_fmt("%H:%M:%S");
+      auto now = my_time->now();
+      
+       
+      if (now.timestamp - last_motion_time->value() > 60) {
         screen_on->value() = false;
       }
       
@@ -609,16 +616,12 @@ void setup() {
         }
         
          
-        char date_str[16];
-        time_t now = my_time->now().timestamp;
-        struct tm *timeinfo = localtime(&now);
-        strftime(date_str, sizeof(date_str), "%Y-%m-%d", timeinfo);
-        it.printf(0, 20, "%s", date_str);
+        date_fmt.update(now);
+        it.printf(0, 20, "%s", date_fmt.c_str());
         
          
-        char time_str[16];
-        strftime(time_str, sizeof(time_str), "%H:%M:%S", timeinfo);
-        it.printf(0, 35, "%s", time_str);
+        time_fmt.update(now);
+        it.printf(0, 35, "%s", time_fmt.c_str());
         
          
         char temp_str[20];
@@ -633,6 +636,7 @@ void setup() {
       
   });
   oled_display->set_i2c_bus(i2c_bus0);
+  oled_display->add_setup_dependency(i2c_bus0);
   oled_display->set_i2c_address(0x3C);
   lambdaaction_id = new StatelessLambdaAction<>([]() -> void {
       #line 9 "d:\\ESP32\\ESP32_1306\\esp32-temperature-monitor.yaml"
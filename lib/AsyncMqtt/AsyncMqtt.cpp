@@ -0,0 +1,435 @@
+#include "AsyncMqtt.h"
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <fcntl.h>
+#include <lwip/sockets.h>
+#include <unistd.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// 固定报头类型
+#define MQTT_CONNECT 0x10
+#define MQTT_CONNACK 0x20
+#define MQTT_PUBLISH 0x30
+#define MQTT_PUBACK 0x40
+#define MQTT_PINGREQ 0xC0
+#define MQTT_PINGRESP 0xD0
+#define MQTT_PUBLISH_DUP 0x08
+
+// ==================== 套接字传输层 ====================
+
+bool MqttSocketTransport::begin(const char* host, uint16_t port) {
+  close();
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if(inet_pton(AF_INET, host, &addr.sin_addr) != 1) return false;
+
+  fd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if(fd_ < 0) return false;
+  fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+  // 报文已经在客户端合并，不需要Nagle再等待
+  int one = 1;
+  setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if(connect(fd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 && errno != EINPROGRESS) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+int MqttSocketTransport::status() {
+  if(fd_ < 0) return -1;
+  if(connected_) return 1;
+  fd_set writable;
+  FD_ZERO(&writable);
+  FD_SET(fd_, &writable);
+  struct timeval timeout = {0, 0};
+  if(select(fd_ + 1, nullptr, &writable, nullptr, &timeout) <= 0) return 0;
+  int err = 0;
+  socklen_t len = sizeof(err);
+  if(getsockopt(fd_, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) return -1;
+  connected_ = true;
+  return 1;
+}
+
+int MqttSocketTransport::write(const uint8_t* data, size_t len) {
+  if(fd_ < 0) return -1;
+  ssize_t sent = send(fd_, data, len, MSG_NOSIGNAL);
+  if(sent >= 0) return (int)sent;
+  return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+}
+
+int MqttSocketTransport::read(uint8_t* data, size_t len) {
+  if(fd_ < 0) return -1;
+  ssize_t got = recv(fd_, data, len, 0);
+  if(got > 0) return (int)got;
+  if(got == 0) return -1;  // 对端关闭
+  return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+}
+
+void MqttSocketTransport::close() {
+  if(fd_ >= 0) ::close(fd_);
+  fd_ = -1;
+  connected_ = false;
+}
+
+// ==================== 报文编码 ====================
+
+static size_t remainingLengthSize(size_t len) {
+  return len < 128 ? 1 : len < 16384 ? 2 : len < 2097152 ? 3 : 4;
+}
+
+static uint8_t* putRemainingLength(uint8_t* p, size_t len) {
+  do {
+    uint8_t b = len & 0x7F;
+    len >>= 7;
+    *p++ = len > 0 ? (b | 0x80) : b;
+  } while(len > 0);
+  return p;
+}
+
+static uint8_t* putString(uint8_t* p, const char* s, size_t len) {
+  *p++ = (uint8_t)(len >> 8);
+  *p++ = (uint8_t)len;
+  memcpy(p, s, len);
+  return p + len;
+}
+
+size_t AsyncMqttClient::encodePublish_(uint8_t* out, size_t capacity, const char* topic, const char* payload,
+                                       bool retain, uint8_t qos, uint16_t packetId) {
+  size_t topicLen = strlen(topic);
+  size_t payloadLen = strlen(payload);
+  size_t remaining = 2 + topicLen + (qos > 0 ? 2 : 0) + payloadLen;
+  size_t total = 1 + remainingLengthSize(remaining) + remaining;
+  if(topicLen > UINT16_MAX || total > capacity) return 0;
+
+  uint8_t* p = out;
+  *p++ = MQTT_PUBLISH | (qos << 1) | (retain ? 0x01 : 0x00);
+  p = putRemainingLength(p, remaining);
+  p = putString(p, topic, topicLen);
+  if(qos > 0) {
+    *p++ = (uint8_t)(packetId >> 8);
+    *p++ = (uint8_t)packetId;
+  }
+  memcpy(p, payload, payloadLen);
+  return total;
+}
+
+size_t AsyncMqttClient::encodeConnect_(uint8_t* out, size_t capacity) const {
+  static const char OFFLINE[] = "offline";
+  size_t clientIdLen = strlen(clientId_);
+  size_t remaining = 10 + 2 + clientIdLen;
+  uint8_t flags = 0x02;  // 清除会话：未确认的QoS1消息由客户端自己重发
+  if(availabilityTopic_ != nullptr) {
+    remaining += 2 + strlen(availabilityTopic_) + 2 + sizeof(OFFLINE) - 1;
+    flags |= 0x04 | 0x20;  // 遗嘱，QoS0，保留
+  }
+  if(username_ != nullptr) {
+    remaining += 2 + strlen(username_);
+    flags |= 0x80;
+    if(password_ != nullptr) {
+      remaining += 2 + strlen(password_);
+      flags |= 0x40;
+    }
+  }
+  size_t total = 1 + remainingLengthSize(remaining) + remaining;
+  if(total > capacity) return 0;
+
+  uint8_t* p = out;
+  *p++ = MQTT_CONNECT;
+  p = putRemainingLength(p, remaining);
+  p = putString(p, "MQTT", 4);
+  *p++ = 0x04;  // 协议级别3.1.1
+  *p++ = flags;
+  *p++ = (uint8_t)(MQTT_KEEPALIVE_SEC >> 8);
+  *p++ = (uint8_t)MQTT_KEEPALIVE_SEC;
+  p = putString(p, clientId_, clientIdLen);
+  if(availabilityTopic_ != nullptr) {
+    p = putString(p, availabilityTopic_, strlen(availabilityTopic_));
+    p = putString(p, OFFLINE, sizeof(OFFLINE) - 1);
+  }
+  if(username_ != nullptr) {
+    p = putString(p, username_, strlen(username_));
+    if(password_ != nullptr) p = putString(p, password_, strlen(password_));
+  }
+  return total;
+}
+
+// ==================== 客户端 ====================
+
+void AsyncMqttClient::setServer(const char* host, uint16_t port) {
+  host_ = host;
+  port_ = port;
+}
+
+void AsyncMqttClient::setCredentials(const char* clientId, const char* username, const char* password) {
+  clientId_ = clientId;
+  username_ = username;
+  password_ = password;
+}
+
+void AsyncMqttClient::setAvailability(const char* topic) {
+  availabilityTopic_ = topic;
+}
+
+bool AsyncMqttClient::publish(const char* topic, const char* payload, bool retain, uint8_t qos) {
+  if(qos > 1 || slotCount_ >= MQTT_QUEUE_SLOTS) {
+    stats_.dropped++;
+    return false;
+  }
+  uint16_t packetId = 0;
+  if(qos == 1) {
+    packetId = nextPacketId_;
+    if(++nextPacketId_ == 0) nextPacketId_ = 1;
+  }
+  size_t capacity = MQTT_QUEUE_BYTES - arenaUsed_;
+  if(capacity > MQTT_TX_BUFFER_SIZE) capacity = MQTT_TX_BUFFER_SIZE;
+  size_t len = encodePublish_(arena_ + arenaUsed_, capacity, topic, payload, retain, qos, packetId);
+  if(len == 0) {
+    stats_.dropped++;
+    return false;
+  }
+  Slot& slot = slots_[slotCount_++];
+  slot.offset = (uint16_t)arenaUsed_;
+  slot.length = (uint16_t)len;
+  slot.packetId = packetId;
+  slot.state = SLOT_QUEUED;
+  arenaUsed_ += len;
+  if(packetId != 0) lastPacketId_ = packetId;
+  stats_.queued++;
+  return true;
+}
+
+void AsyncMqttClient::removeSlot_(uint8_t index) {
+  Slot removed = slots_[index];
+  size_t tail = removed.offset + removed.length;
+  memmove(arena_ + removed.offset, arena_ + tail, arenaUsed_ - tail);
+  arenaUsed_ -= removed.length;
+  for(uint8_t i = index; i + 1 < slotCount_; i++) {
+    slots_[i] = slots_[i + 1];
+    slots_[i].offset -= removed.length;
+  }
+  slotCount_--;
+}
+
+bool AsyncMqttClient::appendTx_(const uint8_t* data, size_t len) {
+  if(txLen_ + len > sizeof(tx_)) return false;
+  memcpy(tx_ + txLen_, data, len);
+  txLen_ += len;
+  return true;
+}
+
+void AsyncMqttClient::fillTx_() {
+  uint8_t i = 0;
+  while(i < slotCount_) {
+    Slot& slot = slots_[i];
+    if(slot.state == SLOT_INFLIGHT) {
+      i++;
+      continue;
+    }
+    // 在途窗口已满或缓冲区放不下时停止，保持消息顺序
+    if(slot.packetId != 0 && inflight_ >= MQTT_MAX_INFLIGHT) break;
+    if(!appendTx_(arena_ + slot.offset, slot.length)) break;
+    if(slot.packetId == 0) {
+      removeSlot_(i);  // QoS0写出即完成
+      continue;
+    }
+    slot.state = SLOT_INFLIGHT;
+    inflight_++;
+    i++;
+  }
+}
+
+void AsyncMqttClient::flushTx_(uint32_t nowMs) {
+  if(txLen_ == 0) return;
+  int written = transport_.write(tx_, txLen_);
+  stats_.writes++;
+  if(written < 0) {
+    dropConnection_(nowMs);
+    return;
+  }
+  if(written == 0) return;
+  stats_.bytesSent += written;
+  lastTx_ = nowMs;
+  txLen_ -= written;
+  memmove(tx_, tx_ + written, txLen_);
+}
+
+void AsyncMqttClient::startConnect_(uint32_t nowMs) {
+  attempted_ = true;
+  stateSince_ = nowMs;
+  state_ = transport_.begin(host_, port_) ? MQTT_TCP_CONNECTING : MQTT_DISCONNECTED;
+}
+
+void AsyncMqttClient::dropConnection_(uint32_t nowMs) {
+  transport_.close();
+  state_ = MQTT_DISCONNECTED;
+  stateSince_ = nowMs;
+  txLen_ = 0;
+  rxLen_ = 0;
+  rxSkip_ = 0;
+  pingOutstanding_ = false;
+  // 未确认的QoS1消息回到队列，下次连接后带DUP标志重发
+  for(uint8_t i = 0; i < slotCount_; i++) {
+    if(slots_[i].state != SLOT_INFLIGHT) continue;
+    slots_[i].state = SLOT_QUEUED;
+    arena_[slots_[i].offset] |= MQTT_PUBLISH_DUP;
+    stats_.retransmits++;
+  }
+  inflight_ = 0;
+}
+
+void AsyncMqttClient::handlePacket_(uint8_t header, const uint8_t* body, size_t len, uint32_t nowMs) {
+  switch(header & 0xF0) {
+    case MQTT_CONNACK:
+      if(state_ != MQTT_AWAIT_CONNACK) break;
+      if(len < 2 || body[1] != 0) {  // 代理拒绝连接
+        dropConnection_(nowMs);
+        break;
+      }
+      state_ = MQTT_CONNECTED;
+      stats_.connects++;
+      if(availabilityTopic_ != nullptr) {
+        // 上线消息直接放在最前面，先于队列中的任何消息发出
+        txLen_ += encodePublish_(tx_ + txLen_, sizeof(tx_) - txLen_, availabilityTopic_, "online", true, 0, 0);
+      }
+      if(onConnect_ != nullptr) onConnect_();
+      break;
+    case MQTT_PUBACK: {
+      if(len < 2) break;
+      uint16_t packetId = (uint16_t)(body[0] << 8 | body[1]);
+      for(uint8_t i = 0; i < slotCount_; i++) {
+        if(slots_[i].state == SLOT_INFLIGHT && slots_[i].packetId == packetId) {
+          removeSlot_(i);
+          inflight_--;
+          stats_.acked++;
+          if(onAcked_ != nullptr) onAcked_(packetId);
+          break;
+        }
+      }
+      break;
+    }
+    case MQTT_PINGRESP:
+      pingOutstanding_ = false;
+      break;
+    default:
+      break;  // 不订阅任何主题，其他报文忽略
+  }
+}
+
+void AsyncMqttClient::readInput_(uint32_t nowMs) {
+  while(rxLen_ < sizeof(rx_)) {
+    int got = transport_.read(rx_ + rxLen_, sizeof(rx_) - rxLen_);
+    if(got < 0) {
+      dropConnection_(nowMs);
+      return;
+    }
+    if(got == 0) return;
+    lastRx_ = nowMs;
+    rxLen_ += got;
+
+    size_t pos = 0;
+    while(pos < rxLen_) {
+      size_t avail = rxLen_ - pos;
+      if(rxSkip_ > 0) {
+        size_t skip = rxSkip_ < avail ? rxSkip_ : avail;
+        pos += skip;
+        rxSkip_ -= skip;
+        continue;
+      }
+      // 固定报头：类型字节 + 1~4字节剩余长度
+      size_t remaining = 0;
+      size_t headerLen = 1;
+      bool complete = false;
+      while(headerLen < avail && headerLen <= 4) {
+        uint8_t b = rx_[pos + headerLen];
+        remaining |= (size_t)(b & 0x7F) << (7 * (headerLen - 1));
+        headerLen++;
+        if((b & 0x80) == 0) {
+          complete = true;
+          break;
+        }
+      }
+      if(!complete) {
+        if(headerLen > 4) {  // 剩余长度格式错误
+          dropConnection_(nowMs);
+          return;
+        }
+        break;
+      }
+      size_t total = headerLen + remaining;
+      if(total > sizeof(rx_)) {
+        rxSkip_ = total;
+        continue;
+      }
+      if(avail < total) break;
+      handlePacket_(rx_[pos], rx_ + pos + headerLen, remaining, nowMs);
+      if(state_ == MQTT_DISCONNECTED) return;
+      pos += total;
+    }
+    rxLen_ -= pos;
+    memmove(rx_, rx_ + pos, rxLen_);
+  }
+}
+
+void AsyncMqttClient::loop(uint32_t nowMs) {
+  switch(state_) {
+    case MQTT_DISCONNECTED:
+      if(host_ == nullptr) return;
+      if(!attempted_ || nowMs - stateSince_ >= MQTT_RECONNECT_INTERVAL_MS) startConnect_(nowMs);
+      return;  // 下次循环再检查TCP连接状态
+
+    case MQTT_TCP_CONNECTING: {
+      int status = transport_.status();
+      if(status < 0 || nowMs - stateSince_ >= MQTT_CONNECT_TIMEOUT_MS) {
+        dropConnection_(nowMs);
+        return;
+      }
+      if(status == 0) return;
+      txLen_ = encodeConnect_(tx_, sizeof(tx_));
+      state_ = MQTT_AWAIT_CONNACK;
+      lastRx_ = nowMs;
+      break;
+    }
+
+    case MQTT_AWAIT_CONNACK:
+      if(nowMs - stateSince_ >= MQTT_CONNECT_TIMEOUT_MS) {
+        dropConnection_(nowMs);
+        return;
+      }
+      break;
+
+    case MQTT_CONNECTED: {
+      const uint32_t keepAliveMs = MQTT_KEEPALIVE_SEC * 1000UL;
+      if(nowMs - lastRx_ >= keepAliveMs + keepAliveMs / 2) {  // 心跳超时
+        dropConnection_(nowMs);
+        return;
+      }
+      if(!pingOutstanding_ && (nowMs - lastTx_ >= keepAliveMs || nowMs - lastRx_ >= keepAliveMs)) {
+        static const uint8_t PING[] = {MQTT_PINGREQ, 0x00};
+        pingOutstanding_ = appendTx_(PING, sizeof(PING));
+      }
+      break;
+    }
+  }
+
+  readInput_(nowMs);
+  if(state_ == MQTT_CONNECTED) fillTx_();
+  if(state_ != MQTT_DISCONNECTED) flushTx_(nowMs);
+}
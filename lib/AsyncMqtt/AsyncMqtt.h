@@ -0,0 +1,177 @@
+/**
+ * 异步流水线MQTT 3.1.1客户端（替代PubSubClient）
+ *
+ * - publish()只把报文编码进有界的发送队列，立即返回，不等待TCP写入
+ * - QoS1消息按报文标识符跟踪，最多MQTT_MAX_INFLIGHT条同时在途，收到PUBACK才出队；
+ *   重连后未确认的消息带DUP标志按原顺序重发
+ * - loop()把队列中可发送的报文拼接到一个发送缓冲区，每次只调用一次TCP写入；
+ *   套接字暂时写不下的部分留到下次循环，不会阻塞主循环
+ * - 连接过程非阻塞：TCP连接、CONNECT/CONNACK都在loop()中推进，失败后按间隔重试
+ * - setAvailability()配置遗嘱消息（断线时代理发布"offline"），每次连上后自动发布"online"
+ *
+ * 所有接口都显式传入毫秒时间戳，传输层可替换，便于在测试中模拟代理。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MQTT_QUEUE_BYTES
+#define MQTT_QUEUE_BYTES 3072            // 发送队列报文存储区大小（字节）
+#endif
+#ifndef MQTT_QUEUE_SLOTS
+#define MQTT_QUEUE_SLOTS 16              // 发送队列最大报文条数
+#endif
+#ifndef MQTT_TX_BUFFER_SIZE
+#define MQTT_TX_BUFFER_SIZE 1024         // 单次合并写入缓冲区大小（也是单条报文的上限）
+#endif
+#ifndef MQTT_RX_BUFFER_SIZE
+#define MQTT_RX_BUFFER_SIZE 128          // 接收缓冲区大小（更长的入站报文直接跳过）
+#endif
+#ifndef MQTT_MAX_INFLIGHT
+#define MQTT_MAX_INFLIGHT 4              // 同时在途（未收到PUBACK）的QoS1消息数
+#endif
+#define MQTT_KEEPALIVE_SEC 15            // 心跳间隔（秒）
+#define MQTT_CONNECT_TIMEOUT_MS 5000     // TCP连接+CONNACK超时
+#define MQTT_RECONNECT_INTERVAL_MS 5000  // 连接失败后的重试间隔
+
+/**
+ * 非阻塞传输层接口
+ */
+class MqttTransport {
+ public:
+  virtual ~MqttTransport() = default;
+  /** 发起连接，立即返回；返回false表示无法发起 */
+  virtual bool begin(const char* host, uint16_t port) = 0;
+  /** 连接状态：1已连接，0连接中，-1失败 */
+  virtual int status() = 0;
+  /** 写入数据，返回实际接受的字节数（0表示暂时写不下），-1表示连接出错 */
+  virtual int write(const uint8_t* data, size_t len) = 0;
+  /** 读取数据，返回读到的字节数（0表示暂无数据），-1表示连接已关闭 */
+  virtual int read(uint8_t* data, size_t len) = 0;
+  virtual void close() = 0;
+};
+
+/**
+ * 基于非阻塞BSD套接字的传输层（ESP32上为lwIP，主机上为POSIX）
+ * 为避免阻塞DNS查询，host只接受IPv4地址字面量
+ */
+class MqttSocketTransport : public MqttTransport {
+ public:
+  ~MqttSocketTransport() override { close(); }
+  bool begin(const char* host, uint16_t port) override;
+  int status() override;
+  int write(const uint8_t* data, size_t len) override;
+  int read(uint8_t* data, size_t len) override;
+  void close() override;
+
+ private:
+  int fd_ = -1;
+  bool connected_ = false;
+};
+
+enum MqttState : uint8_t {
+  MQTT_DISCONNECTED,     // 等待重试间隔
+  MQTT_TCP_CONNECTING,   // TCP连接中
+  MQTT_AWAIT_CONNACK,    // 已发送CONNECT，等待CONNACK
+  MQTT_CONNECTED,
+};
+
+// 运行统计（累计值）
+struct MqttStats {
+  uint32_t queued = 0;       // 入队的PUBLISH
+  uint32_t dropped = 0;      // 队列已满被拒绝的PUBLISH
+  uint32_t acked = 0;        // 收到PUBACK的QoS1消息
+  uint32_t retransmits = 0;  // 重连后重发的QoS1消息
+  uint32_t writes = 0;       // 传输层写入调用次数
+  uint32_t bytesSent = 0;
+  uint32_t connects = 0;     // 成功建立的会话数
+};
+
+class AsyncMqttClient {
+ public:
+  explicit AsyncMqttClient(MqttTransport& transport) : transport_(transport) {}
+
+  void setServer(const char* host, uint16_t port);
+  /** 客户端ID与可选的用户名/密码（字符串需在客户端生命周期内有效） */
+  void setCredentials(const char* clientId, const char* username = nullptr, const char* password = nullptr);
+  /** 遗嘱主题：断线时代理发布保留消息"offline"，每次连接成功后自动发布保留消息"online" */
+  void setAvailability(const char* topic);
+  /** 每次会话建立（收到CONNACK）后调用，用于重新发布发现消息等 */
+  void onConnect(void (*callback)()) { onConnect_ = callback; }
+  /** 收到PUBACK时调用，参数为publish()后lastPacketId()返回的报文标识符 */
+  void onAcked(void (*callback)(uint16_t packetId)) { onAcked_ = callback; }
+
+  /**
+   * 把一条PUBLISH加入发送队列（未连接时也可入队，连上后按顺序发送）
+   * qos只支持0和1；队列或存储区已满、报文超过MQTT_TX_BUFFER_SIZE时返回false
+   */
+  bool publish(const char* topic, const char* payload, bool retain = false, uint8_t qos = 0);
+
+  /**
+   * 推进连接状态机、处理入站报文，并把可发送的报文合并成一次写入
+   */
+  void loop(uint32_t nowMs);
+
+  /** 最近一次入队的QoS1消息的报文标识符 */
+  uint16_t lastPacketId() const { return lastPacketId_; }
+  bool connected() const { return state_ == MQTT_CONNECTED; }
+  MqttState state() const { return state_; }
+  size_t queuedCount() const { return slotCount_; }
+  uint8_t inflightCount() const { return inflight_; }
+  const MqttStats& stats() const { return stats_; }
+
+ private:
+  enum SlotState : uint8_t { SLOT_QUEUED, SLOT_INFLIGHT };
+  struct Slot {
+    uint16_t offset;    // 报文在存储区中的偏移
+    uint16_t length;    // 完整报文长度
+    uint16_t packetId;  // QoS1报文标识符，QoS0为0
+    SlotState state;
+  };
+
+  static size_t encodePublish_(uint8_t* out, size_t capacity, const char* topic, const char* payload, bool retain,
+                               uint8_t qos, uint16_t packetId);
+  size_t encodeConnect_(uint8_t* out, size_t capacity) const;
+  void startConnect_(uint32_t nowMs);
+  void dropConnection_(uint32_t nowMs);
+  void removeSlot_(uint8_t index);
+  void fillTx_();
+  void flushTx_(uint32_t nowMs);
+  void readInput_(uint32_t nowMs);
+  void handlePacket_(uint8_t header, const uint8_t* body, size_t len, uint32_t nowMs);
+  bool appendTx_(const uint8_t* data, size_t len);
+
+  MqttTransport& transport_;
+  const char* host_ = nullptr;
+  uint16_t port_ = 1883;
+  const char* clientId_ = "";
+  const char* username_ = nullptr;
+  const char* password_ = nullptr;
+  const char* availabilityTopic_ = nullptr;
+  void (*onConnect_)() = nullptr;
+  void (*onAcked_)(uint16_t packetId) = nullptr;
+
+  MqttState state_ = MQTT_DISCONNECTED;
+  bool attempted_ = false;     // 是否已经尝试过连接（首次连接不等待重试间隔）
+  bool pingOutstanding_ = false;
+  uint32_t stateSince_ = 0;    // 进入当前状态的时间
+  uint32_t lastTx_ = 0;
+  uint32_t lastRx_ = 0;
+  uint16_t nextPacketId_ = 1;
+  uint16_t lastPacketId_ = 0;
+
+  uint8_t arena_[MQTT_QUEUE_BYTES];  // 队列中的报文按顺序紧密存放
+  size_t arenaUsed_ = 0;
+  Slot slots_[MQTT_QUEUE_SLOTS];
+  uint8_t slotCount_ = 0;
+  uint8_t inflight_ = 0;
+
+  uint8_t tx_[MQTT_TX_BUFFER_SIZE];  // 待写入的合并数据（含上次未写完的部分）
+  size_t txLen_ = 0;
+  uint8_t rx_[MQTT_RX_BUFFER_SIZE];
+  size_t rxLen_ = 0;
+  size_t rxSkip_ = 0;                // 超长入站报文剩余待跳过的字节
+
+  MqttStats stats_;
+};
@@ -0,0 +1,49 @@
+#include "BootProfile.h"
+
+#include <stdio.h>
+
+int BootProfile::begin(const char* name, uint32_t nowMs) {
+  if(count_ >= BOOT_PROFILE_MAX_PHASES) return -1;
+  Phase& phase = phases_[count_];
+  phase.name = name;
+  phase.startMs = nowMs;
+  phase.endMs = 0;
+  phase.finished = false;
+  return count_++;
+}
+
+void BootProfile::end(int phase, uint32_t nowMs) {
+  if(phase < 0 || phase >= count_ || phases_[phase].finished) return;
+  phases_[phase].endMs = nowMs;
+  phases_[phase].finished = true;
+}
+
+bool BootProfile::finished(int phase) const {
+  return phase >= 0 && phase < count_ && phases_[phase].finished;
+}
+
+size_t BootProfile::toJson(char* out, size_t capacity) const {
+  if(capacity == 0) return 0;
+  size_t len = 0;
+  out[len++] = '{';
+  for(int i = 0; i < count_ && len < capacity; i++) {
+    const Phase& phase = phases_[i];
+    int n;
+    if(phase.finished) {
+      n = snprintf(out + len, capacity - len, "%s\"%s\":{\"start\":%lu,\"ms\":%lu}", i == 0 ? "" : ",", phase.name,
+                   (unsigned long)phase.startMs, (unsigned long)(phase.endMs - phase.startMs));
+    } else {
+      n = snprintf(out + len, capacity - len, "%s\"%s\":{\"start\":%lu,\"ms\":null}", i == 0 ? "" : ",", phase.name,
+                   (unsigned long)phase.startMs);
+    }
+    if(n < 0) return 0;
+    len += n;
+  }
+  if(len + 2 > capacity) {
+    out[0] = '\0';
+    return 0;
+  }
+  out[len++] = '}';
+  out[len] = '\0';
+  return len;
+}
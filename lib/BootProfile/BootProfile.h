@@ -0,0 +1,44 @@
+/**
+ * 启动阶段计时（/json中的"boot"字段）
+ *
+ * 每个阶段记录开始时间和结束时间（启动后的毫秒数），阶段之间可以重叠：
+ * 例如WiFi关联在后台进行的同时初始化显示屏和传感器。
+ * 结束时间可以在其他任务中写入（例如WiFi事件回调），先写时间再置完成标志。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BOOT_PROFILE_MAX_PHASES 8
+
+class BootProfile {
+ public:
+  /**
+   * 开始一个阶段，返回阶段编号；阶段已满时返回-1
+   * name必须是静态字符串
+   */
+  int begin(const char* name, uint32_t nowMs);
+
+  /** 结束阶段（只记录第一次），编号无效时忽略 */
+  void end(int phase, uint32_t nowMs);
+
+  bool finished(int phase) const;
+
+  /**
+   * 输出JSON对象，例如 {"wifi":{"start":3,"ms":812},"ntp":{"start":4,"ms":null}}
+   * 未结束的阶段ms为null；缓冲区不足时返回0
+   */
+  size_t toJson(char* out, size_t capacity) const;
+
+ private:
+  struct Phase {
+    const char* name;
+    uint32_t startMs;
+    volatile uint32_t endMs;
+    volatile bool finished;
+  };
+
+  Phase phases_[BOOT_PROFILE_MAX_PHASES];
+  int count_ = 0;
+};
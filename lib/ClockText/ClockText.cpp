@@ -0,0 +1,99 @@
+#include "ClockText.h"
+
+#include <string.h>
+
+// 写入两位十进制数字
+static inline void writeTwoDigits(char* p, int value) {
+  p[0] = (char)('0' + value / 10);
+  p[1] = (char)('0' + value % 10);
+}
+
+static inline bool isLeapYear(int year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int daysInMonth(int mon, int year) {
+  static const uint8_t DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return (mon == 1 && isLeapYear(year)) ? 29 : DAYS[mon];
+}
+
+bool ClockText::update(const struct tm& t) {
+  bool sameDay = valid_ && t.tm_year == tm_.tm_year && t.tm_mon == tm_.tm_mon && t.tm_mday == tm_.tm_mday;
+  bool sameMinute = sameDay && t.tm_hour == tm_.tm_hour && t.tm_min == tm_.tm_min;
+
+  dateChanged_ = false;
+  if(sameMinute) {
+    // 快速路径：只有秒可能变化，只改写变化的数字
+    timeChangedEnd_ = 8;
+    if(t.tm_sec / 10 != tm_.tm_sec / 10) {
+      timeChangedBegin_ = 6;
+    } else if(t.tm_sec != tm_.tm_sec) {
+      timeChangedBegin_ = 7;
+    } else {
+      timeChangedBegin_ = timeChangedEnd_ = 0;
+    }
+    writeTwoDigits(timeStr_ + 6, t.tm_sec);
+  } else {
+    // 跨分钟：整体重新生成，并找出第一个变化的字符
+    char oldTime[9];
+    memcpy(oldTime, timeStr_, sizeof(oldTime));
+    renderTime_(t);
+    timeChangedBegin_ = 0;
+    while(timeChangedBegin_ < 8 && oldTime[timeChangedBegin_] == timeStr_[timeChangedBegin_]) timeChangedBegin_++;
+    timeChangedEnd_ = (timeChangedBegin_ < 8) ? 8 : 0;
+    if(timeChangedBegin_ == 8) timeChangedBegin_ = 0;
+    if(!sameDay) {
+      renderDate_(t);
+      dateChanged_ = true;
+    }
+  }
+
+  tm_ = t;
+  valid_ = true;
+  return timeChangedBegin_ != timeChangedEnd_ || dateChanged_;
+}
+
+bool ClockText::incrementSecond() {
+  if(!valid_) return false;
+  struct tm t = tm_;
+  if(++t.tm_sec >= 60) {
+    t.tm_sec = 0;
+    if(++t.tm_min >= 60) {
+      t.tm_min = 0;
+      if(++t.tm_hour >= 24) {
+        t.tm_hour = 0;
+        t.tm_wday = (t.tm_wday + 1) % 7;
+        t.tm_yday++;
+        if(++t.tm_mday > daysInMonth(t.tm_mon, t.tm_year + 1900)) {
+          t.tm_mday = 1;
+          if(++t.tm_mon >= 12) {
+            t.tm_mon = 0;
+            t.tm_yday = 0;
+            t.tm_year++;
+          }
+        }
+      }
+    }
+  }
+  return update(t);
+}
+
+void ClockText::renderTime_(const struct tm& t) {
+  writeTwoDigits(timeStr_, t.tm_hour);
+  timeStr_[2] = ':';
+  writeTwoDigits(timeStr_ + 3, t.tm_min);
+  timeStr_[5] = ':';
+  writeTwoDigits(timeStr_ + 6, t.tm_sec);
+  timeStr_[8] = '\0';
+}
+
+void ClockText::renderDate_(const struct tm& t) {
+  int year = t.tm_year + 1900;
+  writeTwoDigits(dateStr_, (year / 100) % 100);
+  writeTwoDigits(dateStr_ + 2, year % 100);
+  dateStr_[4] = '-';
+  writeTwoDigits(dateStr_ + 5, t.tm_mon + 1);
+  dateStr_[7] = '-';
+  writeTwoDigits(dateStr_ + 8, t.tm_mday);
+  dateStr_[10] = '\0';
+}
@@ -0,0 +1,47 @@
+/**
+ * 增量式时钟字符串（"HH:MM:SS" 与 "YYYY-MM-DD"）
+ *
+ * 缓存上一次格式化的时间和日期字符串：
+ * - 同一分钟内只改写秒的两位数字
+ * - 分钟、小时或日期变化时才整体重新生成
+ * 不调用 sprintf/strftime，并记录本次变化的字符范围，OLED可以只重绘变化的区域。
+ */
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+class ClockText {
+ public:
+  /**
+   * 用新的时间更新字符串，返回字符串是否发生变化
+   */
+  bool update(const struct tm& t);
+
+  /**
+   * 时间前进1秒（不调用localtime），跨分钟/小时/日期时整体重新生成
+   */
+  bool incrementSecond();
+
+  const char* time() const { return timeStr_; }      // "HH:MM:SS"，未更新前为空字符串
+  const char* date() const { return dateStr_; }      // "YYYY-MM-DD"，未更新前为空字符串
+  const struct tm& tm() const { return tm_; }        // 当前字符串对应的时间
+
+  // 本次更新中时间字符串变化的范围 [timeChangedBegin, timeChangedEnd)，相等表示未变化
+  uint8_t timeChangedBegin() const { return timeChangedBegin_; }
+  uint8_t timeChangedEnd() const { return timeChangedEnd_; }
+  // 本次更新中日期字符串是否变化
+  bool dateChanged() const { return dateChanged_; }
+
+ private:
+  void renderTime_(const struct tm& t);
+  void renderDate_(const struct tm& t);
+
+  struct tm tm_ = {};
+  char timeStr_[9] = "";
+  char dateStr_[11] = "";
+  uint8_t timeChangedBegin_ = 0;
+  uint8_t timeChangedEnd_ = 0;
+  bool dateChanged_ = false;
+  bool valid_ = false;
+};
@@ -0,0 +1,72 @@
+#include "FloatFormat.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// 10的幂查找表（0~4位小数）
+static const uint16_t POW10[FLOAT_FORMAT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000};
+
+size_t formatFloatFixed(char* buf, size_t bufSize, float value, uint8_t decimals) {
+  if(bufSize == 0) return 0;
+
+  // 拆解IEEE754单精度：value = mantissa * 2^-shift
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bool negative = (bits >> 31) != 0;
+  int exponent = (bits >> 23) & 0xFF;
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  uint64_t scaled = 0;                     // value * 10^decimals 的精确分子
+  int shift = 0;
+  bool fast = (exponent != 0xFF) && (decimals <= FLOAT_FORMAT_MAX_DECIMALS);
+  if(fast) {
+    if(exponent == 0) {
+      exponent = 1;                        // 非规格化数
+    } else {
+      mantissa |= 0x800000;
+    }
+    shift = 150 - exponent;
+    scaled = (uint64_t)mantissa * POW10[decimals];   // 小于 2^38
+    fast = (shift >= -25);                 // 左移后必须小于 2^63
+  }
+
+  if(!fast) {
+    // 回退：NaN/Inf/超大数值
+    int len = snprintf(buf, bufSize, "%.*f", decimals, value);
+    if(len < 0) return 0;
+    return ((size_t)len >= bufSize) ? bufSize - 1 : (size_t)len;
+  }
+
+  // 与printf相同的舍入方式：就近舍入，恰好一半时取偶数
+  uint64_t rounded;
+  if(shift <= 0) {
+    rounded = scaled << -shift;
+  } else if(shift >= 64) {
+    rounded = 0;                           // scaled < 2^38，永远小于一半
+  } else {
+    rounded = scaled >> shift;
+    uint64_t remainder = scaled & (((uint64_t)1 << shift) - 1);
+    uint64_t half = (uint64_t)1 << (shift - 1);
+    if(remainder > half || (remainder == half && (rounded & 1))) rounded++;
+  }
+
+  // 从后往前写：小数位、小数点、整数位、符号
+  char tmp[27];                            // "-" + 20位整数 + "." + 4位小数
+  char* p = tmp + sizeof(tmp);
+  for(uint8_t i = 0; i < decimals; i++) {
+    *--p = (char)('0' + rounded % 10);
+    rounded /= 10;
+  }
+  if(decimals > 0) *--p = '.';
+  do {
+    *--p = (char)('0' + rounded % 10);
+    rounded /= 10;
+  } while(rounded != 0);
+  if(negative) *--p = '-';
+
+  size_t len = (size_t)(tmp + sizeof(tmp) - p);
+  if(len > bufSize - 1) len = bufSize - 1;
+  memcpy(buf, p, len);
+  buf[len] = '\0';
+  return len;
+}
@@ -0,0 +1,20 @@
+/**
+ * 定点浮点数格式化（替代 snprintf("%.1f")）
+ *
+ * 输出与 snprintf(buf, size, "%.*f", decimals, value) 完全一致
+ * （包括恰好一半时的"四舍六入五成双"和 -0.0 的负号），
+ * 但在 0~4 位小数时只使用整数运算和一张10的幂查找表，不调用libc printf。
+ * NaN/Inf、超大数值或超过4位小数时回退到 snprintf。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLOAT_FORMAT_MAX_DECIMALS 4    // 整数快速路径支持的最大小数位数
+
+/**
+ * 将浮点数按固定小数位格式化到缓冲区
+ * 返回写入的字符数（不含结尾的'\0'），缓冲区不足时截断
+ */
+size_t formatFloatFixed(char* buf, size_t bufSize, float value, uint8_t decimals);
@@ -0,0 +1,91 @@
+#include "MetricsBuffer.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <FloatFormat.h>
+
+MetricsBuffer::MetricsBuffer(char* buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {
+  if(capacity_ > 0) buffer_[0] = '\0';
+}
+
+bool MetricsBuffer::append_(const char* text) {
+  size_t len = strlen(text);
+  if(length_ + len + 1 > capacity_) return false;
+  memcpy(buffer_ + length_, text, len + 1);
+  length_ += len;
+  return true;
+}
+
+int MetricsBuffer::addMetric(const char* name, const char* help, const char* labels) {
+  if(slotCount_ >= METRICS_MAX_SLOTS) return -1;
+  size_t start = length_;
+
+  // 同名指标只输出一次HELP/TYPE
+  bool newFamily = (lastName_ == nullptr || strcmp(lastName_, name) != 0);
+  bool ok = true;
+  if(newFamily) {
+    ok = append_("# HELP ") && append_(name) && append_(" ") && append_(help) &&
+         append_("\n# TYPE ") && append_(name) && append_(" gauge\n");
+  }
+  ok = ok && append_(name);
+  if(labels != nullptr) ok = ok && append_(labels);
+
+  // 预留数值槽位，初始为NaN
+  size_t slotStart = length_;
+  if(!ok || length_ + METRICS_VALUE_WIDTH + 2 > capacity_ || slotStart > UINT16_MAX) {
+    length_ = start;  // 空间不足，撤销本条
+    buffer_[length_] = '\0';
+    return -1;
+  }
+  memset(buffer_ + length_, ' ', METRICS_VALUE_WIDTH);
+  length_ += METRICS_VALUE_WIDTH;
+  buffer_[length_++] = '\n';
+  buffer_[length_] = '\0';
+
+  lastName_ = name;
+  int slot = slotCount_++;
+  slotOffset_[slot] = (uint16_t)slotStart;
+  writeSlot_(slot, "NaN", 3);
+  return slot;
+}
+
+void MetricsBuffer::writeSlot_(int slot, const char* value, size_t len) {
+  if(len > METRICS_VALUE_WIDTH) {
+    value = "NaN";
+    len = 3;
+  }
+  char* p = buffer_ + slotOffset_[slot];
+  size_t pad = METRICS_VALUE_WIDTH - len;
+  memset(p, ' ', pad);
+  memcpy(p + pad, value, len);
+}
+
+bool MetricsBuffer::setFloat(int slot, float value, uint8_t decimals) {
+  if(slot < 0 || slot >= slotCount_) return false;
+  if(isnan(value)) {
+    writeSlot_(slot, "NaN", 3);
+  } else if(isinf(value)) {
+    writeSlot_(slot, value > 0 ? "+Inf" : "-Inf", 4);
+  } else {
+    char buf[32];
+    size_t len = formatFloatFixed(buf, sizeof(buf), value, decimals);
+    writeSlot_(slot, buf, len < sizeof(buf) ? len : sizeof(buf));
+  }
+  return true;
+}
+
+bool MetricsBuffer::setInt(int slot, int32_t value) {
+  if(slot < 0 || slot >= slotCount_) return false;
+  // 从后往前写十进制数字
+  char buf[12];
+  char* p = buf + sizeof(buf);
+  uint32_t magnitude = value < 0 ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+  do {
+    *--p = (char)('0' + magnitude % 10);
+    magnitude /= 10;
+  } while(magnitude != 0);
+  if(value < 0) *--p = '-';
+  writeSlot_(slot, p, buf + sizeof(buf) - p);
+  return true;
+}
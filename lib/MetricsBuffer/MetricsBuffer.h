@@ -0,0 +1,52 @@
+/**
+ * 预渲染的Prometheus文本指标缓冲区（/metrics）
+ *
+ * 启动时把所有指标（HELP/TYPE/名称/标签）一次性写入缓冲区，
+ * 每个数值占用固定宽度、右对齐的槽位：
+ * - 数值更新时只改写自己的槽位，不重新生成整个文档
+ * - 采集请求直接一次性发送缓冲区，开销与指标数量无关
+ * 槽位前的空格是Prometheus文本格式允许的分隔空白。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_VALUE_WIDTH 14     // 数值槽位宽度（字符）
+#define METRICS_MAX_SLOTS 256      // 最大指标条目数
+
+class MetricsBuffer {
+ public:
+  /**
+   * 使用外部预分配的缓冲区（避免内存碎片）
+   */
+  MetricsBuffer(char* buffer, size_t capacity);
+
+  /**
+   * 添加一条gauge指标，返回槽位编号；缓冲区或槽位不足时返回-1
+   * 与上一条同名的指标共用HELP/TYPE行（同一指标的多个标签组合）
+   * labels为完整的标签部分，例如 "{sensor=\"aht20\"}"，可为nullptr
+   */
+  int addMetric(const char* name, const char* help, const char* labels = nullptr);
+
+  /**
+   * 更新槽位数值：浮点数按固定小数位，整数直接输出；NaN输出为"NaN"
+   */
+  bool setFloat(int slot, float value, uint8_t decimals);
+  bool setInt(int slot, int32_t value);
+
+  const char* c_str() const { return buffer_; }
+  size_t size() const { return length_; }
+  int slotCount() const { return slotCount_; }
+
+ private:
+  bool append_(const char* text);
+  void writeSlot_(int slot, const char* value, size_t len);
+
+  char* buffer_;
+  size_t capacity_;
+  size_t length_ = 0;
+  const char* lastName_ = nullptr;
+  uint16_t slotOffset_[METRICS_MAX_SLOTS];
+  int slotCount_ = 0;
+};
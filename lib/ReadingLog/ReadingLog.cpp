@@ -0,0 +1,284 @@
+#include "ReadingLog.h"
+
+#include <math.h>
+#include <string.h>
+
+#define READING_LOG_MAGIC 0x31474C52u     // "RLG1"（小端序）
+#define READING_LOG_WRITTEN 0x5A
+#define READING_LOG_UNSENT 0xFF
+#define READING_LOG_SENT 0x00
+#define READING_LOG_SCAN_RECORDS 20      // 挂载扫描时每次读取的记录数（栈上240字节）
+
+#if defined(ESP_PLATFORM)
+bool PartitionLogFlash::open(esp_partition_subtype_t subtype) {
+  partition_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, subtype, nullptr);
+  size_ = partition_ == nullptr ? 0 : (partition_->size < maxBytes_ ? partition_->size : maxBytes_);
+  return partition_ != nullptr;
+}
+
+bool PartitionLogFlash::read(size_t offset, void* data, size_t len) {
+  return esp_partition_read(partition_, offset, data, len) == ESP_OK;
+}
+
+bool PartitionLogFlash::write(size_t offset, const void* data, size_t len) {
+  return esp_partition_write(partition_, offset, data, len) == ESP_OK;
+}
+
+bool PartitionLogFlash::eraseSector(size_t offset) {
+  return esp_partition_erase_range(partition_, offset, READING_LOG_SECTOR_SIZE) == ESP_OK;
+}
+#endif
+
+static void putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+uint8_t ReadingLog::crc8_(const uint8_t* data, size_t len) {
+  uint8_t crc = 0;
+  for(size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for(int bit = 0; bit < 8; bit++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+size_t ReadingLog::slotOffset_(const Cursor& cursor) {
+  return (size_t)cursor.sector * READING_LOG_SECTOR_SIZE + READING_LOG_HEADER_SIZE +
+         (size_t)cursor.slot * READING_LOG_RECORD_SIZE;
+}
+
+void ReadingLog::encode_(uint8_t* record, const LoggedReading& reading) {
+  int16_t temp = INT16_MIN;  // NaN
+  if(!isnan(reading.temperature)) {
+    float t = roundf(reading.temperature * 100.0f);
+    temp = (int16_t)(t < -32767.0f ? -32767.0f : t > 32767.0f ? 32767.0f : t);
+  }
+  uint16_t hum = UINT16_MAX;  // NaN
+  if(!isnan(reading.humidity)) {
+    float h = roundf(reading.humidity * 100.0f);
+    hum = (uint16_t)(h < 0.0f ? 0.0f : h > 65534.0f ? 65534.0f : h);
+  }
+  putU32(record, reading.utc);
+  record[4] = (uint8_t)temp;
+  record[5] = (uint8_t)((uint16_t)temp >> 8);
+  record[6] = (uint8_t)hum;
+  record[7] = (uint8_t)(hum >> 8);
+  record[8] = reading.flags;
+  record[9] = crc8_(record, 9);
+  record[10] = READING_LOG_WRITTEN;
+  record[11] = READING_LOG_UNSENT;
+}
+
+void ReadingLog::decode_(const uint8_t* record, LoggedReading& reading) {
+  int16_t temp = (int16_t)(record[4] | record[5] << 8);
+  uint16_t hum = (uint16_t)(record[6] | record[7] << 8);
+  reading.utc = getU32(record);
+  reading.temperature = temp == INT16_MIN ? NAN : temp / 100.0f;
+  reading.humidity = hum == UINT16_MAX ? NAN : hum / 100.0f;
+  reading.flags = record[8];
+}
+
+bool ReadingLog::isUnsent_(const uint8_t* record) const {
+  return record[10] == READING_LOG_WRITTEN && record[11] == READING_LOG_UNSENT && crc8_(record, 9) == record[9];
+}
+
+uint32_t ReadingLog::countUnsent_(uint16_t sector, uint16_t fromSlot, uint16_t toSlot) {
+  uint8_t chunk[READING_LOG_SCAN_RECORDS * READING_LOG_RECORD_SIZE];
+  uint32_t count = 0;
+  for(uint16_t slot = fromSlot; slot < toSlot; slot += READING_LOG_SCAN_RECORDS) {
+    uint16_t n = toSlot - slot < READING_LOG_SCAN_RECORDS ? toSlot - slot : READING_LOG_SCAN_RECORDS;
+    Cursor at = {sector, slot};
+    if(!flash_.read(slotOffset_(at), chunk, n * READING_LOG_RECORD_SIZE)) break;
+    for(uint16_t i = 0; i < n; i++) {
+      if(isUnsent_(chunk + i * READING_LOG_RECORD_SIZE)) count++;
+    }
+  }
+  return count;
+}
+
+bool ReadingLog::begin() {
+  size_t sectors = flash_.size() / READING_LOG_SECTOR_SIZE;
+  sectorCount_ = (uint16_t)(sectors < READING_LOG_MAX_SECTORS ? sectors : READING_LOG_MAX_SECTORS);
+  if(sectorCount_ < 2) return false;
+
+  // 找到序号最大的扇区（写入端），再沿环向前找连续递减的序号确定最旧的扇区
+  uint32_t seqs[READING_LOG_MAX_SECTORS];
+  bool valid[READING_LOG_MAX_SECTORS];
+  int head = -1;
+  for(uint16_t s = 0; s < sectorCount_; s++) {
+    uint8_t header[READING_LOG_HEADER_SIZE];
+    if(!flash_.read((size_t)s * READING_LOG_SECTOR_SIZE, header, sizeof(header))) return false;
+    seqs[s] = getU32(header + 4);
+    valid[s] = getU32(header) == READING_LOG_MAGIC && seqs[s] != 0xFFFFFFFFu;
+    if(valid[s] && (head < 0 || seqs[s] > seqs[head])) head = s;
+  }
+  mounted_ = true;
+  pending_ = 0;
+  if(head < 0) {
+    empty_ = true;
+    write_ = read_ = {0, 0};
+    return true;
+  }
+  empty_ = false;
+  headSeq_ = seqs[head];
+  tailSector_ = (uint16_t)head;
+  for(uint16_t i = 1; i < sectorCount_; i++) {
+    uint16_t prev = (uint16_t)((head + sectorCount_ - i) % sectorCount_);
+    if(!valid[prev] || seqs[prev] != headSeq_ - i) break;
+    tailSector_ = prev;
+  }
+
+  // 写入端：第一个全为0xFF的记录槽
+  write_ = {(uint16_t)head, (uint16_t)READING_LOG_RECORDS_PER_SECTOR};
+  uint8_t record[READING_LOG_RECORD_SIZE];
+  for(uint16_t slot = 0; slot < READING_LOG_RECORDS_PER_SECTOR; slot++) {
+    Cursor at = {(uint16_t)head, slot};
+    if(!flash_.read(slotOffset_(at), record, sizeof(record))) return false;
+    bool erased = true;
+    for(size_t i = 0; i < READING_LOG_RECORD_SIZE - 1 && erased; i++) erased = record[i] == 0xFF;
+    if(erased) {
+      write_.slot = slot;
+      break;
+    }
+  }
+
+  // 重放位置：从最旧的扇区开始第一个含未发送记录的扇区
+  read_ = write_;
+  bool found = false;
+  for(uint16_t s = tailSector_;; s = (uint16_t)((s + 1) % sectorCount_)) {
+    uint16_t end = s == write_.sector ? write_.slot : (uint16_t)READING_LOG_RECORDS_PER_SECTOR;
+    uint32_t unsent = countUnsent_(s, 0, end);
+    if(unsent > 0 && !found) {
+      read_ = {s, 0};
+      found = true;
+    }
+    pending_ += unsent;
+    if(s == write_.sector) break;
+  }
+  return true;
+}
+
+bool ReadingLog::startSector_(uint16_t sector) {
+  size_t base = (size_t)sector * READING_LOG_SECTOR_SIZE;
+  stats_.sectorErases++;
+  if(!flash_.eraseSector(base)) return false;
+  uint8_t header[READING_LOG_HEADER_SIZE];
+  putU32(header, READING_LOG_MAGIC);
+  putU32(header + 4, headSeq_ + 1);
+  stats_.bytesProgrammed += sizeof(header);
+  if(!flash_.write(base, header, sizeof(header))) return false;
+  headSeq_++;
+  write_ = {sector, 0};
+  return true;
+}
+
+bool ReadingLog::append(const LoggedReading& reading) {
+  if(!mounted_) return false;
+  if(empty_) {
+    headSeq_ = 0;
+    if(!startSector_(0)) return false;
+    tailSector_ = 0;
+    read_ = write_;
+    empty_ = false;
+  } else if(write_.slot >= READING_LOG_RECORDS_PER_SECTOR) {
+    uint16_t next = (uint16_t)((write_.sector + 1) % sectorCount_);
+    if(next == tailSector_) {
+      // 日志已满：擦除最旧的扇区，其中未发送的读数丢失
+      if(read_.sector == tailSector_) {
+        uint32_t lost = countUnsent_(tailSector_, read_.slot, READING_LOG_RECORDS_PER_SECTOR);
+        stats_.overwritten += lost;
+        pending_ -= lost;
+        read_ = {(uint16_t)((tailSector_ + 1) % sectorCount_), 0};
+      }
+      tailSector_ = (uint16_t)((tailSector_ + 1) % sectorCount_);
+    }
+    if(!startSector_(next)) return false;
+  }
+
+  uint8_t record[READING_LOG_RECORD_SIZE];
+  encode_(record, reading);
+  Cursor at = write_;
+  write_.slot++;  // 写入失败也不复用这个槽位
+  // 状态字节保持擦除值，标记已发送时再写
+  stats_.bytesProgrammed += READING_LOG_RECORD_SIZE - 1;
+  if(!flash_.write(slotOffset_(at), record, READING_LOG_RECORD_SIZE - 1)) return false;
+  stats_.appended++;
+  pending_++;
+  return true;
+}
+
+bool ReadingLog::advance_(Cursor& cursor) const {
+  if(cursor.slot >= READING_LOG_RECORDS_PER_SECTOR) {
+    if(cursor.sector == write_.sector) return false;
+    cursor.sector = (uint16_t)((cursor.sector + 1) % sectorCount_);
+    cursor.slot = 0;
+  }
+  return !(cursor.sector == write_.sector && cursor.slot >= write_.slot);
+}
+
+uint32_t ReadingLog::position_(const Cursor& cursor) const {
+  // 写入扇区的序号是headSeq_，之前的扇区序号依次减一
+  uint16_t behind = (uint16_t)((write_.sector + sectorCount_ - cursor.sector) % sectorCount_);
+  return (headSeq_ - behind) * READING_LOG_RECORDS_PER_SECTOR + cursor.slot;
+}
+
+size_t ReadingLog::peek(LoggedReading* out, size_t max, ReadingLogRange* range) {
+  size_t count = 0;
+  Cursor cursor = read_;
+  uint8_t record[READING_LOG_RECORD_SIZE];
+  if(range) range->begin = range->end = position_(cursor);
+  while(count < max && pending_ > count && advance_(cursor)) {
+    if(flash_.read(slotOffset_(cursor), record, sizeof(record)) && isUnsent_(record)) {
+      decode_(record, out[count++]);
+      if(range) range->end = position_(cursor) + 1;
+    }
+    cursor.slot++;
+  }
+  return count;
+}
+
+void ReadingLog::consume(const ReadingLogRange& range) {
+  static const uint8_t SENT = READING_LOG_SENT;
+  uint8_t record[READING_LOG_RECORD_SIZE];
+  // 从重放位置开始：范围开头若已被擦除，这里已经是仍在日志中的最旧记录
+  Cursor cursor = read_;
+  bool prefix = true;  // 重放位置只能越过连续的已发送/无效记录
+  while(pending_ > 0 && advance_(cursor)) {
+    uint32_t at = position_(cursor);
+    if(at >= range.end) break;
+    if(flash_.read(slotOffset_(cursor), record, sizeof(record)) && isUnsent_(record)) {
+      if(at >= range.begin) {
+        flash_.write(slotOffset_(cursor) + READING_LOG_RECORD_SIZE - 1, &SENT, 1);
+        stats_.bytesProgrammed++;
+        stats_.replayed++;
+        pending_--;
+      } else {
+        prefix = false;
+      }
+    }
+    cursor.slot++;
+    if(prefix) read_ = cursor;
+  }
+}
+
+void ReadingLog::consume(size_t count) {
+  static const uint8_t SENT = READING_LOG_SENT;
+  uint8_t record[READING_LOG_RECORD_SIZE];
+  while(count > 0 && pending_ > 0 && advance_(read_)) {
+    if(flash_.read(slotOffset_(read_), record, sizeof(record)) && isUnsent_(record)) {
+      flash_.write(slotOffset_(read_) + READING_LOG_RECORD_SIZE - 1, &SENT, 1);
+      stats_.bytesProgrammed++;
+      stats_.replayed++;
+      pending_--;
+      count--;
+    }
+    read_.slot++;
+  }
+}
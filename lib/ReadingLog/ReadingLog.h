@@ -0,0 +1,152 @@
+/**
+ * 闪存中的只追加读数日志（MQTT离线时的存储转发队列）
+ *
+ * 代理或WiFi不可用时，每条读数以12字节二进制记录追加到闪存分区；
+ * 连接恢复后按批读出，带原始时间戳重放，代理确认后才标记为已发送。
+ * - 分区按4KB扇区组成环形日志，扇区按序号轮流使用，只有写满一圈才擦除最旧的扇区，
+ *   每个扇区的擦除次数相同（磨损均衡），未发送的最旧读数在此时被覆盖
+ * - 记录写入后不再移动；"已发送"只把状态字节从0xFF写成0x00（NOR闪存只清零位，无需擦除）
+ * - 记录带CRC8，断电造成的半条记录在挂载时被跳过；重启后从第一条未发送记录继续重放
+ *
+ * 扇区布局：8字节扇区头（魔数"RLG1" + uint32序号），随后是340条记录。
+ * 记录布局（小端序，12字节）：
+ *   0  uint32 UTC时间（秒）
+ *   4  int16  温度（0.01摄氏度）
+ *   6  uint16 湿度（0.01%）
+ *   8  uint8  标志位（bit0 PIR有人）
+ *   9  uint8  CRC8（字节0~8）
+ *   10 uint8  写入标记0x5A
+ *   11 uint8  状态：0xFF未发送，0x00已发送
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define READING_LOG_SECTOR_SIZE 4096
+#define READING_LOG_RECORD_SIZE 12
+#define READING_LOG_HEADER_SIZE 8
+#define READING_LOG_RECORDS_PER_SECTOR ((READING_LOG_SECTOR_SIZE - READING_LOG_HEADER_SIZE) / READING_LOG_RECORD_SIZE)
+#define READING_LOG_MAX_SECTORS 64           // 最多使用的扇区数（256KB）
+
+/**
+ * 闪存区域接口（NOR语义：写入只能把1变成0，擦除把整个扇区恢复为0xFF）
+ */
+class LogFlash {
+ public:
+  virtual ~LogFlash() = default;
+  virtual size_t size() const = 0;
+  virtual bool read(size_t offset, void* data, size_t len) = 0;
+  virtual bool write(size_t offset, const void* data, size_t len) = 0;
+  virtual bool eraseSector(size_t offset) = 0;
+};
+
+#if defined(ESP_PLATFORM)
+#include <esp_partition.h>
+
+/**
+ * ESP32数据分区（例如partitions.csv中的spiffs分区），只使用前maxBytes字节
+ */
+class PartitionLogFlash : public LogFlash {
+ public:
+  explicit PartitionLogFlash(size_t maxBytes = 0xF000) : maxBytes_(maxBytes) {}
+  /** 查找第一个指定子类型的数据分区，找不到时返回false */
+  bool open(esp_partition_subtype_t subtype = ESP_PARTITION_SUBTYPE_DATA_SPIFFS);
+  size_t size() const override { return size_; }
+  bool read(size_t offset, void* data, size_t len) override;
+  bool write(size_t offset, const void* data, size_t len) override;
+  bool eraseSector(size_t offset) override;
+
+ private:
+  const esp_partition_t* partition_ = nullptr;
+  size_t maxBytes_;
+  size_t size_ = 0;
+};
+#endif
+
+// 一条读数
+struct LoggedReading {
+  uint32_t utc = 0;
+  float temperature = 0.0f;
+  float humidity = 0.0f;
+  uint8_t flags = 0;
+};
+
+// 一批读数在日志中的位置：[begin, end)为记录序号（扇区序号×每扇区记录数+槽位），写满一圈也不会重复
+struct ReadingLogRange {
+  uint32_t begin = 0;
+  uint32_t end = 0;
+};
+
+// 运行统计（本次启动以来）
+struct ReadingLogStats {
+  uint32_t appended = 0;        // 追加的记录
+  uint32_t replayed = 0;        // 确认发送的记录
+  uint32_t overwritten = 0;     // 未发送就被擦除覆盖的记录
+  uint32_t bytesProgrammed = 0; // 写入闪存的字节（记录+状态字节+扇区头）
+  uint32_t sectorErases = 0;
+};
+
+class ReadingLog {
+ public:
+  explicit ReadingLog(LogFlash& flash) : flash_(flash) {}
+
+  /**
+   * 挂载：扫描扇区头和记录，恢复写入位置和重放位置
+   * 区域中不属于日志的旧数据（例如SPIFFS）在扇区首次使用时擦除
+   * 返回false表示闪存区域不足两个扇区或读取失败
+   */
+  bool begin();
+
+  /** 追加一条读数；日志已满时擦除最旧的扇区 */
+  bool append(const LoggedReading& reading);
+
+  /**
+   * 从最旧的未发送记录开始读出最多max条，不改变重放位置
+   * range非空时返回这批读数所在的位置范围，确认后交给consume(range)
+   */
+  size_t peek(LoggedReading* out, size_t max, ReadingLogRange* range = nullptr);
+
+  /**
+   * 把最早的count条未发送记录标记为已发送
+   * 只适用于peek之后没有追加过记录的情况；追加可能擦除最旧的扇区，最早的记录就不再是peek读出的那些
+   */
+  void consume(size_t count);
+
+  /**
+   * 把peek返回的范围内仍未发送的记录标记为已发送（在代理确认后调用）
+   * 其间写满一圈被擦除的记录已计入overwritten，范围之后新追加的记录不受影响
+   */
+  void consume(const ReadingLogRange& range);
+
+  uint32_t pending() const { return pending_; }
+  uint32_t capacity() const { return (uint32_t)sectorCount_ * READING_LOG_RECORDS_PER_SECTOR; }
+  const ReadingLogStats& stats() const { return stats_; }
+
+ private:
+  struct Cursor {
+    uint16_t sector;
+    uint16_t slot;
+  };
+
+  static size_t slotOffset_(const Cursor& cursor);
+  static uint8_t crc8_(const uint8_t* data, size_t len);
+  static void encode_(uint8_t* record, const LoggedReading& reading);
+  static void decode_(const uint8_t* record, LoggedReading& reading);
+  bool isUnsent_(const uint8_t* record) const;
+  bool startSector_(uint16_t sector);
+  bool advance_(Cursor& cursor) const;
+  uint32_t position_(const Cursor& cursor) const;
+  uint32_t countUnsent_(uint16_t sector, uint16_t fromSlot, uint16_t toSlot);
+
+  LogFlash& flash_;
+  uint16_t sectorCount_ = 0;
+  bool mounted_ = false;
+  bool empty_ = true;         // 还没有任何扇区属于日志
+  uint32_t headSeq_ = 0;
+  uint16_t tailSector_ = 0;   // 最旧的扇区
+  Cursor write_ = {0, 0};     // 下一条记录的写入位置
+  Cursor read_ = {0, 0};      // 重放位置（此前的记录都已发送或无效）
+  uint32_t pending_ = 0;
+  ReadingLogStats stats_;
+};
@@ -0,0 +1,58 @@
+#include "SensorSnapshot.h"
+
+#include <string.h>
+
+// 小端序写入
+static inline void putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void putF32(uint8_t* p, float v) {
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  putU32(p, bits);
+}
+
+SensorSnapshot::SensorSnapshot() {
+  encode_(buffer_, SnapshotValues());
+}
+
+void SensorSnapshot::encode_(uint8_t* out, const SnapshotValues& values) {
+  memcpy(out, "SNAP", 4);
+  out[4] = SNAPSHOT_VERSION;
+  out[5] = values.flags;
+  out[6] = (uint8_t)values.rssi;
+  out[7] = 0;
+  putU32(out + 8, 0);                   // 序号由update()写入
+  putF32(out + 12, values.temperature);
+  putF32(out + 16, values.humidity);
+  putU32(out + 20, values.sensorUtc);
+  putU32(out + 24, values.sensorUptimeMs);
+  putU32(out + 28, values.motionUptimeMs);
+  putU32(out + 32, values.freeHeap);
+  putU32(out + 36, values.minFreeHeap);
+  putU16(out + 40, values.reconnectCount);
+  putU16(out + 42, values.bootCount);
+}
+
+bool SensorSnapshot::update(const SnapshotValues& values) {
+  uint8_t encoded[SNAPSHOT_SIZE];
+  encode_(encoded, values);
+
+  // 比较时跳过序号字段
+  if(memcmp(encoded, buffer_, 8) == 0 && memcmp(encoded + 12, buffer_ + 12, SNAPSHOT_SIZE - 12) == 0) {
+    return false;
+  }
+
+  memcpy(buffer_, encoded, SNAPSHOT_SIZE);
+  putU32(buffer_ + 8, ++sequence_);
+  return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * 紧凑二进制传感器快照（供NAS高频采集 /snapshot）
+ *
+ * 一次请求返回所有传感器值、时间戳、PIR状态和健康计数器。
+ * 快照预先编码在固定缓冲区中，只有数值变化时才重新编码，请求处理只需发送缓冲区。
+ *
+ * 布局（小端序，SNAPSHOT_VERSION = 1，共44字节）：
+ *   0  char[4] 魔数 "SNAP"
+ *   4  uint8   版本号
+ *   5  uint8   标志位：bit0 PIR有人，bit1 屏幕亮，bit2 WiFi已连接，bit3 MQTT已连接，bit4 时间已同步，bit5 数值来自热重启缓存
+ *   6  int8    WiFi信号强度RSSI（dBm）
+ *   7  uint8   保留
+ *   8  uint32  序号（内容每变化一次加1）
+ *   12 float32 温度（摄氏度）
+ *   16 float32 湿度（%）
+ *   20 uint32  最近一次传感器读取的UTC时间（秒，0表示时间未同步）
+ *   24 uint32  最近一次传感器读取时的运行时间（毫秒）
+ *   28 uint32  最后一次检测到人体时的运行时间（毫秒）
+ *   32 uint32  剩余堆内存（字节）
+ *   36 uint32  历史最小剩余堆内存（字节）
+ *   40 uint16  WiFi重连次数
+ *   42 uint16  启动次数
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_SIZE 44
+
+// 标志位
+#define SNAPSHOT_FLAG_PIR 0x01
+#define SNAPSHOT_FLAG_SCREEN_ON 0x02
+#define SNAPSHOT_FLAG_WIFI 0x04
+#define SNAPSHOT_FLAG_MQTT 0x08
+#define SNAPSHOT_FLAG_TIME_VALID 0x10
+#define SNAPSHOT_FLAG_CACHED 0x20
+
+// 快照中的各项数值
+struct SnapshotValues {
+  float temperature = 0.0f;
+  float humidity = 0.0f;
+  uint32_t sensorUtc = 0;
+  uint32_t sensorUptimeMs = 0;
+  uint32_t motionUptimeMs = 0;
+  uint32_t freeHeap = 0;
+  uint32_t minFreeHeap = 0;
+  int8_t rssi = 0;
+  uint8_t flags = 0;
+  uint16_t reconnectCount = 0;
+  uint16_t bootCount = 0;
+};
+
+class SensorSnapshot {
+ public:
+  SensorSnapshot();
+
+  /**
+   * 用新数值更新快照，只有内容变化时才改写缓冲区并增加序号
+   * 返回true表示快照内容发生变化
+   */
+  bool update(const SnapshotValues& values);
+
+  const uint8_t* data() const { return buffer_; }
+  size_t size() const { return SNAPSHOT_SIZE; }
+  uint32_t sequence() const { return sequence_; }
+
+ private:
+  static void encode_(uint8_t* out, const SnapshotValues& values);
+
+  uint8_t buffer_[SNAPSHOT_SIZE];
+  uint32_t sequence_ = 0;
+};
@@ -0,0 +1,115 @@
+#include "SoftClock.h"
+
+// 向下取整除法（负数也正确）
+static inline int64_t floorDiv(int64_t a, int64_t b) {
+  int64_t q = a / b;
+  return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+void SoftClock::setUtcOffset(int32_t offsetSec) {
+  transitionFrom_[0] = INT64_MIN;
+  transitionOffset_[0] = offsetSec;
+  transitionCount_ = 1;
+  cachedDay_ = INT64_MIN;
+}
+
+bool SoftClock::addTransition(int64_t fromUtc, int32_t offsetSec) {
+  if(transitionCount_ >= SOFT_CLOCK_MAX_TRANSITIONS) return false;
+  if(transitionCount_ > 0 && fromUtc <= transitionFrom_[transitionCount_ - 1]) return false;
+  transitionFrom_[transitionCount_] = fromUtc;
+  transitionOffset_[transitionCount_] = offsetSec;
+  transitionCount_++;
+  cachedDay_ = INT64_MIN;
+  return true;
+}
+
+void SoftClock::sync(int64_t utcUs, int64_t monoUs) {
+  if(valid_ && !seeded_) {
+    int64_t monoElapsed = monoUs - anchorMonoUs_;
+    if(monoElapsed >= SOFT_CLOCK_MIN_DRIFT_INTERVAL_US) {
+      // 只比较NTP时间与单调计时器，和上一次的漂移估算无关
+      int64_t utcElapsed = utcUs - anchorUtcUs_;
+      int64_t ppb = (utcElapsed - monoElapsed) * 1000000000LL / monoElapsed;
+      if(ppb >= -SOFT_CLOCK_MAX_DRIFT_PPM * 1000LL && ppb <= SOFT_CLOCK_MAX_DRIFT_PPM * 1000LL) {
+        // 指数平滑（新值权重1/2），首次估算直接采用
+        driftPpb_ = (syncCount_ <= 1) ? ppb : (driftPpb_ + ppb) / 2;
+      }
+    }
+  }
+  anchorUtcUs_ = utcUs;
+  anchorMonoUs_ = monoUs;
+  syncCount_++;
+  valid_ = true;
+  seeded_ = false;
+}
+
+void SoftClock::seed(int64_t utcUs, int64_t monoUs) {
+  anchorUtcUs_ = utcUs;
+  anchorMonoUs_ = monoUs;
+  valid_ = true;
+  seeded_ = true;
+}
+
+int64_t SoftClock::nowUtcUs(int64_t monoUs) const {
+  if(!valid_) return 0;
+  int64_t elapsed = monoUs - anchorMonoUs_;
+  // elapsed × ppb / 1e9 拆成两部分，避免长时间运行时乘法溢出
+  int64_t correction = (elapsed / 1000000) * driftPpb_ / 1000 + (elapsed % 1000000) * driftPpb_ / 1000000000LL;
+  return anchorUtcUs_ + elapsed + correction;
+}
+
+int64_t SoftClock::nowUtc(int64_t monoUs) const {
+  return floorDiv(nowUtcUs(monoUs), 1000000);
+}
+
+int32_t SoftClock::offsetAt_(int64_t utc) const {
+  if(transitionCount_ == 0) return 0;
+  // 表很小且通常只有一项，从后往前找第一个生效的条目
+  for(int i = transitionCount_ - 1; i > 0; i--) {
+    if(utc >= transitionFrom_[i]) return transitionOffset_[i];
+  }
+  return transitionOffset_[0];
+}
+
+bool SoftClock::localTime(int64_t monoUs, struct tm& out) {
+  if(!valid_) return false;
+  int64_t utc = nowUtc(monoUs);
+  int64_t local = utc + offsetAt_(utc);
+  int64_t day = floorDiv(local, 86400);
+  int32_t secOfDay = (int32_t)(local - day * 86400);
+
+  if(day != cachedDay_) {
+    civilFromDays_(day, cachedDate_);
+    cachedDay_ = day;
+  }
+  out = cachedDate_;
+  out.tm_hour = secOfDay / 3600;
+  out.tm_min = (secOfDay / 60) % 60;
+  out.tm_sec = secOfDay % 60;
+  out.tm_isdst = 0;
+  return true;
+}
+
+// 天数（相对1970-01-01）转换为年月日，算法见 Howard Hinnant "days_from_civil"
+void SoftClock::civilFromDays_(int64_t days, struct tm& out) {
+  int64_t z = days + 719468;
+  int64_t era = floorDiv(z, 146097);
+  int64_t doe = z - era * 146097;                                      // [0, 146096]
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+  int64_t year = yoe + era * 400;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                // 从3月1日起 [0, 365]
+  int64_t mp = (5 * doy + 2) / 153;                                     // [0, 11]
+  int mday = (int)(doy - (153 * mp + 2) / 5 + 1);
+  int mon = (int)(mp < 10 ? mp + 3 : mp - 9);                           // [1, 12]
+  if(mon <= 2) year++;
+
+  bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  static const uint16_t DAYS_BEFORE_MONTH[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+  out = {};
+  out.tm_year = (int)(year - 1900);
+  out.tm_mon = mon - 1;
+  out.tm_mday = mday;
+  out.tm_yday = DAYS_BEFORE_MONTH[mon - 1] + mday - 1 + ((leap && mon > 2) ? 1 : 0);
+  out.tm_wday = (int)(((days % 7) + 11) % 7);  // 1970-01-01是星期四
+}
@@ -0,0 +1,82 @@
+/**
+ * 漂移校正的单调软件时钟
+ *
+ * 每次NTP同步时把UTC时间锚定到单调计时器（esp_timer_get_time()，微秒），
+ * 之后的时间 = 锚点时间 + 单调计时器经过的时间 ×（1 + 漂移率）。
+ * - 连续两次同步之间比较NTP时间和单调计时器，估算晶振漂移（ppm）
+ * - 不依赖循环周期，不会像手动tm_sec++那样越走越慢，也能正确跨日/跨月/跨年
+ * - 本地时间分解不调用localtime()：时区偏移表只在配置时计算一次，
+ *   同一天内只做除法取时分秒，跨日才重新计算年月日
+ *
+ * 所有接口都显式传入单调时间戳，便于在测试中注入模拟漂移。
+ */
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#define SOFT_CLOCK_MAX_TRANSITIONS 8          // 时区偏移表最大条目数
+#define SOFT_CLOCK_MAX_DRIFT_PPM 500          // 漂移估算上限（超出视为异常同步）
+#define SOFT_CLOCK_MIN_DRIFT_INTERVAL_US 600000000LL  // 两次同步间隔至少10分钟才用于估算漂移
+
+class SoftClock {
+ public:
+  /**
+   * 配置固定时区偏移（秒），例如东八区为 8 * 3600
+   */
+  void setUtcOffset(int32_t offsetSec);
+
+  /**
+   * 追加一条时区偏移变化（从UTC时间fromUtc起使用offsetSec），必须按时间顺序追加
+   * 返回false表示偏移表已满
+   */
+  bool addTransition(int64_t fromUtc, int32_t offsetSec);
+
+  /**
+   * NTP同步：把UTC时间（微秒）锚定到单调时间戳（微秒）
+   */
+  void sync(int64_t utcUs, int64_t monoUs);
+
+  /**
+   * 用估计的时间（例如热重启缓存推算的时间）预置锚点，使时钟立即可用
+   * 不计入同步次数，也不作为漂移估算的基准：之后的第一次sync()按首次同步处理
+   */
+  void seed(int64_t utcUs, int64_t monoUs);
+
+  bool isValid() const { return valid_; }
+
+  /**
+   * 当前UTC时间（微秒 / 秒），未同步时返回0
+   */
+  int64_t nowUtcUs(int64_t monoUs) const;
+  int64_t nowUtc(int64_t monoUs) const;
+
+  /**
+   * 当前本地时间，未同步时返回false
+   */
+  bool localTime(int64_t monoUs, struct tm& out);
+
+  int32_t driftPpm() const { return (int32_t)(driftPpb_ / 1000); }  // 当前漂移估算（ppm）
+  int64_t driftPpb() const { return driftPpb_; }                     // 当前漂移估算（ppb）
+  uint32_t syncCount() const { return syncCount_; }                  // 同步次数
+
+ private:
+  int32_t offsetAt_(int64_t utc) const;
+  static void civilFromDays_(int64_t days, struct tm& out);
+
+  int64_t anchorUtcUs_ = 0;     // 最近一次同步的UTC时间
+  int64_t anchorMonoUs_ = 0;    // 最近一次同步时的单调时间
+  int64_t driftPpb_ = 0;        // 漂移率（十亿分之一），正值表示本地计时器偏慢
+  uint32_t syncCount_ = 0;
+  bool valid_ = false;
+  bool seeded_ = false;         // 锚点来自seed()而非NTP，不能用于估算漂移
+
+  // 时区偏移表：transitionFrom_[i]起使用transitionOffset_[i]
+  int64_t transitionFrom_[SOFT_CLOCK_MAX_TRANSITIONS] = {};
+  int32_t transitionOffset_[SOFT_CLOCK_MAX_TRANSITIONS] = {};
+  uint8_t transitionCount_ = 0;
+
+  // 本地日期缓存（同一天内不重复计算年月日）
+  int64_t cachedDay_ = INT64_MIN;
+  struct tm cachedDate_ = {};
+};
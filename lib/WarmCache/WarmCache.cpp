@@ -0,0 +1,85 @@
+#include "WarmCache.h"
+
+#include <stddef.h>
+#include <string.h>
+
+uint32_t WarmCache::crc32_(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for(size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for(int bit = 0; bit < 8; bit++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+  }
+  return ~crc;
+}
+
+uint32_t WarmCache::computeCrc_() const {
+  return crc32_((const uint8_t*)&data_, offsetof(WarmCacheData, crc));
+}
+
+void WarmCache::commit_() {
+  data_.crc = computeCrc_();
+}
+
+bool WarmCache::begin(bool coldBoot, int64_t nowUptimeUs) {
+  restored_ = !coldBoot && data_.magic == WARM_CACHE_MAGIC && data_.crc == computeCrc_();
+  if(!restored_) {
+    memset(&data_, 0, sizeof(data_));  // 包括结构体中的填充字节
+    data_.magic = WARM_CACHE_MAGIC;
+    commit_();
+    return false;
+  }
+
+  data_.warmBoots++;
+  if(has(WARM_CACHE_TIME)) {
+    // 复位时刻 = 锚点UTC + 复位前锚点之后已运行的时间；再把锚点移到本次启动的运行时间上
+    data_.anchorUtcUs += data_.uptimeUs - data_.anchorUptimeUs;
+    data_.anchorUptimeUs = 0;
+  }
+  data_.uptimeUs = nowUptimeUs;
+  commit_();
+  return true;
+}
+
+void WarmCache::setFlag(uint8_t flag, bool on) {
+  uint8_t flags = on ? (data_.flags | flag) : (data_.flags & ~flag);
+  if(flags == data_.flags) return;
+  data_.flags = flags;
+  commit_();
+}
+
+void WarmCache::saveReading(float temperature, float humidity) {
+  data_.temperature = temperature;
+  data_.humidity = humidity;
+  data_.flags |= WARM_CACHE_READING;
+  commit_();
+}
+
+void WarmCache::saveTime(int64_t utcUs, int64_t uptimeUs) {
+  data_.anchorUtcUs = utcUs;
+  data_.anchorUptimeUs = uptimeUs;
+  data_.uptimeUs = uptimeUs;
+  data_.flags |= WARM_CACHE_TIME;
+  commit_();
+}
+
+void WarmCache::touch(int64_t uptimeUs) {
+  data_.uptimeUs = uptimeUs;
+  commit_();
+}
+
+bool WarmCache::utcUs(int64_t uptimeUs, int64_t& out) const {
+  if(!has(WARM_CACHE_TIME)) return false;
+  out = data_.anchorUtcUs + (uptimeUs - data_.anchorUptimeUs);
+  return true;
+}
+
+void WarmCache::saveWiFi(const uint8_t* bssid, uint8_t channel) {
+  if(bssid == nullptr || channel == 0) {
+    setFlag(WARM_CACHE_WIFI, false);
+    return;
+  }
+  memcpy(data_.bssid, bssid, sizeof(data_.bssid));
+  data_.channel = channel;
+  data_.flags |= WARM_CACHE_WIFI;
+  commit_();
+}
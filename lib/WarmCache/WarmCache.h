@@ -0,0 +1,90 @@
+/**
+ * RTC内存中的热重启缓存
+ *
+ * 看门狗、panic和软件复位不会清除RTC慢速内存（上电复位后内容随机），
+ * 把最近的读数、时间锚点和网络状态放在这里，重启后几毫秒内就能显示和发布（标记为缓存值），
+ * 不必等AHT20、WiFi和NTP全部恢复。
+ * - 整块带CRC32：上电后的随机内容、版本变化、或复位恰好发生在更新中途，都会使CRC不匹配，整块丢弃（退化为冷启动）
+ * - 时间：保存NTP同步时的UTC和运行时间（锚点），并持续记录最近的运行时间；
+ *   复位后按"锚点UTC + 复位前已运行的时间"推算复位时刻，再接上本次启动的运行时间。
+ *   推算值偏慢，误差为最近一次touch()到复位之间的时间加上启动耗时：正常复位时约为一个循环周期，
+ *   任务看门狗复位前循环已卡住，可达看门狗超时（30秒）。NTP同步后即被替换
+ * - 所有更新都直接写RTC内存并重新计算CRC（约50字节），可以在每次循环中调用
+ *
+ * 所有时间戳都显式传入（esp_timer_get_time()，微秒），便于在测试中模拟复位。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WARM_CACHE_MAGIC 0x314D5257u      // "WRM1"（小端序），布局变化时修改版本号
+
+// 标志位
+#define WARM_CACHE_READING 0x01           // 温湿度有效
+#define WARM_CACHE_TIME 0x02              // 时间锚点有效
+#define WARM_CACHE_WIFI 0x04              // BSSID/信道有效
+#define WARM_CACHE_MQTT_DISCOVERED 0x08   // 已向代理发送过发现消息（保留消息）
+
+/**
+ * RTC内存中的数据块（用RTC_NOINIT_ATTR放置，启动时不初始化）
+ */
+struct WarmCacheData {
+  uint32_t magic;
+  uint32_t warmBoots;        // 上次冷启动以来的热重启次数
+  float temperature;
+  float humidity;
+  uint8_t flags;
+  uint8_t channel;
+  uint8_t bssid[6];
+  int64_t anchorUtcUs;       // 锚点UTC时间
+  int64_t anchorUptimeUs;    // 锚点对应的运行时间（本次启动）
+  int64_t uptimeUs;          // 最近一次记录的运行时间（本次启动）
+  uint32_t crc;              // 以上所有字节的CRC32
+};
+
+class WarmCache {
+ public:
+  explicit WarmCache(WarmCacheData& data) : data_(data) {}
+
+  /**
+   * 启动时调用一次：coldBoot为true（上电/外部复位）或内容无效时清空缓存
+   * 内容有效时把时间锚点接到本次启动的运行时间（nowUptimeUs）上，返回true
+   * （推算时间只是估计值，可能偏慢数十秒，不能当作NTP同步使用）
+   */
+  bool begin(bool coldBoot, int64_t nowUptimeUs);
+
+  /** begin()时缓存是否有效 */
+  bool restored() const { return restored_; }
+  uint32_t warmBoots() const { return data_.warmBoots; }
+
+  bool has(uint8_t flag) const { return (data_.flags & flag) != 0; }
+  void setFlag(uint8_t flag, bool on);
+
+  /** 保存最近一次读数 */
+  void saveReading(float temperature, float humidity);
+  float temperature() const { return data_.temperature; }
+  float humidity() const { return data_.humidity; }
+
+  /** NTP同步时保存锚点 */
+  void saveTime(int64_t utcUs, int64_t uptimeUs);
+
+  /** 记录当前运行时间（复位后据此推算复位时刻） */
+  void touch(int64_t uptimeUs);
+
+  /** 按锚点推算UTC时间（微秒），没有锚点时返回false */
+  bool utcUs(int64_t uptimeUs, int64_t& out) const;
+
+  /** 保存当前连接的AP，下次启动时直接关联（跳过扫描） */
+  void saveWiFi(const uint8_t* bssid, uint8_t channel);
+  const uint8_t* bssid() const { return data_.bssid; }
+  uint8_t channel() const { return data_.channel; }
+
+ private:
+  static uint32_t crc32_(const uint8_t* data, size_t len);
+  uint32_t computeCrc_() const;
+  void commit_();
+
+  WarmCacheData& data_;
+  bool restored_ = false;
+};
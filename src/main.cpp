@@ -28,10 +28,20 @@
 #include <Adafruit_AHTX0.h>            // AHT20温湿度传感器库（支持DHT20）
 #include <WiFi.h>                      // ESP32 WiFi功能库
 #include <WebServer.h>                 // ESP32 Web服务器库,用于创建HTTP服务器
-#include <PubSubClient.h>               // MQTT客户端库
 #include <time.h>                      // C标准时间库,用于时间处理
 #include <esp_task_wdt.h>              // ESP32看门狗库
 #include <esp_system.h>                // ESP32系统信息库
+#include <esp_timer.h>                 // ESP32单调微秒计时器（软件时钟的时间基准）
+#include <esp_sntp.h>                  // SNTP同步完成通知
+#include <FloatFormat.h>               // 定点浮点数格式化（替代snprintf("%.1f")）
+#include <ClockText.h>                 // 增量式时间/日期字符串（只改写变化的数字）
+#include <SoftClock.h>                 // 漂移校正的单调软件时钟
+#include <SensorSnapshot.h>            // 预编码的二进制传感器快照（/snapshot）
+#include <MetricsBuffer.h>             // 预渲染的Prometheus指标（/metrics）
+#include <AsyncMqtt.h>                 // 异步流水线MQTT客户端（有界队列+QoS1在途窗口）
+#include <ReadingLog.h>                // 闪存读数日志（MQTT离线时存储转发）
+#include <BootProfile.h>               // 启动阶段计时（/json）
+#include <WarmCache.h>                 // RTC内存热重启缓存（读数、时间锚点、AP）
 
 // ==================== 核心安全配置 ====================
 #define SERIAL_TIMEOUT_MS 50          // 串口写入超时
@@ -62,15 +72,30 @@ const char* mqtt_username = "homeassistant"; // MQTT用户名
 const char* mqtt_password = "homeassistant"; // MQTT密码
 const char* mqtt_client_id = "esp32-1306-monitor"; // MQTT客户端ID
 
-// 创建WiFi客户端和MQTT客户端
-WiFiClient espClient;
-PubSubClient mqttClient(espClient);
+const char* mqtt_availability_topic = "esp32-1306/availability"; // 在线状态主题（遗嘱）
+
+// 创建MQTT传输层和客户端（publish只入队，loop中合并写入，不阻塞主循环）
+MqttSocketTransport mqttTransport;
+AsyncMqttClient mqttClient(mqttTransport);
+
+// ==================== 离线读数存储转发 ====================
+// MQTT不可用时读数写入spiffs分区（前60KB，约5100条），连接恢复后按批带原始时间戳重放
+#define HISTORY_BATCH_SIZE 16                                  // 每条重放消息包含的读数
+const char* mqtt_history_topic = "esp32-1306/history";         // 重放主题：{"readings":[[utc,温度,湿度,PIR],...]}
+PartitionLogFlash readingFlash;
+ReadingLog readingLog(readingFlash);
+bool readingLogReady = false;
+uint16_t historyPacketId = 0;       // 正在等待PUBACK的重放消息（0表示没有）
+ReadingLogRange historyBatch;       // 该消息包含的读数在日志中的位置（确认前日志可能已写满一圈）
 
 // ==================== 预分配缓冲区（避免内存碎片）====================
 #define HTML_BUFFER_SIZE 4096        // HTML响应缓冲区大小
 #define JSON_BUFFER_SIZE 512         // JSON响应缓冲区大小
+#define METRICS_BUFFER_SIZE 2048     // Prometheus指标缓冲区大小
 char htmlBuffer[HTML_BUFFER_SIZE];   // 预分配HTML缓冲区
 char jsonBuffer[JSON_BUFFER_SIZE];   // 预分配JSON缓冲区
+char metricsText[METRICS_BUFFER_SIZE];  // 预分配指标缓冲区
+MetricsBuffer metrics(metricsText, METRICS_BUFFER_SIZE);
 
 // ==================== WiFi配置 ====================
 // 注意：请修改为您的WiFi网络名称和密码
@@ -99,11 +124,20 @@ const float humOffset = +3.0;        // 湿度校准偏移值：测量值偏低
 // ==================== 全局变量 ====================
 float currentTemperature = 0.0;          // 存储当前温度值（供Web服务器使用）
 float currentHumidity = 0.0;             // 存储当前湿度值（供Web服务器使用）
-char currentTime[32] = "";                // 存储当前时间字符串
-char currentDate[32] = "";               // 存储当前日期字符串
+ClockText clockText;                     // 当前时间/日期字符串（"HH:MM:SS"/"YYYY-MM-DD"，按秒增量更新）
 bool firstDataReady = false;             // 标记是否已获取到第一组数据
-struct tm lastValidTime;             // 存储最后一次有效时间（用于NTP失败时fallback）
-bool hasValidTime = false;           // 标记是否有有效时间
+SoftClock softClock;                     // 软件时钟：NTP同步时锚定到esp_timer，之间按漂移校正推算
+SensorSnapshot sensorSnapshot;           // 二进制快照缓冲区（数值变化时才重新编码）
+uint32_t lastSensorUtc = 0;              // 最近一次传感器读取的UTC时间（秒）
+unsigned long lastSensorMillis = 0;      // 最近一次传感器读取时的millis()
+
+// ==================== 热重启缓存 ====================
+// 看门狗/软件复位后立即恢复上次的读数和时间（标记为缓存值），直到重新读取/NTP同步；上电/外部复位时丢弃
+RTC_NOINIT_ATTR WarmCacheData warmCacheData;  // 启动时不初始化，有效性由CRC判断
+WarmCache warmCache(warmCacheData);
+bool readingsCached = false;             // 当前温湿度来自缓存，AHT20尚未重新读取
+bool timeCached = false;                 // 软件时钟来自缓存，尚未NTP同步
+bool skipDiscoveryOnce = false;          // 发现消息（保留）已在代理上，热重启后首次连接不再重发
 
 // ==================== HC-SR501人体红外感应配置 ====================
 #define PIR_SENSOR_PIN 13              // PIR传感器连接的GPIO引脚
@@ -116,6 +150,20 @@ bool lastPirState = false;            // 上次PIR传感器状态
 int sensorUpdateCounter = 0;             // 传感器更新计数器
 const int sensorUpdateInterval = 5;       // 传感器更新间隔（5次loop=5秒）
 
+// ==================== 启动流水线 ====================
+// WiFi关联在后台进行的同时初始化显示屏和传感器，各阶段耗时在/json的"boot"字段中
+#define AHT20_WARMUP_MS 500                   // AHT20上电后首次读取前的预热时间
+enum SensorInitState : uint8_t { SENSOR_INITIALIZING, SENSOR_READY, SENSOR_FAILED };
+volatile SensorInitState sensorState = SENSOR_INITIALIZING;  // 由传感器初始化任务写入
+volatile bool wifiAnnouncePending = false;   // 获得IP后由主循环输出一次地址
+BootProfile bootProfile;
+int bootPhaseSetup = -1;
+int bootPhaseDisplay = -1;
+int bootPhaseSensor = -1;
+int bootPhaseWifi = -1;
+int bootPhaseNtp = -1;
+int bootPhaseMqtt = -1;
+
 // ==================== 安全串口输出函数 ====================
 /**
  * 安全的串口输出函数，避免USB断开时阻塞
@@ -157,44 +205,38 @@ const char* resetReasonToString(esp_reset_reason_t reason) {
 
 // 函数声明
 void sendMQTTDiscovery();
+void onMQTTConnected();
+void onMQTTAcked(uint16_t packetId);
+void publishSensorData();
 
 /**
- * 连接到MQTT代理服务器
+ * 配置MQTT客户端（连接由mqttClient.loop()非阻塞地建立和维护）
+ * - 遗嘱：断线时代理发布 esp32-1306/availability = offline（保留）
+ * - 每次连接成功后客户端自动发布 online，并重新发送发现消息
  */
-void connectMQTT() {
-  // 等待WiFi连接
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
-  }
-  
-  // 设置MQTT服务器
+void setupMQTT() {
   mqttClient.setServer(mqtt_server, mqtt_port);
-  
-  // 增加缓冲区大小到512字节，容纳发现消息
-  mqttClient.setBufferSize(512);
-  Serial.println("Buffer size set to 512 bytes");
-  
-  // 尝试连接MQTT（使用匿名连接）
-  Serial.print("Connecting to MQTT...");
-  if (mqttClient.connect(mqtt_client_id)) {
-    Serial.println(" connected!");
-    
-    // 发布设备在线状态
-    Serial.println("Publishing availability message...");
-    if (mqttClient.publish("esp32-1306/availability", "online", true)) {
-      Serial.println("Availability message published successfully");
-    } else {
-      Serial.println("Failed to publish availability message");
-    }
-    
-    // 发送MQTT发现消息
-    Serial.println("Sending MQTT discovery messages...");
-    sendMQTTDiscovery();
+  mqttClient.setCredentials(mqtt_client_id);  // 匿名连接
+  mqttClient.setAvailability(mqtt_availability_topic);
+  mqttClient.onConnect(onMQTTConnected);
+  mqttClient.onAcked(onMQTTAcked);
+  Serial.println("MQTT client configured, connecting in background");
+}
+
+/**
+ * MQTT会话建立（收到CONNACK）：记录启动耗时并重新发送发现消息
+ * 热重启后的首次连接跳过发现消息，并立即发布缓存的读数（esp32-1306/cached = true）
+ */
+void onMQTTConnected() {
+  bootProfile.end(bootPhaseMqtt, millis());
+  if (skipDiscoveryOnce) {
+    skipDiscoveryOnce = false;
+    Serial.println("Warm restart: discovery already retained on broker, skipped");
   } else {
-    Serial.print(" failed, rc=");
-    Serial.println(mqttClient.state());
+    sendMQTTDiscovery();
+    warmCache.setFlag(WARM_CACHE_MQTT_DISCOVERED, true);
   }
+  if (readingsCached) publishSensorData();
 }
 
 /**
@@ -222,10 +264,10 @@ void sendMQTTDiscovery() {
   tempDiscovery += "}";
   Serial.print("Temperature discovery: ");
   Serial.println(tempDiscovery);
-  if (mqttClient.publish("homeassistant/sensor/esp32_1306_temperature/config", tempDiscovery.c_str(), true)) {
-    Serial.println("Temperature discovery message published successfully");
+  if (mqttClient.publish("homeassistant/sensor/esp32_1306_temperature/config", tempDiscovery.c_str(), true, 1)) {
+    Serial.println("Temperature discovery message queued");
   } else {
-    Serial.println("Failed to publish temperature discovery message");
+    Serial.println("Failed to queue temperature discovery message");
   }
   
   // 湿度传感器发现
@@ -247,10 +289,10 @@ void sendMQTTDiscovery() {
   humDiscovery += "}";
   Serial.print("Humidity discovery: ");
   Serial.println(humDiscovery);
-  if (mqttClient.publish("homeassistant/sensor/esp32_1306_humidity/config", humDiscovery.c_str(), true)) {
-    Serial.println("Humidity discovery message published successfully");
+  if (mqttClient.publish("homeassistant/sensor/esp32_1306_humidity/config", humDiscovery.c_str(), true, 1)) {
+    Serial.println("Humidity discovery message queued");
   } else {
-    Serial.println("Failed to publish humidity discovery message");
+    Serial.println("Failed to queue humidity discovery message");
   }
   
   // 人体感应传感器发现
@@ -273,35 +315,89 @@ void sendMQTTDiscovery() {
   motionDiscovery += "}";
   Serial.print("Motion discovery: ");
   Serial.println(motionDiscovery);
-  if (mqttClient.publish("homeassistant/binary_sensor/esp32_1306_motion/config", motionDiscovery.c_str(), true)) {
-    Serial.println("Motion discovery message published successfully");
+  if (mqttClient.publish("homeassistant/binary_sensor/esp32_1306_motion/config", motionDiscovery.c_str(), true, 1)) {
+    Serial.println("Motion discovery message queued");
   } else {
-    Serial.println("Failed to publish motion discovery message");
+    Serial.println("Failed to queue motion discovery message");
   }
   
-  Serial.println("=== MQTT discovery messages sent ===");
+  Serial.println("=== MQTT discovery messages queued ===");
 }
 
 /**
  * 发布传感器数据到MQTT
  */
 void publishSensorData() {
+  // 未连接时写入闪存日志（需要有效时间戳），连接恢复后由replayReadingLog()重放
+  if (!mqttClient.connected()) {
+    if (readingLogReady && lastSensorUtc != 0) {
+      LoggedReading reading;
+      reading.utc = lastSensorUtc;
+      reading.temperature = currentTemperature;
+      reading.humidity = currentHumidity;
+      reading.flags = digitalRead(PIR_SENSOR_PIN) == HIGH ? 0x01 : 0x00;
+      readingLog.append(reading);
+    }
+    return;
+  }
+
   // 发布温度数据
   char tempBuffer[10];
-  snprintf(tempBuffer, sizeof(tempBuffer), "%.1f", currentTemperature);
+  formatFloatFixed(tempBuffer, sizeof(tempBuffer), currentTemperature, 1);
   mqttClient.publish("esp32-1306/temperature", tempBuffer);
   
   // 发布湿度数据
   char humBuffer[10];
-  snprintf(humBuffer, sizeof(humBuffer), "%.1f", currentHumidity);
+  formatFloatFixed(humBuffer, sizeof(humBuffer), currentHumidity, 1);
   mqttClient.publish("esp32-1306/humidity", humBuffer);
   
   // 发布人体感应数据
   int pirState = digitalRead(PIR_SENSOR_PIN);
   mqttClient.publish("esp32-1306/motion", pirState == HIGH ? "ON" : "OFF");
-  
-  // 发布设备在线状态
-  mqttClient.publish("esp32-1306/availability", "online", true);
+
+  // 数值是否来自热重启缓存
+  mqttClient.publish("esp32-1306/cached", readingsCached ? "true" : "false");
+}
+
+/**
+ * 重放闪存日志中的离线读数：每次最多一批，上一批收到PUBACK后才发送下一批
+ * 消息在确认前由MQTT客户端负责断线重发；重启前未确认的批次在下次连接后重新发送
+ */
+void replayReadingLog() {
+  if (!readingLogReady || historyPacketId != 0 || !mqttClient.connected() || readingLog.pending() == 0) return;
+
+  static LoggedReading batch[HISTORY_BATCH_SIZE];
+  static char payload[HISTORY_BATCH_SIZE * 36 + 32];
+  ReadingLogRange range;
+  size_t count = readingLog.peek(batch, HISTORY_BATCH_SIZE, &range);
+  if (count == 0) return;
+
+  size_t len = snprintf(payload, sizeof(payload), "{\"readings\":[");
+  for (size_t i = 0; i < count; i++) {
+    char tempStr[16];
+    char humStr[16];
+    formatFloatFixed(tempStr, sizeof(tempStr), batch[i].temperature, 2);
+    formatFloatFixed(humStr, sizeof(humStr), batch[i].humidity, 2);
+    len += snprintf(payload + len, sizeof(payload) - len, "%s[%lu,%s,%s,%u]", i == 0 ? "" : ",",
+                    (unsigned long)batch[i].utc, tempStr, humStr, batch[i].flags);
+  }
+  snprintf(payload + len, sizeof(payload) - len, "]}");
+
+  if (mqttClient.publish(mqtt_history_topic, payload, false, 1)) {
+    historyPacketId = mqttClient.lastPacketId();
+    historyBatch = range;
+  }
+}
+
+/**
+ * MQTT PUBACK回调：重放批次被代理确认后，才在闪存中标记为已发送
+ * 按位置范围确认：等待期间离线追加写满一圈时，最旧的记录已不是这一批
+ */
+void onMQTTAcked(uint16_t packetId) {
+  if (packetId != historyPacketId) return;
+  readingLog.consume(historyBatch);
+  historyPacketId = 0;
+  historyBatch = ReadingLogRange();
 }
 
 // ====================硬件级I2C超时保护 ====================
@@ -349,6 +445,7 @@ void checkWiFiConnection() {
       
       // 尝试重新连接
       WiFi.disconnect();
+      warmCache.setFlag(WARM_CACHE_WIFI, false);  // 缓存的AP可能已失效，重新扫描
       WiFi.begin(ssid, password);
       
       // 等待连接（最多10秒），期间要喂狗
@@ -414,33 +511,61 @@ void checkWiFiConnection() {
 }
 
 // ==================== NTP时间同步函数 ====================
+// SNTP回调在LwIP任务中执行，只记录同步结果，由主循环锚定到软件时钟
+portMUX_TYPE ntpSyncMux = portMUX_INITIALIZER_UNLOCKED;
+volatile bool ntpSyncPending = false;    // 是否有待处理的NTP同步结果
+int64_t ntpSyncUtcUs = 0;                // NTP同步得到的UTC时间（微秒）
+int64_t ntpSyncMonoUs = 0;               // 同步时刻的esp_timer单调时间（微秒）
+
+/**
+ * SNTP同步完成回调
+ * 同时记录UTC时间和单调计时器，二者之差就是软件时钟的锚点
+ */
+void onNTPTimeSync(struct timeval* tv) {
+  int64_t monoUs = esp_timer_get_time();
+  portENTER_CRITICAL(&ntpSyncMux);
+  ntpSyncUtcUs = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+  ntpSyncMonoUs = monoUs;
+  ntpSyncPending = true;
+  portEXIT_CRITICAL(&ntpSyncMux);
+}
+
+/**
+ * 把待处理的NTP同步结果锚定到软件时钟
+ * 返回true表示本次有新的同步
+ */
+bool applyNTPSync() {
+  if(!ntpSyncPending) return false;
+  portENTER_CRITICAL(&ntpSyncMux);
+  int64_t utcUs = ntpSyncUtcUs;
+  int64_t monoUs = ntpSyncMonoUs;
+  ntpSyncPending = false;
+  portEXIT_CRITICAL(&ntpSyncMux);
+
+  softClock.sync(utcUs, monoUs);
+  timeCached = false;
+  warmCache.saveTime(utcUs, monoUs);
+  bootProfile.end(bootPhaseNtp, millis());
+  Serial.print("NTP synced, drift: ");
+  Serial.print(softClock.driftPpm());
+  Serial.println(" ppm");
+  return true;
+}
+
 /**
  * 检查并同步NTP时间
- * 每24小时同步一次时间（掉电后重启才需要校准）
+ * SNTP服务本身会周期性同步；这里每24小时强制重新同步一次，
+ * 同步结果通过回调异步到达，不阻塞主循环
  */
 void checkNTPSync() {
+  applyNTPSync();
+
   unsigned long currentMillis = millis();
 
-  // 每隔24小时检查一次NTP同步
+  // 每隔24小时强制重新同步一次
   if(currentMillis - lastNTPCheck >= ntpCheckInterval) {
     lastNTPCheck = currentMillis;
-
-    // 重新配置时间同步（清除NTP缓存，强制重新获取）
-    configTime(0, 0, "pool.ntp.org");  // 临时重置
-    delay(100);
-    configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);  // 重新设置
-
-    struct tm timeinfo;
-    if(getLocalTime(&timeinfo)) {
-      Serial.println("NTP time sync successful");
-      Serial.print("NTP synced: ");
-      Serial.println(&timeinfo, "%Y-%m-%d %H:%M:%S");
-      // 同步成功后更新有效时间
-      memcpy(&lastValidTime, &timeinfo, sizeof(struct tm));
-      hasValidTime = true;
-    } else {
-      Serial.println("NTP time sync failed, using cached time");
-    }
+    sntp_restart();
   }
 }
 
@@ -491,6 +616,12 @@ void handleRoot() {
   server.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
   server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
 
+  // 预先格式化温湿度（不经过printf的浮点格式化）
+  char tempStr[16];
+  char humStr[16];
+  formatFloatFixed(tempStr, sizeof(tempStr), currentTemperature, 1);
+  formatFloatFixed(humStr, sizeof(humStr), currentHumidity, 1);
+
   // 使用预分配缓冲区，避免内存碎片
   int len = snprintf(htmlBuffer, HTML_BUFFER_SIZE,
     "<!DOCTYPE html><html><head><meta charset=\"UTF-8\">"
@@ -518,7 +649,7 @@ void handleRoot() {
     "  const seconds = String(now.getSeconds()).padStart(2, '0');"
     "  document.getElementById('time').textContent = hours + ':' + minutes + ':' + seconds;"
     "}"
-    "const temperature = %.1f;"
+    "const temperature = %s;"
     "let tempColor = temperature < 20 ? '#3498db' : (temperature >= 20 && temperature < 30 ? 'rgb(241,196,15)' : '#e74c3c');"
     "const humColor = '#28a745';"
     "document.addEventListener('DOMContentLoaded', function() {"
@@ -538,11 +669,11 @@ void handleRoot() {
     "<div class=\"data-grid\">"
     "<div class=\"data-card\">"
     "<div class=\"data-label\">🌡️ 温度</div>"
-    "<div class=\"data-value\" id=\"temp-value\">%.1f°C</div>"
+    "<div class=\"data-value\" id=\"temp-value\">%s°C</div>"
     "</div>"
     "<div class=\"data-card\">"
     "<div class=\"data-label\">💧 湿度</div>"
-    "<div class=\"data-value\" id=\"hum-value\">%.1f%%</div>"
+    "<div class=\"data-value\" id=\"hum-value\">%s%%</div>"
     "</div>"
     "</div>"
     "<div class=\"status-bar\">"
@@ -551,7 +682,7 @@ void handleRoot() {
     "<span>页面每10秒自动刷新</span>"
     "</div>"
     "</div></body></html>",
-    currentTemperature, currentTime, currentTemperature, currentHumidity
+    tempStr, clockText.time(), tempStr, humStr
   );
   
   if(len > 0 && len < HTML_BUFFER_SIZE) {
@@ -573,7 +704,8 @@ void handleTemperature() {
   server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
 
   char tempText[32];
-  snprintf(tempText, sizeof(tempText), "%.1f°C", currentTemperature);
+  size_t pos = formatFloatFixed(tempText, sizeof(tempText), currentTemperature, 1);
+  strlcpy(tempText + pos, "°C", sizeof(tempText) - pos);
   server.send(200, "text/plain", tempText);                // 发送纯文本响应
 }
 
@@ -589,7 +721,8 @@ void handleHumidity() {
   server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
 
   char humText[32];
-  snprintf(humText, sizeof(humText), "%.1f%%", currentHumidity);
+  size_t pos = formatFloatFixed(humText, sizeof(humText), currentHumidity, 1);
+  strlcpy(humText + pos, "%", sizeof(humText) - pos);
   server.send(200, "text/plain", humText);                 // 发送纯文本响应
 }
 
@@ -604,9 +737,17 @@ void handleJson() {
   server.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
   server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
 
+  char tempStr[16];
+  char humStr[16];
+  formatFloatFixed(tempStr, sizeof(tempStr), currentTemperature, 1);
+  formatFloatFixed(humStr, sizeof(humStr), currentHumidity, 1);
+
+  char bootStr[320];
+  if(bootProfile.toJson(bootStr, sizeof(bootStr)) == 0) strcpy(bootStr, "null");
+
   int len = snprintf(jsonBuffer, JSON_BUFFER_SIZE,
-    "{\"temperature\": %.1f,\"humidity\": %.1f,\"time\": \"%s\",\"date\": \"%s\",\"status\": \"ok\"}",
-    currentTemperature, currentHumidity, currentTime, currentDate
+    "{\"temperature\": %s,\"humidity\": %s,\"time\": \"%s\",\"date\": \"%s\",\"status\": \"ok\",\"cached\": %s,\"time_cached\": %s,\"boot\": %s}",
+    tempStr, humStr, clockText.time(), clockText.date(), readingsCached ? "true" : "false", timeCached ? "true" : "false", bootStr
   );
   
   if(len > 0 && len < JSON_BUFFER_SIZE) {
@@ -616,6 +757,122 @@ void handleJson() {
   }
 }
 
+/**
+ * 更新二进制快照
+ * 在传感器读取和PIR/屏幕状态变化时调用，内容未变化时不重新编码
+ */
+void updateSnapshot() {
+  SnapshotValues values;
+  values.temperature = currentTemperature;
+  values.humidity = currentHumidity;
+  values.sensorUtc = lastSensorUtc;
+  values.sensorUptimeMs = lastSensorMillis;
+  values.motionUptimeMs = lastMotionTime;
+  values.freeHeap = ESP.getFreeHeap();
+  values.minFreeHeap = ESP.getMinFreeHeap();
+  values.reconnectCount = reconnectCount;
+  values.bootCount = bootCount;
+
+  bool wifiConnected = (WiFi.status() == WL_CONNECTED);
+  values.rssi = wifiConnected ? (int8_t)WiFi.RSSI() : 0;
+  if(digitalRead(PIR_SENSOR_PIN) == HIGH) values.flags |= SNAPSHOT_FLAG_PIR;
+  if(screenOn) values.flags |= SNAPSHOT_FLAG_SCREEN_ON;
+  if(wifiConnected) values.flags |= SNAPSHOT_FLAG_WIFI;
+  if(mqttClient.connected()) values.flags |= SNAPSHOT_FLAG_MQTT;
+  if(softClock.isValid()) values.flags |= SNAPSHOT_FLAG_TIME_VALID;
+  if(readingsCached || timeCached) values.flags |= SNAPSHOT_FLAG_CACHED;
+
+  sensorSnapshot.update(values);
+}
+
+/**
+ * Web服务器 - 二进制快照处理函数
+ * 访问 http://ESP32_IP/snapshot 时调用此函数
+ * 直接发送预编码的快照缓冲区（44字节，布局见SensorSnapshot.h），供NAS高频采集
+ */
+void handleSnapshot() {
+  // 添加CORS响应头，允许跨域访问（用于群晖反向代理）
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+  server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
+
+  server.send_P(200, "application/octet-stream", (const char*)sensorSnapshot.data(), sensorSnapshot.size());
+}
+
+// ==================== Prometheus指标 ====================
+// 各指标的槽位编号（setupMetrics()中分配）
+int metricTemperature = -1;
+int metricHumidity = -1;
+int metricMotion = -1;
+int metricScreenOn = -1;
+int metricFreeHeap = -1;
+int metricMinFreeHeap = -1;
+int metricWifiRssi = -1;
+int metricWifiConnected = -1;
+int metricWifiReconnects = -1;
+int metricMqttConnected = -1;
+int metricBootCount = -1;
+int metricUptime = -1;
+int metricClockDrift = -1;
+int metricHistoryPending = -1;
+
+/**
+ * 一次性生成指标文档（HELP/TYPE/名称），之后只改写数值槽位
+ */
+void setupMetrics() {
+  metricTemperature = metrics.addMetric("esp32_temperature_celsius", "Calibrated AHT20 temperature");
+  metricHumidity = metrics.addMetric("esp32_humidity_percent", "Calibrated AHT20 relative humidity");
+  metricMotion = metrics.addMetric("esp32_motion_detected", "HC-SR501 PIR state (1 = motion)");
+  metricScreenOn = metrics.addMetric("esp32_screen_on", "OLED screen state (1 = on)");
+  metricFreeHeap = metrics.addMetric("esp32_free_heap_bytes", "Free heap");
+  metricMinFreeHeap = metrics.addMetric("esp32_min_free_heap_bytes", "Lowest free heap since boot");
+  metricWifiRssi = metrics.addMetric("esp32_wifi_rssi_dbm", "WiFi signal strength");
+  metricWifiConnected = metrics.addMetric("esp32_wifi_connected", "WiFi connection state (1 = connected)");
+  metricWifiReconnects = metrics.addMetric("esp32_wifi_reconnect_attempts", "Consecutive WiFi reconnect attempts");
+  metricMqttConnected = metrics.addMetric("esp32_mqtt_connected", "MQTT connection state (1 = connected)");
+  metricBootCount = metrics.addMetric("esp32_boot_count", "Boots counted in RTC memory");
+  metricUptime = metrics.addMetric("esp32_uptime_seconds", "Time since boot");
+  metricClockDrift = metrics.addMetric("esp32_clock_drift_ppm", "Estimated oscillator drift");
+  metricHistoryPending = metrics.addMetric("esp32_history_pending_readings", "Offline readings waiting for MQTT replay");
+}
+
+/**
+ * 更新传感器和PIR相关指标（数值变化时调用）
+ */
+void updateStateMetrics() {
+  if(lastSensorMillis != 0) {                             // 首次读取前保持NaN
+    metrics.setFloat(metricTemperature, currentTemperature, 1);
+    metrics.setFloat(metricHumidity, currentHumidity, 1);
+  }
+  metrics.setInt(metricMotion, digitalRead(PIR_SENSOR_PIN) == HIGH ? 1 : 0);
+  metrics.setInt(metricScreenOn, screenOn ? 1 : 0);
+}
+
+/**
+ * Web服务器 - Prometheus指标处理函数
+ * 访问 http://ESP32_IP/metrics 时调用此函数
+ * 只改写系统状态类指标的槽位，然后一次性发送预渲染的缓冲区
+ */
+void handleMetrics() {
+  bool wifiConnected = (WiFi.status() == WL_CONNECTED);
+  metrics.setInt(metricFreeHeap, ESP.getFreeHeap());
+  metrics.setInt(metricMinFreeHeap, ESP.getMinFreeHeap());
+  if(wifiConnected) {
+    metrics.setInt(metricWifiRssi, WiFi.RSSI());
+  } else {
+    metrics.setFloat(metricWifiRssi, NAN, 0);
+  }
+  metrics.setInt(metricWifiConnected, wifiConnected ? 1 : 0);
+  metrics.setInt(metricWifiReconnects, reconnectCount);
+  metrics.setInt(metricMqttConnected, mqttClient.connected() ? 1 : 0);
+  metrics.setInt(metricBootCount, bootCount);
+  metrics.setInt(metricUptime, millis() / 1000);
+  metrics.setInt(metricClockDrift, softClock.driftPpm());
+  metrics.setInt(metricHistoryPending, readingLog.pending());
+
+  server.send_P(200, "text/plain; version=0.0.4", metrics.c_str(), metrics.size());
+}
+
 /**
  * Web服务器 - 404错误处理函数
  * 当访问不存在的路径时调用此函数
@@ -648,6 +905,7 @@ void checkPIRSensor() {
     // 读取PIR传感器状态（HIGH=有人，LOW=无人）
     int pirState = digitalRead(PIR_SENSOR_PIN);
     bool currentPirState = (pirState == HIGH);
+    bool lastScreenOn = screenOn;
 
     // 检测到人体活动
     if(currentPirState) {
@@ -665,6 +923,12 @@ void checkPIRSensor() {
       Serial.println("=== PIR: No motion for 1 minute. Screen OFF ===");
     }
 
+    // PIR或屏幕状态变化时刷新二进制快照
+    if(currentPirState != lastPirState || screenOn != lastScreenOn) {
+      updateSnapshot();
+      updateStateMetrics();
+    }
+
     // 记录当前PIR状态用于下次比较
     lastPirState = currentPirState;
 
@@ -680,6 +944,91 @@ void checkPIRSensor() {
   }
 }
 
+// ==================== 启动流水线函数 ====================
+
+/**
+ * 初始化AHT20（含预热），结果写入sensorState
+ * 主循环在sensorState离开SENSOR_INITIALIZING之前不读取传感器
+ */
+void initSensor() {
+  ahtWire.begin(AHT20_SDA, AHT20_SCL, 400000);  // 初始化第二个I2C总线
+
+  // AHT20初始化最多等待3秒
+  unsigned long ahtTimeout = millis();
+  bool ahtInitSuccess = false;
+  while(millis() - ahtTimeout < 3000 && !ahtInitSuccess) {
+    if (aht.begin(&ahtWire, 0x38)) {               // 使用自定义Wire，地址0x38
+      ahtInitSuccess = true;
+    } else {
+      delay(100);
+    }
+  }
+
+  if(ahtInitSuccess) {
+    delay(AHT20_WARMUP_MS);                        // 预热，确保首次读取准确
+    Serial.println("AHT20 initialized successfully");
+    sensorState = SENSOR_READY;
+  } else {
+    Serial.println("WARNING: AHT20 init timeout, continuing without sensor");
+    sensorState = SENSOR_FAILED;
+  }
+  bootProfile.end(bootPhaseSensor, millis());
+}
+
+/**
+ * 传感器初始化任务（运行在核心0，与主任务中的显示屏初始化并行）
+ * AHT20使用独立的I2C总线（ahtWire），不与OLED争用；预热在任务中等待，不阻塞setup()
+ */
+void sensorInitTask(void* arg) {
+  initSensor();
+  vTaskDelete(nullptr);
+}
+
+/**
+ * WiFi获得IP（事件任务中调用）：记录关联耗时，地址由主循环输出
+ */
+void onWiFiGotIP(WiFiEvent_t event, WiFiEventInfo_t info) {
+  bootProfile.end(bootPhaseWifi, millis());
+  wifiAnnouncePending = true;
+}
+
+/**
+ * 从热重启缓存恢复读数、时间和发现状态
+ * 恢复的值标记为缓存值（/json、MQTT、OLED、快照），AHT20重新读取/NTP同步后清除标记
+ */
+void restoreWarmCache() {
+  if(warmCache.has(WARM_CACHE_READING)) {
+    currentTemperature = warmCache.temperature();
+    currentHumidity = warmCache.humidity();
+    readingsCached = true;
+  }
+  int64_t monoUs = esp_timer_get_time();
+  int64_t utcUs;
+  if(warmCache.utcUs(monoUs, utcUs)) {
+    // 时钟立即可用，不必等NTP；推算值可能偏慢（任务看门狗复位时可达30秒），
+    // 只预置锚点，不计入同步次数，也不参与漂移估算
+    softClock.seed(utcUs, monoUs);
+    timeCached = true;
+  }
+  skipDiscoveryOnce = warmCache.has(WARM_CACHE_MQTT_DISCOVERED);
+  Serial.printf("Warm restart #%lu: reading %s, time %s, AP %s\n", (unsigned long)warmCache.warmBoots(),
+                readingsCached ? "restored" : "none", timeCached ? "restored" : "none",
+                warmCache.has(WARM_CACHE_WIFI) ? "cached" : "none");
+}
+
+/**
+ * 获得IP后输出一次访问地址
+ */
+void announceWiFi() {
+  if(!wifiAnnouncePending) return;
+  wifiAnnouncePending = false;
+  Serial.print("WiFi connected, IP Address: ");
+  Serial.println(WiFi.localIP());
+  Serial.println("Open http://" + WiFi.localIP().toString() + " in your browser");  // 浏览器访问提示
+  Serial.println("External access: http://sumaj.synology.me:7788");
+  warmCache.saveWiFi(WiFi.BSSID(), (uint8_t)WiFi.channel());  // 下次热重启直接关联该AP
+}
+
 /**
  * setup() - 初始化函数
  * 程序启动时执行一次，用于初始化所有硬件和设置
@@ -689,6 +1038,8 @@ void setup() {
   esp_task_wdt_init(30, true);                             // 30秒超时,panic模式(系统重启)
   esp_task_wdt_add(NULL);                                  // 注册当前任务到看门狗(必须!)
   
+  bootPhaseSetup = bootProfile.begin("setup", millis());
+
   // 初始化串口通信
   Serial.begin(115200);                                    // 设置串口波特率为115200
   delay(100);                                              // 等待串口稳定
@@ -703,6 +1054,12 @@ void setup() {
   safeSerialPrint("Free heap at startup: ");
   Serial.print(ESP.getFreeHeap());
   safeSerialPrintln(" bytes");
+
+  // 热重启缓存：上电/外部复位/掉电复位时RTC内存内容无效，直接丢弃
+  esp_reset_reason_t resetReason = esp_reset_reason();
+  bool coldBoot = resetReason == ESP_RST_POWERON || resetReason == ESP_RST_EXT ||
+                  resetReason == ESP_RST_BROWNOUT || resetReason == ESP_RST_UNKNOWN;
+  if(warmCache.begin(coldBoot, esp_timer_get_time())) restoreWarmCache();
   
   // 检测重启循环
   bootCount++;
@@ -743,189 +1100,77 @@ void setup() {
   lastMotionTime = millis();
   Serial.println("PIR lastMotionTime initialized to " + String(lastMotionTime));
 
-  // 初始化OLED显示屏（U8g2版本），添加I2C超时保护
-  esp_task_wdt_reset();                                      // 喂狗
-  unsigned long oledTimeout = millis();
-  bool oledInitSuccess = false;
-  
-  // OLED初始化最多等待3秒
-  while(millis() - oledTimeout < 3000 && !oledInitSuccess) {
-    esp_task_wdt_reset();
-    display.begin();  // 直接调用，不支持try-catch
-    oledInitSuccess = true;
-  }
-  
-  if(!oledInitSuccess) {
-    Serial.println("WARNING: OLED init timeout, continuing without display");
-  }
-  
-  display.clearBuffer();                                   // 清空显示缓冲区
-
-  // 初始化温湿度传感器，添加I2C超时保护
-  esp_task_wdt_reset();
-  ahtWire.begin(AHT20_SDA, AHT20_SCL, 400000);  // 初始化第二个I2C总线
-  
-  unsigned long ahtTimeout = millis();
-  bool ahtInitSuccess = false;
-  
-  // AHT20初始化最多等待3秒
-  while(millis() - ahtTimeout < 3000 && !ahtInitSuccess) {
-    esp_task_wdt_reset();
-    if (aht.begin(&ahtWire, 0x38)) {               // 使用自定义Wire，地址0x38
-      ahtInitSuccess = true;
-    } else {
-      delay(100);
-    }
-  }
-  
-  if(!ahtInitSuccess) {
-    Serial.println("WARNING: AHT20 init timeout, continuing without sensor");
-    display.clearBuffer();
-    display.setFont(u8g2_font_ncenB08_tr);
-    display.drawStr(0, 15, "Sensor Error!");
-    display.drawStr(0, 30, "No AHT20");
-    display.sendBuffer();
-    esp_task_wdt_reset();
-    delay(1000);  // 缩短延迟并喂狗
+  // 挂载离线读数日志（重启前未发送的读数会在MQTT连接后重放）
+  readingLogReady = readingFlash.open() && readingLog.begin();
+  if (readingLogReady) {
+    Serial.printf("Reading log mounted: %lu pending of %lu\n", (unsigned long)readingLog.pending(),
+                  (unsigned long)readingLog.capacity());
   } else {
-    Serial.println("AHT20 initialized successfully");
-    Serial.print("AHT20 I2C: SDA=GPIO");
-    Serial.print(AHT20_SDA);
-    Serial.print(", SCL=GPIO");
-    Serial.println(AHT20_SCL);
-
-    // AHT20传感器预热，确保首次读取准确
-    Serial.println("AHT20 warming up...");
-    display.clearBuffer();
-    display.setFont(u8g2_font_ncenB08_tr);
-    display.drawStr(0, 15, "Sensor Warming...");
-    display.sendBuffer();
-    esp_task_wdt_reset();
-    delay(500);  // 预热0.5秒（缩短延迟）
+    Serial.println("Reading log unavailable (no spiffs partition)");
   }
 
-  // ==================== 连接WiFi网络 ====================
-  // 添加WiFi连接超时保护（最多等待30秒）
+  // ==================== 1. 先配置静态IP，再立即开始WiFi关联 ====================
+  // 静态IP在WiFi.begin()之前生效，关联后不再先走一遍DHCP；关联在WiFi任务中后台进行
   esp_task_wdt_reset();
-  WiFi.begin(ssid, password);                             // 开始连接WiFi
-
-  Serial.print("Connecting to WiFi");                      // 串口输出连接信息
-  display.clearBuffer();                                   // 清空缓冲区
-  display.setFont(u8g2_font_ncenB08_tr);                  // 设置小字体
-  display.drawStr(0, 15, "Connecting WiFi...");           // 显示连接信息
-  display.sendBuffer();                                    // 发送到OLED显示
-
-  unsigned long wifiTimeout = millis();
-  while(WiFi.status() != WL_CONNECTED) {                   // 循环等待WiFi连接成功
-    esp_task_wdt_reset();                                  // 喂狗,防止看门狗超时
-    delay(100);                                            // 缩短延迟为100ms
-    if(millis() % 500 < 100) Serial.print(".");            // 每500ms打印一个点
-    
-    // 添加WiFi连接超时保护（30秒后放弃）
-    if(millis() - wifiTimeout >= 30000) {
-      Serial.println("\nWiFi connection timeout!");
-      display.clearBuffer();
-      display.setFont(u8g2_font_ncenB08_tr);
-      display.drawStr(0, 15, "WiFi Timeout!");
-      display.drawStr(0, 30, "Will retry later");
-      display.sendBuffer();
-      esp_task_wdt_reset();
-      delay(2000);  // 显示2秒后继续（不要重启，让系统进入主循环）
-      break;  // 跳出WiFi连接等待，让主循环中的checkWiFiConnection处理
-    }
+  WiFi.mode(WIFI_STA);
+  if(!WiFi.config(local_IP, gateway, subnet, primaryDNS, secondaryDNS)) {
+    Serial.println("Static IP config failed, falling back to DHCP");
   }
-  if(WiFi.status() == WL_CONNECTED) {
-    Serial.println();                                        // 换行
-    Serial.println("WiFi connected");                        // 输出连接成功信息
-    Serial.print("IP Address: ");                           // 打印IP地址提示
-    Serial.println(WiFi.localIP());                          // 打印ESP32的IP地址
-    Serial.println("Open http://" + WiFi.localIP().toString() + " in your browser");  // 浏览器访问提示
-
-    // 显示WiFi连接成功和IP地址
-    display.clearBuffer();                                  // 清空缓冲区
-    display.setFont(u8g2_font_ncenB08_tr);                   // 设置字体
-    display.drawStr(0, 15, "WiFi Connected!");             // 显示连接成功
-    String ipStr = "IP: " + WiFi.localIP().toString();      // 拼接IP地址字符串
-    display.drawStr(0, 30, ipStr.c_str());                  // 显示IP地址
-    display.sendBuffer();                                   // 发送到OLED
-    esp_task_wdt_reset();  // 喂狗
-    delay(1000);                                             // 显示1秒让用户看到IP地址
+  WiFi.onEvent(onWiFiGotIP, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  bootPhaseWifi = bootProfile.begin("wifi", millis());
+  if(warmCache.has(WARM_CACHE_WIFI)) {
+    WiFi.begin(ssid, password, warmCache.channel(), warmCache.bssid());  // 复位前的AP和信道：跳过扫描
+  } else {
+    WiFi.begin(ssid, password);
   }
+  Serial.println("WiFi association started in background");
 
-  // 配置网络时间同步（NTP）
-  // configTime用于配置ESP32的时间同步服务
+  // SNTP在接口获得IP后自动开始请求，同步结果由回调异步到达
+  softClock.setUtcOffset(gmtOffset_sec + daylightOffset_sec);  // 时区偏移表只计算一次
+  sntp_set_time_sync_notification_cb(onNTPTimeSync);         // 同步完成后锚定软件时钟
+  bootPhaseNtp = bootProfile.begin("ntp", millis());
   configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);  // 设置时区、夏令时和NTP服务器
 
-  // 等待NTP时间同步成功（最多等待5秒）
-  Serial.print("Syncing NTP time...");
-  display.clearBuffer();
-  display.setFont(u8g2_font_ncenB08_tr);
-  display.drawStr(0, 15, "Syncing NTP...");
-  display.sendBuffer();
-
-  struct tm timeinfo;
-  int syncAttempts = 0;
-  const int maxSyncAttempts = 10;  // 最多尝试10次，每次延迟500ms，总共5秒
-
-  while(!getLocalTime(&timeinfo) && syncAttempts < maxSyncAttempts) {
-    esp_task_wdt_reset();  // 喂狗
-    delay(100);
-    if(syncAttempts % 5 == 0) Serial.print(".");  // 每500ms打印一个点
-    syncAttempts++;
-  }
-
-  if(getLocalTime(&timeinfo)) {
-    Serial.println("\nNTP time sync successful!");
-    Serial.print("Current time: ");
-    Serial.println(&timeinfo, "%Y-%m-%d %H:%M:%S");
-    // 保存初始有效时间
-    memcpy(&lastValidTime, &timeinfo, sizeof(struct tm));
-    hasValidTime = true;
-  } else {
-    Serial.println("\nNTP time sync failed, will retry in loop");
+  // ==================== 2. 传感器初始化任务（独立I2C总线，与显示屏并行）====================
+  bootPhaseSensor = bootProfile.begin("sensor", millis());
+  if(xTaskCreatePinnedToCore(sensorInitTask, "aht_init", 4096, nullptr, 1, nullptr, 0) != pdPASS) {
+    initSensor();  // 无法创建任务时退回到同步初始化
   }
 
-  // ==================== 配置静态IP ====================
-  // 添加超时保护
+  // ==================== 3. 显示屏初始化 ====================
+  bootPhaseDisplay = bootProfile.begin("display", millis());
   esp_task_wdt_reset();
-  unsigned long configTimeout = millis();
-  bool configSuccess = false;
-  while(millis() - configTimeout < 3000 && !configSuccess) {
-    esp_task_wdt_reset();  // 持续喂狗
-    configSuccess = WiFi.config(local_IP, gateway, subnet, primaryDNS, secondaryDNS);
-    if(!configSuccess) delay(100);
-  }
-  
-  if (configSuccess) {
-    Serial.println("Static IP configured successfully");
-    Serial.print("ESP32 IP: ");
-    Serial.println(WiFi.localIP());
-    Serial.println("External access: http://sumaj.synology.me:7788");
-  } else {
-    Serial.println("Static IP config timeout, using DHCP-assigned IP");
-    Serial.print("Current IP: ");
-    Serial.println(WiFi.localIP());
-  }
+  display.begin();
+  display.clearBuffer();
+  display.setFont(u8g2_font_ncenB08_tr);
+  display.drawStr(0, 15, "Connecting WiFi...");
+  display.sendBuffer();
+  bootProfile.end(bootPhaseDisplay, millis());
 
-  // ==================== 配置Web服务器 ====================
+  // ==================== 4. Web服务器 ====================
+  // 监听在所有地址上，接口获得IP的同时即可响应请求，不等待WiFi连接
   server.on("/", handleRoot);                              // 注册根路径处理函数（主页）
   server.on("/temperature", handleTemperature);            // 注册温度API路径
   server.on("/humidity", handleHumidity);                  // 注册湿度API路径
   server.on("/json", handleJson);                          // 注册JSON API路径
+  server.on("/snapshot", handleSnapshot);                  // 注册二进制快照API路径
+  setupMetrics();
+  server.on("/metrics", handleMetrics);                    // 注册Prometheus指标路径
   server.onNotFound(handleNotFound);                       // 注册404处理函数
 
   server.begin();                                           // 启动Web服务器
   Serial.println("HTTP server started");                   // 输出服务器启动成功信息
-  Serial.println("Web server running on http://" + WiFi.localIP().toString());  // 显示服务器地址
 
-  // 连接MQTT
-  connectMQTT();
+  // 配置MQTT（在主循环中后台连接）
+  bootPhaseMqtt = bootProfile.begin("mqtt", millis());
+  setupMQTT();
 
   display.clearBuffer();                                  // 清空OLED准备进入主循环显示
   display.setFont(u8g2_font_ncenB08_tr);                  // 设置字体
   display.drawStr(0, 32, "Starting...");                // 显示启动状态
   display.sendBuffer();                                   // 更新OLED
 
+  bootProfile.end(bootPhaseSetup, millis());
   Serial.println("System ready. Watchdog running.");
   Serial.println("=== Entering main loop ===");
 }
@@ -938,64 +1183,44 @@ void loop() {
   // ==================== 喂看门狗 ====================
   esp_task_wdt_reset();                                    // 重置看门狗计时器,防止系统重启
                                                             // 必须在30秒内调用一次
+  warmCache.touch(esp_timer_get_time());                   // 记录运行时间（热重启后据此推算时间）
 
   // ==================== 系统保护检查 ====================
   checkWiFiConnection();                                   // 检查并恢复WiFi连接
+  announceWiFi();                                          // 首次获得IP时输出地址
   checkNTPSync();                                         // 定期同步NTP时间
   checkMemory();                                           // 监控剩余内存
   checkPIRSensor();                                        // 检查PIR传感器状态
   
   // ==================== MQTT客户端循环 ====================
-  if (!mqttClient.connected()) {
-    connectMQTT();
-  }
-  mqttClient.loop();
+  // 非阻塞：推进连接/重连、处理PUBACK，并把队列中的消息合并为一次TCP写入
+  mqttClient.loop(millis());
+  replayReadingLog();                                      // 连接恢复后重放离线读数
 
   // ==================== 获取时间 ====================
   struct tm timeinfo;                                      // 定义时间结构体变量
                                                             // tm结构体包含年、月、日、时、分、秒等字段
 
-  // 获取本地时间
-  // getLocalTime()会从NTP服务器获取时间并填充到timeinfo结构体
-  if(!getLocalTime(&timeinfo)) {                          // 如果获取时间失败
-    Serial.println("Failed to obtain time");              // 输出错误信息
-
-    // 如果有上次有效时间，使用它（继续显示，不停止）
-    if(hasValidTime) {
-      memcpy(&timeinfo, &lastValidTime, sizeof(struct tm));
-      // 手动增加1秒，保持时间继续走动
-      timeinfo.tm_sec++;
-      if(timeinfo.tm_sec >= 60) {
-        timeinfo.tm_sec = 0;
-        timeinfo.tm_min++;
-        if(timeinfo.tm_min >= 60) {
-          timeinfo.tm_min = 0;
-          timeinfo.tm_hour++;
-          if(timeinfo.tm_hour >= 24) {
-            timeinfo.tm_hour = 0;
-          }
-        }
-      }
-      Serial.println("Using fallback time");
-    } else {
-      // 显示同步状态
-      display.clearBuffer();
-      display.setFont(u8g2_font_ncenB08_tr);
-      display.drawStr(0, 32, "Syncing Time...");
-      display.sendBuffer();
-      esp_task_wdt_reset();  // 喂狗
-      delay(500);           // 等待0.5秒后重试
-      return;             // 跳过本次循环，等待下次重试
+  // 从软件时钟获取本地时间（NTP锚点 + 单调计时器 + 漂移校正，不调用localtime）
+  // NTP暂时不可用时时钟照常走动，跨日/跨月也正确
+  if(!softClock.localTime(esp_timer_get_time(), timeinfo)) {  // 尚未完成首次NTP同步
+    // 显示同步状态
+    display.clearBuffer();
+    display.setFont(u8g2_font_ncenB08_tr);
+    display.drawStr(0, 32, "Syncing Time...");
+    display.sendBuffer();
+    esp_task_wdt_reset();  // 喂狗
+    unsigned long waitStart = millis();
+    while(millis() - waitStart < 500) {  // 等待0.5秒后重试，期间照常处理HTTP请求
+      server.handleClient();
+      delay(10);
     }
-  } else {
-    // 时间获取成功，保存为有效时间
-    memcpy(&lastValidTime, &timeinfo, sizeof(struct tm));
-    hasValidTime = true;
+    return;             // 跳过本次循环，等待下次重试
   }
 
   // ==================== 读取温湿度（每5次循环读取一次=5秒） ====================
   sensorUpdateCounter++;
-  if(sensorUpdateCounter >= sensorUpdateInterval) {
+  if(sensorUpdateCounter >= sensorUpdateInterval && sensorState != SENSOR_INITIALIZING) {
     sensorUpdateCounter = 0;  // 重置计数器
 
     // AHT20需要先触发测量，添加I2C超时保护
@@ -1055,41 +1280,29 @@ void loop() {
     // 更新全局变量（供Web服务器使用）
     currentTemperature = temperature;                       // 保存当前温度值
     currentHumidity = hum;                               // 保存当前湿度值
-    
-    // 发布传感器数据到MQTT（每次读取后）
-    publishSensorData();
-    
-    // 发布传感器数据到MQTT（每次读取后）
-    publishSensorData();
+    readingsCached = false;
+    warmCache.saveReading(temperature, hum);
+    lastSensorMillis = millis();
+    lastSensorUtc = (uint32_t)softClock.nowUtc(esp_timer_get_time());
+    updateSnapshot();                                     // 刷新二进制快照
+    updateStateMetrics();                                 // 刷新Prometheus指标
     
     // 发布传感器数据到MQTT（每次读取后）
     publishSensorData();
   }
 
   // ==================== 更新时间和日期（每次循环都更新） ====================
-  sprintf(currentTime, "%02d:%02d:%02d",                    // 格式化时间字符串
-          timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-  sprintf(currentDate, "%04d-%02d-%02d",                    // 格式化日期字符串
-          timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday);
+  // 同一分钟内只改写秒的两位数字，跨分钟/跨日才整体重新生成（不调用sprintf）
+  clockText.update(timeinfo);
   firstDataReady = true;                                    // 标记数据已准备就绪
 
-  // 准备显示字符串（用于OLED和串口）
-  char dateStr[20];                                        // 定义字符数组存储日期字符串
-  sprintf(dateStr, "%04d-%02d-%02d",                       // 格式化日期字符串
-           timeinfo.tm_year + 1900,                         // 年份：2025
-           timeinfo.tm_mon + 1,                             // 月份：1-12
-           timeinfo.tm_mday);                               // 日期：1-31
-
-  char timeStr[16];                                        // 定义字符数组存储时间字符串
-  sprintf(timeStr, "%02d:%02d:%02d",                       // 格式化时间为HH:MM:SS
-           timeinfo.tm_hour,                                // 小时：0-23
-           timeinfo.tm_min,                                 // 分钟：0-59
-           timeinfo.tm_sec);                                // 秒：0-59
-
+  char tempValStr[16];
+  char humValStr[16];
+  formatFloatFixed(tempValStr, sizeof(tempValStr), currentTemperature, 1);  // 温度值（使用全局变量）
+  formatFloatFixed(humValStr, sizeof(humValStr), currentHumidity, 1);       // 湿度值（使用全局变量）
   char tempHumStr[30];                                     // 定义字符数组存储温湿度字符串
-  sprintf(tempHumStr, "%.1f\xB0""C  %.1f%%",              // 格式化温湿度字符串，\xB0是度数符号的十六进制码
-          currentTemperature,                               // 温度值（使用全局变量）
-          currentHumidity);                                 // 湿度值（使用全局变量）
+  snprintf(tempHumStr, sizeof(tempHumStr), "%s\xB0""C  %s%%",  // 拼接温湿度字符串，\xB0是度数符号的十六进制码
+           tempValStr, humValStr);
 
   // ==================== OLED显示 ====================
   // 只有屏幕开启时才显示内容
@@ -1110,14 +1323,20 @@ void loop() {
     }
 
     // ========== 显示日期（居中） ==========
-    printCentered(dateStr, 10, u8g2_font_6x10_tr);         // 在y=10位置居中显示日期，使用更稳定的6x10字体
+    printCentered(clockText.date(), 10, u8g2_font_6x10_tr);         // 在y=10位置居中显示日期，使用更稳定的6x10字体
 
     // ========== 显示时间（居中，大字体，第二行） ==========
-    printCentered(timeStr, 38, u8g2_font_ncenB18_tr);       // 在y=38位置居中显示，使用大字体（屏幕正中央）
+    printCentered(clockText.time(), 38, u8g2_font_ncenB18_tr);       // 在y=38位置居中显示，使用大字体（屏幕正中央）
 
     // ========== 显示温湿度（居中，较小字体，第三行） ==========
     printCentered(tempHumStr, 60, u8g2_font_ncenB12_tf);    // 在y=60位置居中显示温湿度，使用支持完整字符集的字体
 
+    // ========== 右上角：数值或时间来自热重启缓存时显示"*" ==========
+    if(readingsCached || timeCached) {
+      display.setFont(u8g2_font_6x10_tr);
+      display.drawStr(122, 8, "*");
+    }
+
     // 刷新显示屏（U8g2版本）
     display.sendBuffer();                                   // 将缓冲区的所有内容发送到OLED屏幕显示
                                                                 // 此时用户才能看到屏幕上的内容
@@ -1129,10 +1348,12 @@ void loop() {
 
   // ==================== 串口输出（调试用） ====================
   // 使用安全串口输出，避免阻塞
+  char debugTemp[16];
+  formatFloatFixed(debugTemp, sizeof(debugTemp), currentTemperature, 1);
   char debugBuffer[128];
   int len = snprintf(debugBuffer, sizeof(debugBuffer),
-    "Time: %s  Temp: %.1f C  WiFi: %s  PIR: %s  FreeMem: %dKB",
-    timeStr, currentTemperature,
+    "Time: %s  Temp: %s C  WiFi: %s  PIR: %s  FreeMem: %dKB",
+    clockText.time(), debugTemp,
     WiFi.status() == WL_CONNECTED ? "OK" : "LOST",
     digitalRead(PIR_SENSOR_PIN) == HIGH ? "HIGH" : "LOW",
     ESP.getFreeHeap() / 1024
@@ -1147,7 +1368,8 @@ void loop() {
   unsigned long delayStart = millis();
   while(millis() - delayStart < 1000) {
     server.handleClient();  // 持续处理HTTP请求
-    mqttClient.loop();      // 处理MQTT消息
+    mqttClient.loop(millis());  // 处理MQTT消息
+    replayReadingLog();
     delay(10);  // 短暂延迟，避免CPU占用过高
   }
 }
@@ -1157,11 +1379,11 @@ void loop() {
  *
  * 1. setup()只执行一次：
  *    - 初始化串口（115200波特率）
- *    - 初始化U8g2 OLED显示屏
- *    - 初始化DHT20温湿度传感器
- *    - 连接WiFi网络
- *    - 配置NTP时间服务器
- *    - 启动Web服务器（监听80端口）
+ *    - 配置静态IP并开始WiFi关联（后台进行），配置NTP时间服务器
+ *    - 在核心0的任务中初始化DHT20温湿度传感器，同时初始化U8g2 OLED显示屏
+ *    - 启动Web服务器（监听80端口），不等待WiFi连接
+ *    - 各阶段耗时记录在/json的"boot"字段中
+ *    - 看门狗/软件复位后从RTC内存恢复上次的读数、时间和AP（/json的"cached"/"time_cached"为true，OLED右上角显示"*"）
  *
  * 2. loop()无限循环（每秒一次）：
  *    - 从NTP获取当前时间
@@ -1,5 +1,14 @@
 #include <Arduino.h>
 #include <unity.h>
+#include <FloatFormat.h>
+#include <ClockText.h>
+#include <SoftClock.h>
+#include <SensorSnapshot.h>
+#include <MetricsBuffer.h>
+#include <AsyncMqtt.h>
+#include <ReadingLog.h>
+#include <BootProfile.h>
+#include <WarmCache.h>
 
 // 测试配置常量
 #define TEST_WIFI_OK 3
@@ -227,6 +236,619 @@ void test_memory_normal(void) {
     TEST_ASSERT_TRUE(freeHeap > 20000);
 }
 
+// ==================== 浮点格式化测试 ====================
+
+void test_float_format_matches_snprintf(void) {
+    // 测试定点格式化与snprintf("%.*f")逐字节一致（覆盖传感器常见取值范围）
+    char fast[32];
+    char ref[32];
+    for (int i = -50000; i <= 50000; i++) {
+        float value = i * 0.0037f;
+        for (uint8_t decimals = 0; decimals <= FLOAT_FORMAT_MAX_DECIMALS; decimals++) {
+            size_t len = formatFloatFixed(fast, sizeof(fast), value, decimals);
+            int refLen = snprintf(ref, sizeof(ref), "%.*f", decimals, value);
+            TEST_ASSERT_EQUAL_STRING(ref, fast);
+            TEST_ASSERT_EQUAL_UINT32(refLen, len);
+        }
+    }
+}
+
+void test_float_format_rounding_edges(void) {
+    // 测试恰好一半时取偶数、负零和截断
+    char buf[16];
+    formatFloatFixed(buf, sizeof(buf), 0.5f, 0);
+    TEST_ASSERT_EQUAL_STRING("0", buf);
+    formatFloatFixed(buf, sizeof(buf), 2.5f, 0);
+    TEST_ASSERT_EQUAL_STRING("2", buf);
+    formatFloatFixed(buf, sizeof(buf), 0.125f, 2);
+    TEST_ASSERT_EQUAL_STRING("0.12", buf);
+    formatFloatFixed(buf, sizeof(buf), -0.01f, 1);
+    TEST_ASSERT_EQUAL_STRING("-0.0", buf);
+    formatFloatFixed(buf, 4, 25.36f, 1);
+    TEST_ASSERT_EQUAL_STRING("25.", buf);
+}
+
+// ==================== 增量时钟字符串测试 ====================
+
+void test_clock_text_patches_seconds_only(void) {
+    // 测试同一分钟内只改写秒的数字，并报告变化范围
+    ClockText clock;
+    struct tm t = {};
+    t.tm_year = 125; t.tm_mon = 11; t.tm_mday = 31;
+    t.tm_hour = 23; t.tm_min = 59; t.tm_sec = 48;
+    TEST_ASSERT_TRUE(clock.update(t));
+    TEST_ASSERT_EQUAL_STRING("23:59:48", clock.time());
+    TEST_ASSERT_EQUAL_STRING("2025-12-31", clock.date());
+
+    t.tm_sec = 49;
+    TEST_ASSERT_TRUE(clock.update(t));
+    TEST_ASSERT_EQUAL_STRING("23:59:49", clock.time());
+    TEST_ASSERT_EQUAL_UINT8(7, clock.timeChangedBegin());
+    TEST_ASSERT_EQUAL_UINT8(8, clock.timeChangedEnd());
+    TEST_ASSERT_FALSE(clock.dateChanged());
+
+    t.tm_sec = 50;
+    clock.update(t);
+    TEST_ASSERT_EQUAL_UINT8(6, clock.timeChangedBegin());
+
+    // 相同时间不产生变化
+    TEST_ASSERT_FALSE(clock.update(t));
+}
+
+void test_clock_text_increment_rollover(void) {
+    // 测试逐秒递增跨越年份（含闰年2月29日）
+    ClockText clock;
+    struct tm t = {};
+    t.tm_year = 125; t.tm_mon = 11; t.tm_mday = 31;
+    t.tm_hour = 23; t.tm_min = 59; t.tm_sec = 59;
+    clock.update(t);
+    TEST_ASSERT_TRUE(clock.incrementSecond());
+    TEST_ASSERT_EQUAL_STRING("00:00:00", clock.time());
+    TEST_ASSERT_EQUAL_STRING("2026-01-01", clock.date());
+    TEST_ASSERT_TRUE(clock.dateChanged());
+    TEST_ASSERT_EQUAL_UINT8(0, clock.timeChangedBegin());
+
+    t.tm_year = 128; t.tm_mon = 1; t.tm_mday = 28;
+    clock.update(t);
+    clock.incrementSecond();
+    TEST_ASSERT_EQUAL_STRING("2028-02-29", clock.date());
+}
+
+// ==================== 软件时钟测试 ====================
+
+void test_soft_clock_corrects_drift(void) {
+    // 模拟晶振偏慢50ppm：每小时同步一次，之后一天内误差应小于10ms
+    SoftClock clock;
+    const int64_t utc0 = 1767225600LL * 1000000LL;       // 2026-01-01 00:00:00 UTC
+    const int64_t hourUs = 3600LL * 1000000LL;
+    clock.sync(utc0, 0);
+    for (int i = 1; i <= 4; i++) {
+        int64_t mono = i * hourUs - i * hourUs / 1000000 * 50;  // 单调计时器少走50ppm
+        clock.sync(utc0 + i * hourUs, mono);
+    }
+    TEST_ASSERT_EQUAL_INT32(50, clock.driftPpm());
+
+    int64_t trueElapsed = 28 * hourUs;
+    int64_t mono = trueElapsed - trueElapsed / 1000000 * 50;
+    int64_t error = clock.nowUtcUs(mono) - (utc0 + trueElapsed);
+    TEST_ASSERT_TRUE(error > -10000 && error < 10000);
+}
+
+void test_soft_clock_local_time_rollover(void) {
+    // 测试东八区本地时间跨年（手动tm_sec++无法进位到日期）
+    SoftClock clock;
+    clock.setUtcOffset(8 * 3600);
+    TEST_ASSERT_FALSE(clock.isValid());
+    clock.sync(1767196799LL * 1000000LL, 0);             // 2025-12-31 23:59:59 北京时间
+    struct tm t;
+    TEST_ASSERT_TRUE(clock.localTime(0, t));
+    TEST_ASSERT_EQUAL(2025 - 1900, t.tm_year);
+    TEST_ASSERT_EQUAL(23, t.tm_hour);
+    TEST_ASSERT_EQUAL(59, t.tm_sec);
+
+    clock.localTime(1000000, t);
+    TEST_ASSERT_EQUAL(2026 - 1900, t.tm_year);
+    TEST_ASSERT_EQUAL(0, t.tm_mon);
+    TEST_ASSERT_EQUAL(1, t.tm_mday);
+    TEST_ASSERT_EQUAL(0, t.tm_hour);
+    TEST_ASSERT_EQUAL(0, t.tm_yday);
+    TEST_ASSERT_EQUAL(4, t.tm_wday);                     // 2026-01-01是星期四
+}
+
+void test_soft_clock_seed_is_not_a_sync(void) {
+    // 测试热重启预置的时间（偏慢0.5秒）不计入同步、不参与漂移估算
+    SoftClock clock;
+    const int64_t utc0 = 1767225600LL * 1000000LL;
+    const int64_t minuteUs = 60LL * 1000000LL;
+    clock.seed(utc0 - 500000, 0);
+    TEST_ASSERT_TRUE(clock.isValid());
+    TEST_ASSERT_EQUAL_UINT32(0, clock.syncCount());
+    TEST_ASSERT_TRUE(clock.nowUtcUs(minuteUs) == utc0 + minuteUs - 500000);
+
+    // NTP在20分钟后才恢复：0.5秒的差值不能被当作漂移（否则约为416ppm，在上限以内）
+    clock.sync(utc0 + 20 * minuteUs, 20 * minuteUs);
+    TEST_ASSERT_EQUAL_UINT32(1, clock.syncCount());
+    TEST_ASSERT_EQUAL_INT32(0, clock.driftPpm());
+    TEST_ASSERT_TRUE(clock.nowUtcUs(21 * minuteUs) == utc0 + 21 * minuteUs);
+
+    // 第二次同步按首次估算直接采用，不与0平均
+    int64_t elapsed = 20 * minuteUs;
+    clock.sync(utc0 + 40 * minuteUs, 20 * minuteUs + elapsed - elapsed / 1000000 * 50);
+    TEST_ASSERT_EQUAL_INT32(50, clock.driftPpm());
+}
+
+// ==================== 二进制快照测试 ====================
+
+void test_snapshot_layout(void) {
+    // 测试小端序布局与版本号
+    SensorSnapshot snapshot;
+    SnapshotValues values;
+    values.temperature = 25.5f;
+    values.humidity = 60.0f;
+    values.rssi = -61;
+    values.flags = SNAPSHOT_FLAG_PIR | SNAPSHOT_FLAG_WIFI;
+    values.reconnectCount = 3;
+    values.bootCount = 0x0102;
+    TEST_ASSERT_TRUE(snapshot.update(values));
+
+    const uint8_t* data = snapshot.data();
+    TEST_ASSERT_EQUAL_UINT32(SNAPSHOT_SIZE, snapshot.size());
+    TEST_ASSERT_EQUAL_MEMORY("SNAP", data, 4);
+    TEST_ASSERT_EQUAL_UINT8(SNAPSHOT_VERSION, data[4]);
+    TEST_ASSERT_EQUAL_UINT8(SNAPSHOT_FLAG_PIR | SNAPSHOT_FLAG_WIFI, data[5]);
+    TEST_ASSERT_EQUAL_INT8(-61, (int8_t)data[6]);
+    TEST_ASSERT_EQUAL_UINT8(1, data[8]);                 // 序号
+    float temperature;
+    memcpy(&temperature, data + 12, sizeof(temperature));
+    TEST_ASSERT_EQUAL_FLOAT(25.5f, temperature);
+    TEST_ASSERT_EQUAL_UINT8(3, data[40]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, data[42]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, data[43]);
+}
+
+void test_snapshot_reencodes_only_on_change(void) {
+    // 测试数值未变化时不重新编码，序号保持不变
+    SensorSnapshot snapshot;
+    SnapshotValues values;
+    values.temperature = 21.0f;
+    TEST_ASSERT_TRUE(snapshot.update(values));
+    TEST_ASSERT_FALSE(snapshot.update(values));
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.sequence());
+
+    values.flags = SNAPSHOT_FLAG_SCREEN_ON;
+    TEST_ASSERT_TRUE(snapshot.update(values));
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.sequence());
+}
+
+// ==================== Prometheus指标测试 ====================
+
+void test_metrics_slot_update(void) {
+    // 测试同名指标共用HELP/TYPE，更新数值只改写槽位
+    static char text[512];
+    MetricsBuffer buf(text, sizeof(text));
+    int temp = buf.addMetric("temperature_celsius", "Temperature", "{room=\"a\"}");
+    int temp2 = buf.addMetric("temperature_celsius", "Temperature", "{room=\"b\"}");
+    int boots = buf.addMetric("boot_count", "Boots");
+    TEST_ASSERT_EQUAL(0, temp);
+    TEST_ASSERT_EQUAL(2, boots);
+    size_t size = buf.size();
+
+    TEST_ASSERT_TRUE(buf.setFloat(temp, 25.25f, 1));
+    TEST_ASSERT_TRUE(buf.setInt(boots, -12));
+    TEST_ASSERT_EQUAL_UINT32(size, buf.size());
+    TEST_ASSERT_EQUAL_STRING(
+        "# HELP temperature_celsius Temperature\n# TYPE temperature_celsius gauge\n"
+        "temperature_celsius{room=\"a\"}          25.2\n"
+        "temperature_celsius{room=\"b\"}           NaN\n"
+        "# HELP boot_count Boots\n# TYPE boot_count gauge\n"
+        "boot_count           -12\n",
+        buf.c_str());
+    TEST_ASSERT_FALSE(buf.setInt(temp2 + 5, 1));
+}
+
+void test_metrics_200_entities(void) {
+    // 200条指标：文档只生成一次，更新后长度不变
+    static char text[16384];
+    static char labels[200][24];
+    MetricsBuffer buf(text, sizeof(text));
+    for (int i = 0; i < 200; i++) {
+        snprintf(labels[i], sizeof(labels[i]), "{id=\"sensor_%d\"}", i);
+        TEST_ASSERT_EQUAL(i, buf.addMetric("esphome_sensor_value", "Sensor state", labels[i]));
+    }
+    size_t size = buf.size();
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 200; i++) {
+            buf.setFloat(i, i * 0.5f + round, 2);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(size, buf.size());
+    TEST_ASSERT_EQUAL_UINT32(size, strlen(buf.c_str()));
+    TEST_ASSERT_NOT_NULL(strstr(buf.c_str(), "{id=\"sensor_199\"}        108.50\n"));
+}
+
+// ==================== 异步MQTT客户端测试 ====================
+
+// 内存中的模拟传输层：记录写入调用，入站数据由测试注入
+class FakeMqttTransport : public MqttTransport {
+ public:
+    bool begin(const char*, uint16_t) override { open = true; return true; }
+    int status() override { return open ? 1 : -1; }
+    int write(const uint8_t* data, size_t len) override {
+        if (!open) return -1;
+        size_t n = len < writeLimit ? len : writeLimit;
+        memcpy(out + outLen, data, n);
+        outLen += n;
+        writeCalls++;
+        return (int)n;
+    }
+    int read(uint8_t* data, size_t len) override {
+        if (!open) return -1;
+        size_t n = inLen < len ? inLen : len;
+        memcpy(data, in, n);
+        memmove(in, in + n, inLen - n);
+        inLen -= n;
+        return (int)n;
+    }
+    void close() override { open = false; }
+    void inject(const uint8_t* data, size_t len) { memcpy(in + inLen, data, len); inLen += len; }
+
+    bool open = false;
+    uint8_t out[4096];
+    size_t outLen = 0;
+    uint8_t in[256];
+    size_t inLen = 0;
+    size_t writeLimit = 4096;
+    int writeCalls = 0;
+};
+
+// 建立会话：TCP连接 -> CONNECT -> CONNACK，返回CONNECT报文长度
+static size_t mqttHandshake(AsyncMqttClient& client, FakeMqttTransport& net) {
+    static const uint8_t CONNACK[] = {0x20, 0x02, 0x00, 0x00};
+    client.loop(0);                                      // 发起TCP连接
+    client.loop(1);                                      // 连接完成，发送CONNECT
+    size_t connectLen = net.outLen;
+    net.inject(CONNACK, sizeof(CONNACK));
+    client.loop(2);
+    return connectLen;
+}
+
+void test_mqtt_connect_sets_will_and_announces_online(void) {
+    // 测试CONNECT携带遗嘱，CONNACK后先发布"online"
+    static FakeMqttTransport net;
+    static AsyncMqttClient client(net);
+    client.setServer("127.0.0.1", 1883);
+    client.setCredentials("dev");
+    client.setAvailability("dev/avail");
+    size_t connectLen = mqttHandshake(client, net);
+
+    static const uint8_t CONNECT[] = {
+        0x10, 0x23, 0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, 0x26, 0x00, MQTT_KEEPALIVE_SEC,
+        0x00, 0x03, 'd', 'e', 'v',
+        0x00, 0x09, 'd', 'e', 'v', '/', 'a', 'v', 'a', 'i', 'l',
+        0x00, 0x07, 'o', 'f', 'f', 'l', 'i', 'n', 'e'};
+    TEST_ASSERT_EQUAL_UINT32(sizeof(CONNECT), connectLen);
+    TEST_ASSERT_EQUAL_MEMORY(CONNECT, net.out, sizeof(CONNECT));
+    TEST_ASSERT_TRUE(client.connected());
+
+    static const uint8_t ONLINE[] = {0x31, 0x11, 0x00, 0x09, 'd', 'e', 'v', '/', 'a', 'v', 'a', 'i', 'l',
+                                     'o', 'n', 'l', 'i', 'n', 'e'};
+    TEST_ASSERT_EQUAL_UINT32(sizeof(CONNECT) + sizeof(ONLINE), net.outLen);
+    TEST_ASSERT_EQUAL_MEMORY(ONLINE, net.out + sizeof(CONNECT), sizeof(ONLINE));
+}
+
+void test_mqtt_pipelines_qos1_in_one_write(void) {
+    // 测试多条QoS1消息合并为一次写入，窗口满时等待PUBACK
+    static FakeMqttTransport net;
+    static AsyncMqttClient client(net);
+    client.setServer("127.0.0.1", 1883);
+    client.setCredentials("dev");
+    mqttHandshake(client, net);
+    net.outLen = 0;
+    net.writeCalls = 0;
+
+    for (int i = 0; i < MQTT_MAX_INFLIGHT + 2; i++) {
+        TEST_ASSERT_TRUE(client.publish("t", "1", false, 1));
+    }
+    client.loop(3);
+    TEST_ASSERT_EQUAL(1, net.writeCalls);
+    TEST_ASSERT_EQUAL(MQTT_MAX_INFLIGHT, client.inflightCount());
+    TEST_ASSERT_EQUAL_UINT32(MQTT_MAX_INFLIGHT * 8, net.outLen);  // 每条8字节
+    TEST_ASSERT_EQUAL_UINT8(0x32, net.out[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, net.out[6]);                            // 第一条的报文标识符低字节
+
+    static const uint8_t PUBACK_1[] = {0x40, 0x02, 0x00, 0x01};
+    net.inject(PUBACK_1, sizeof(PUBACK_1));
+    client.loop(4);
+    TEST_ASSERT_EQUAL(2, net.writeCalls);
+    TEST_ASSERT_EQUAL(MQTT_MAX_INFLIGHT, client.inflightCount());
+    TEST_ASSERT_EQUAL_UINT32(MQTT_MAX_INFLIGHT + 1, client.queuedCount());
+    TEST_ASSERT_EQUAL_UINT32(1, client.stats().acked);
+}
+
+void test_mqtt_partial_write_and_redelivery(void) {
+    // 测试部分写入不丢数据，断线后未确认消息带DUP重发
+    static FakeMqttTransport net;
+    static AsyncMqttClient client(net);
+    client.setServer("127.0.0.1", 1883);
+    client.setCredentials("dev");
+    mqttHandshake(client, net);
+    net.outLen = 0;
+
+    client.publish("a", "xyz", false, 0);
+    client.publish("b", "1", true, 1);
+    net.writeLimit = 5;
+    client.loop(3);
+    TEST_ASSERT_EQUAL_UINT32(5, net.outLen);
+    net.writeLimit = 4096;
+    client.loop(4);
+    static const uint8_t EXPECTED[] = {0x30, 0x06, 0x00, 0x01, 'a', 'x', 'y', 'z',
+                                       0x33, 0x06, 0x00, 0x01, 'b', 0x00, 0x01, '1'};
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), net.outLen);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, net.out, sizeof(EXPECTED));
+
+    net.close();                                         // 代理断开
+    client.loop(5);
+    TEST_ASSERT_FALSE(client.connected());
+    TEST_ASSERT_EQUAL_UINT32(1, client.queuedCount());
+    client.loop(5 + MQTT_RECONNECT_INTERVAL_MS);
+    net.outLen = 0;
+    static const uint8_t CONNACK[] = {0x20, 0x02, 0x00, 0x00};
+    client.loop(6 + MQTT_RECONNECT_INTERVAL_MS);
+    size_t connectLen = net.outLen;
+    net.inject(CONNACK, sizeof(CONNACK));
+    client.loop(7 + MQTT_RECONNECT_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_UINT8(0x3B, net.out[connectLen]);  // DUP | QoS1 | 保留
+    TEST_ASSERT_EQUAL_UINT32(1, client.stats().retransmits);
+}
+
+// ==================== 闪存读数日志测试 ====================
+
+// 内存中的NOR闪存模拟：写入只能清零位，按扇区统计擦除次数
+class FakeLogFlash : public LogFlash {
+ public:
+    explicit FakeLogFlash(size_t sectors) : size_(sectors * READING_LOG_SECTOR_SIZE) {
+        memset(data, 0x5C, sizeof(data));                // 模拟分区中的旧数据
+        memset(erases, 0, sizeof(erases));
+    }
+    size_t size() const override { return size_; }
+    bool read(size_t offset, void* out, size_t len) override {
+        memcpy(out, data + offset, len);
+        return true;
+    }
+    bool write(size_t offset, const void* in, size_t len) override {
+        const uint8_t* bytes = (const uint8_t*)in;
+        for (size_t i = 0; i < len; i++) {
+            if ((bytes[i] & ~data[offset + i]) != 0) violations++;  // 试图把0写回1
+            data[offset + i] &= bytes[i];
+        }
+        return true;
+    }
+    bool eraseSector(size_t offset) override {
+        memset(data + offset, 0xFF, READING_LOG_SECTOR_SIZE);
+        erases[offset / READING_LOG_SECTOR_SIZE]++;
+        return true;
+    }
+
+    uint8_t data[4 * READING_LOG_SECTOR_SIZE];
+    uint32_t erases[4];
+    size_t size_;
+    int violations = 0;
+};
+
+void test_reading_log_replays_after_reset(void) {
+    // 测试重启后从第一条未确认的读数继续重放，时间戳和数值保持不变
+    static FakeLogFlash flash(4);
+    {
+        ReadingLog log(flash);
+        TEST_ASSERT_TRUE(log.begin());
+        TEST_ASSERT_EQUAL_UINT32(0, log.pending());
+        for (int i = 0; i < 10; i++) {
+            LoggedReading r;
+            r.utc = 1767196800 + i * 5;
+            r.temperature = 21.25f + i;
+            r.humidity = 45.5f;
+            r.flags = i & 1;
+            TEST_ASSERT_TRUE(log.append(r));
+        }
+        LoggedReading batch[4];
+        TEST_ASSERT_EQUAL_UINT32(4, log.peek(batch, 4));
+        log.consume(4);                                  // 代理确认了前4条
+        TEST_ASSERT_EQUAL_UINT32(6, log.pending());
+    }
+
+    ReadingLog log(flash);                               // 模拟重启
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_EQUAL_UINT32(6, log.pending());
+    LoggedReading batch[8];
+    TEST_ASSERT_EQUAL_UINT32(6, log.peek(batch, 8));
+    TEST_ASSERT_EQUAL_UINT32(1767196820, batch[0].utc);
+    TEST_ASSERT_EQUAL_FLOAT(25.25f, batch[0].temperature);
+    TEST_ASSERT_EQUAL_FLOAT(45.5f, batch[0].humidity);
+    TEST_ASSERT_EQUAL_UINT8(0, batch[0].flags);
+    TEST_ASSERT_EQUAL_UINT8(1, batch[1].flags);
+
+    // 追加继续写在原来的位置之后
+    LoggedReading r;
+    r.utc = 1767196900;
+    TEST_ASSERT_TRUE(log.append(r));
+    log.consume(6);
+    TEST_ASSERT_EQUAL_UINT32(1, log.peek(batch, 8));
+    TEST_ASSERT_EQUAL_UINT32(1767196900, batch[0].utc);
+    TEST_ASSERT_EQUAL(0, flash.violations);
+}
+
+void test_reading_log_wraps_evenly_and_skips_torn_records(void) {
+    // 测试写满一圈后覆盖最旧扇区、各扇区擦除次数相同，半条记录被跳过
+    static FakeLogFlash flash(4);
+    ReadingLog log(flash);
+    TEST_ASSERT_TRUE(log.begin());
+    uint32_t total = log.capacity() * 3;
+    for (uint32_t i = 0; i < total; i++) {
+        LoggedReading r;
+        r.utc = i + 1;
+        log.append(r);
+        if (log.pending() > 100) log.consume(50);        // 间歇性地恢复连接
+    }
+    TEST_ASSERT_EQUAL_UINT32(total, log.stats().appended);
+    TEST_ASSERT_EQUAL(0, flash.violations);
+    for (int s = 1; s < 4; s++) {
+        TEST_ASSERT_TRUE(flash.erases[s] + 1 >= flash.erases[0] && flash.erases[s] <= flash.erases[0]);
+    }
+
+    // 断电：最后一条记录只写了一半
+    LoggedReading r;
+    r.utc = 0xABCDEF;
+    log.append(r);
+    uint32_t pendingBefore = log.pending();
+    LoggedReading batch[128];
+    size_t n = log.peek(batch, 128);
+    TEST_ASSERT_EQUAL_UINT32(0xABCDEF, batch[n - 1].utc);
+    size_t torn = 0;
+    for (size_t off = 0; off < flash.size(); off++) {    // 找到最后一条记录的CRC字节并破坏
+        if (flash.data[off] == 0xEF && flash.data[off + 1] == 0xCD && flash.data[off + 2] == 0xAB) torn = off;
+    }
+    flash.data[torn + 9] &= 0x0F;
+
+    ReadingLog remounted(flash);
+    TEST_ASSERT_TRUE(remounted.begin());
+    TEST_ASSERT_EQUAL_UINT32(pendingBefore - 1, remounted.pending());
+    LoggedReading next;
+    next.utc = 0x123456;
+    TEST_ASSERT_TRUE(remounted.append(next));            // 不复用被破坏的槽位
+    n = remounted.peek(batch, 128);
+    TEST_ASSERT_EQUAL_UINT32(0x123456, batch[n - 1].utc);
+    TEST_ASSERT_EQUAL_UINT32(total, batch[n - 2].utc);
+}
+
+void test_reading_log_ack_after_wrap(void) {
+    // 测试重放批次等待确认期间日志写满一圈：只确认这批中仍在日志里的记录，不误标之后的读数
+    static FakeLogFlash flash(4);
+    ReadingLog log(flash);
+    TEST_ASSERT_TRUE(log.begin());
+    LoggedReading r;
+    uint32_t utc = 0;
+    for (int i = 0; i < 330; i++) {
+        r.utc = ++utc;
+        log.append(r);
+    }
+    log.consume(330);
+    for (int i = 0; i < 20; i++) {                       // 331~340在第一个扇区末尾，341~350在第二个扇区
+        r.utc = ++utc;
+        log.append(r);
+    }
+
+    LoggedReading batch[16];
+    ReadingLogRange range;
+    TEST_ASSERT_EQUAL_UINT32(16, log.peek(batch, 16, &range));
+    TEST_ASSERT_EQUAL_UINT32(331, batch[0].utc);
+
+    // 等待PUBACK期间断线，离线读数写满一圈，擦除了批次开头所在的扇区
+    while (log.stats().overwritten == 0) {
+        r.utc = ++utc;
+        log.append(r);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, log.stats().overwritten);
+    uint32_t pending = log.pending();
+    log.consume(range);                                  // 迟到的PUBACK
+    TEST_ASSERT_EQUAL_UINT32(pending - 6, log.pending());  // 只有341~346还在日志里
+    LoggedReading next;
+    TEST_ASSERT_EQUAL_UINT32(1, log.peek(&next, 1));
+    TEST_ASSERT_EQUAL_UINT32(347, next.utc);
+    TEST_ASSERT_EQUAL(0, flash.violations);
+}
+
+void test_boot_profile_overlapping_phases(void) {
+    // 测试阶段可以重叠、只记录第一次结束，未结束的阶段输出null
+    BootProfile profile;
+    int wifi = profile.begin("wifi", 3);
+    int display = profile.begin("display", 4);
+    profile.end(display, 130);
+    profile.end(wifi, 815);
+    profile.end(wifi, 900);                              // 重复结束被忽略
+    int ntp = profile.begin("ntp", 5);
+    profile.end(-1, 10);                                 // 无效编号被忽略
+    TEST_ASSERT_TRUE(profile.finished(wifi));
+    TEST_ASSERT_FALSE(profile.finished(ntp));
+
+    char buf[128];
+    size_t len = profile.toJson(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"wifi\":{\"start\":3,\"ms\":812},\"display\":{\"start\":4,\"ms\":126},"
+                             "\"ntp\":{\"start\":5,\"ms\":null}}", buf);
+    TEST_ASSERT_EQUAL(strlen(buf), len);
+    TEST_ASSERT_EQUAL(0, profile.toJson(buf, 20));       // 缓冲区不足
+
+    for (int i = 3; i < BOOT_PROFILE_MAX_PHASES; i++) profile.begin("x", 0);
+    TEST_ASSERT_EQUAL(-1, profile.begin("full", 0));
+}
+
+void test_warm_cache_survives_warm_reset(void) {
+    // 测试热重启后恢复读数、时间和网络状态，时间接到新的运行时间上
+    static WarmCacheData rtc;
+    memset(&rtc, 0xA5, sizeof(rtc));                     // 上电后的随机内容
+    {
+        WarmCache cache(rtc);
+        TEST_ASSERT_FALSE(cache.begin(false, 0));
+        int64_t utc;
+        TEST_ASSERT_FALSE(cache.utcUs(1000000, utc));
+        cache.saveReading(24.5f, 51.0f);
+        cache.saveTime(1767196800000000LL, 3000000);      // 启动3秒后NTP同步
+        const uint8_t bssid[6] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+        cache.saveWiFi(bssid, 6);
+        cache.setFlag(WARM_CACHE_MQTT_DISCOVERED, true);
+        cache.touch(63000000);                            // 运行到63秒时看门狗复位
+    }
+
+    WarmCache cache(rtc);
+    TEST_ASSERT_TRUE(cache.begin(false, 200000));         // 复位后200毫秒
+    TEST_ASSERT_TRUE(cache.restored());
+    TEST_ASSERT_EQUAL_UINT32(1, cache.warmBoots());
+    TEST_ASSERT_TRUE(cache.has(WARM_CACHE_READING));
+    TEST_ASSERT_EQUAL_FLOAT(24.5f, cache.temperature());
+    TEST_ASSERT_EQUAL_FLOAT(51.0f, cache.humidity());
+    int64_t utc = 0;
+    TEST_ASSERT_TRUE(cache.utcUs(200000, utc));
+    TEST_ASSERT_TRUE(utc == 1767196800000000LL + 60200000LL);  // 复位时刻 + 0.2秒（复位本身的耗时不计）
+    TEST_ASSERT_TRUE(cache.utcUs(1200000, utc));
+    TEST_ASSERT_TRUE(utc == 1767196800000000LL + 61200000LL);
+    TEST_ASSERT_TRUE(cache.has(WARM_CACHE_WIFI));
+    TEST_ASSERT_EQUAL_UINT8(6, cache.channel());
+    TEST_ASSERT_EQUAL_UINT8(0x60, cache.bssid()[5]);
+    TEST_ASSERT_TRUE(cache.has(WARM_CACHE_MQTT_DISCOVERED));
+
+    // NTP恢复前再次复位：时间继续累加
+    cache.touch(5200000);
+    WarmCache again(rtc);
+    TEST_ASSERT_TRUE(again.begin(false, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, again.warmBoots());
+    TEST_ASSERT_TRUE(again.utcUs(0, utc));
+    TEST_ASSERT_TRUE(utc == 1767196800000000LL + 65200000LL);
+}
+
+void test_warm_cache_rejects_cold_and_corrupt(void) {
+    // 测试上电复位、CRC错误（更新中途复位）时丢弃缓存
+    static WarmCacheData rtc;
+    WarmCache cache(rtc);
+    cache.begin(true, 0);
+    cache.saveReading(20.0f, 40.0f);
+    cache.touch(1000000);
+
+    WarmCache cold(rtc);
+    TEST_ASSERT_FALSE(cold.begin(true, 0));               // 上电复位
+    TEST_ASSERT_FALSE(cold.has(WARM_CACHE_READING));
+    TEST_ASSERT_EQUAL_UINT32(0, cold.warmBoots());
+
+    cold.saveReading(21.0f, 41.0f);
+    rtc.humidity = 99.0f;                                 // 只写了一半就复位，CRC没有更新
+    WarmCache torn(rtc);
+    TEST_ASSERT_FALSE(torn.begin(false, 0));
+    TEST_ASSERT_FALSE(torn.has(WARM_CACHE_READING));
+
+    torn.saveReading(22.0f, 42.0f);
+    rtc.magic ^= 0x01000000;                              // 布局版本变化
+    WarmCache versioned(rtc);
+    TEST_ASSERT_FALSE(versioned.begin(false, 0));
+}
+
 // ==================== 主函数 ====================
 
 int main() {
@@ -260,6 +882,35 @@ int main() {
     
     RUN_TEST(test_memory_threshold_warning);
     RUN_TEST(test_memory_normal);
+
+    RUN_TEST(test_float_format_matches_snprintf);
+    RUN_TEST(test_float_format_rounding_edges);
+
+    RUN_TEST(test_clock_text_patches_seconds_only);
+    RUN_TEST(test_clock_text_increment_rollover);
+
+    RUN_TEST(test_soft_clock_corrects_drift);
+    RUN_TEST(test_soft_clock_local_time_rollover);
+    RUN_TEST(test_soft_clock_seed_is_not_a_sync);
+
+    RUN_TEST(test_snapshot_layout);
+    RUN_TEST(test_snapshot_reencodes_only_on_change);
+
+    RUN_TEST(test_metrics_slot_update);
+    RUN_TEST(test_metrics_200_entities);
+
+    RUN_TEST(test_mqtt_connect_sets_will_and_announces_online);
+    RUN_TEST(test_mqtt_pipelines_qos1_in_one_write);
+    RUN_TEST(test_mqtt_partial_write_and_redelivery);
+
+    RUN_TEST(test_reading_log_replays_after_reset);
+    RUN_TEST(test_reading_log_wraps_evenly_and_skips_torn_records);
+    RUN_TEST(test_reading_log_ack_after_wrap);
+
+    RUN_TEST(test_boot_profile_overlapping_phases);
+
+    RUN_TEST(test_warm_cache_survives_warm_reset);
+    RUN_TEST(test_warm_cache_rejects_cold_and_corrupt);
     
     // 返回测试结果
     return UNITY_END();